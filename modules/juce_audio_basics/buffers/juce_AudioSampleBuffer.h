@@ -655,14 +655,8 @@ public:
                 jassert (isPositiveAndBelow (channel, numChannels));
                 jassert (startSample >= 0 && numSamples >= 0 && startSample + numSamples <= size);
 
-                const auto increment = (endGain - startGain) / (float) numSamples;
-                auto* d = channels[channel] + startSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ *= startGain;
-                    startGain += increment;
-                }
+                FloatVectorOperations::multiplyWithRamp (channels[channel] + startSample, startGain,
+                                                         (endGain - startGain) / (Type) numSamples, numSamples);
             }
         }
     }
@@ -810,14 +804,8 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ += startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::addWithRamp (channels[destChannel] + destStartSample, source, startGain,
+                                                    (endGain - startGain) / (Type) numSamples, numSamples);
             }
         }
     }
@@ -966,14 +954,8 @@ public:
             if (numSamples > 0)
             {
                 isClear = false;
-                const auto increment = (endGain - startGain) / numSamples;
-                auto* d = channels[destChannel] + destStartSample;
-
-                while (--numSamples >= 0)
-                {
-                    *d++ = startGain * *source++;
-                    startGain += increment;
-                }
+                FloatVectorOperations::copyWithRamp (channels[destChannel] + destStartSample, source, startGain,
+                                                     (endGain - startGain) / (Type) numSamples, numSamples);
             }
         }
     }
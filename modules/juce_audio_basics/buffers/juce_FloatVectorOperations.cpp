@@ -25,9 +25,9 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
     inline static bool isAligned (const void* p) noexcept
@@ -51,6 +51,7 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm_loadu_ps (v); }
         static forcedinline void storeA (Type* dest, ParallelType a) noexcept           { _mm_store_ps (dest, a); }
         static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm_storeu_ps (dest, a); }
+        static forcedinline ParallelType loadIntU (const int* v) noexcept               { return _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*) v)); }
 
         static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm_add_ps (a, b); }
         static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm_sub_ps (a, b); }
@@ -58,6 +59,9 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm_max_ps (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm_min_ps (a, b); }
 
+        static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return add (a, mul (b, c)); }
+        static forcedinline ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return sub (a, mul (b, c)); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm_and_ps (a, b); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm_andnot_ps (a, b); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_ps (a, b); }
@@ -90,6 +94,9 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm_max_pd (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm_min_pd (a, b); }
 
+        static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return add (a, mul (b, c)); }
+        static forcedinline ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return sub (a, mul (b, c)); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm_and_pd (a, b); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm_andnot_pd (a, b); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm_or_pd (a, b); }
@@ -99,7 +106,314 @@ namespace FloatVectorHelpers
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
     };
 
+   #if JUCE_USE_AVX_INTRINSICS
+    // MSVC lets any intrinsic be used without enabling its instruction set for the
+    // whole file, so the AVX lambdas need no target attribute there: only their
+    // intrinsics use AVX, and they're only called once the CPU and OS support it.
+    #if JUCE_MSVC
+     #define JUCE_AVX_TARGET
+     #define JUCE_FMA_TARGET
+     #define JUCE_AVX512_TARGET
+    #else
+     #define JUCE_AVX_TARGET     __attribute__ ((target ("avx")))
+     #define JUCE_FMA_TARGET     __attribute__ ((target ("avx2,fma")))
+     #define JUCE_AVX512_TARGET  __attribute__ ((target ("avx512f")))
+    #endif
+
+    // The AVX operations are only called from functions compiled for the AVX target,
+    // after checking that the CPU supports it. There's no penalty for unaligned loads
+    // and stores on aligned data with AVX, so they are used everywhere.
+    struct AVXOps32
+    {
+        using Type = float;
+        using ParallelType = __m256;
+        using IntegerType  = __m256;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX_TARGET IntegerType toint (ParallelType v) noexcept                 { return v; }
+        static forcedinline JUCE_AVX_TARGET ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_broadcast_ss (&v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadA (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_TARGET void storeA (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadIntU (const int* v) noexcept               { return _mm256_cvtepi32_ps (_mm256_loadu_si256 ((const __m256i*) v)); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return add (a, mul (b, c)); }
+        static forcedinline JUCE_AVX_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return sub (a, mul (b, c)); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_ps (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMinimum (v, (int) numParallel); }
+    };
+
+    struct AVXOps64
+    {
+        using Type = double;
+        using ParallelType = __m256d;
+        using IntegerType  = __m256d;
+        enum { numParallel = 4 };
+
+        static forcedinline JUCE_AVX_TARGET IntegerType toint (ParallelType v) noexcept                 { return v; }
+        static forcedinline JUCE_AVX_TARGET ParallelType toflt (IntegerType v) noexcept                 { return v; }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_broadcast_sd (&v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadA (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_TARGET void storeA (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return add (a, mul (b, c)); }
+        static forcedinline JUCE_AVX_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return sub (a, mul (b, c)); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return _mm256_andnot_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return _mm256_or_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return _mm256_xor_pd (a, b); }
 
+        static forcedinline JUCE_AVX_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+        static forcedinline JUCE_AVX_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+    };
+
+    // The same as the AVX operations, with fused multiply-adds
+    struct FMAOps32  : public AVXOps32
+    {
+        static forcedinline JUCE_FMA_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_ps (b, c, a); }
+        static forcedinline JUCE_FMA_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_ps (b, c, a); }
+    };
+
+    struct FMAOps64  : public AVXOps64
+    {
+        static forcedinline JUCE_FMA_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_pd (b, c, a); }
+        static forcedinline JUCE_FMA_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fnmadd_pd (b, c, a); }
+    };
+
+    // AVX-512 Foundation has no floating point logical instructions, so the integer ones are used
+    struct AVX512Ops32
+    {
+        using Type = float;
+        using ParallelType = __m512;
+        using IntegerType  = __m512i;
+        enum { numParallel = 16 };
+
+        static forcedinline JUCE_AVX512_TARGET IntegerType toint (ParallelType v) noexcept                 { return _mm512_castps_si512 (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_ps (v); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadA (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+        static forcedinline JUCE_AVX512_TARGET void storeA (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadIntU (const int* v) noexcept               { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_ps (b, c, a); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_ps (b, c, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMinimum (v, (int) numParallel); }
+    };
+
+    struct AVX512Ops64
+    {
+        using Type = double;
+        using ParallelType = __m512d;
+        using IntegerType  = __m512i;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX512_TARGET IntegerType toint (ParallelType v) noexcept                 { return _mm512_castpd_si512 (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType toflt (IntegerType v) noexcept                 { return _mm512_castsi512_pd (v); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadA (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+        static forcedinline JUCE_AVX512_TARGET void storeA (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+        static forcedinline JUCE_AVX512_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_pd (b, c, a); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fnmadd_pd (b, c, a); }
+
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_and_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_not (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_andnot_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_or_si512 (toint (a), toint (b))); }
+        static forcedinline JUCE_AVX512_TARGET ParallelType bit_xor (ParallelType a, ParallelType b) noexcept  { return toflt (_mm512_xor_si512 (toint (a), toint (b))); }
+
+        static forcedinline JUCE_AVX512_TARGET Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMaximum (v, (int) numParallel); }
+        static forcedinline JUCE_AVX512_TARGET Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return juce::findMinimum (v, (int) numParallel); }
+    };
+
+    template<int typeSize> struct AVXModeType       { using Mode = AVXOps32; };
+    template<>             struct AVXModeType<8>    { using Mode = AVXOps64; };
+    template<int typeSize> struct FMAModeType       { using Mode = FMAOps32; };
+    template<>             struct FMAModeType<8>    { using Mode = FMAOps64; };
+    template<int typeSize> struct AVX512ModeType    { using Mode = AVX512Ops32; };
+    template<>             struct AVX512ModeType<8> { using Mode = AVX512Ops64; };
+
+    enum class AVXLevel
+    {
+        none,
+        avx,
+        fma,      // AVX2 and FMA3
+        avx512
+    };
+
+    // SystemStats only reports these instruction sets if the OS also saves the
+    // state of the YMM registers, and of the opmask and ZMM ones for AVX-512
+    static AVXLevel getSupportedAVXLevel() noexcept
+    {
+        if (SystemStats::hasAVX512F())                          return AVXLevel::avx512;
+        if (SystemStats::hasAVX2() && SystemStats::hasFMA3())   return AVXLevel::fma;
+        if (SystemStats::hasAVX())                              return AVXLevel::avx;
+
+        return AVXLevel::none;
+    }
+
+    // This is only lowered by the unit tests, to check all the code paths supported by the CPU
+    static std::atomic<AVXLevel>& getCurrentAVXLevel() noexcept
+    {
+        static std::atomic<AVXLevel> level { getSupportedAVXLevel() };
+        return level;
+    }
+
+    static AVXLevel getAVXLevel() noexcept
+    {
+        return getCurrentAVXLevel().load (std::memory_order_relaxed);
+    }
+
+    // The AVX loops are run in lambdas compiled for their instruction set. The pointers
+    // are passed to them by value rather than captured, so that they can stay in registers,
+    // and their parameters deliberately shadow the ones of the enclosing function.
+   #if JUCE_MSVC
+    #define JUCE_BEGIN_AVX_SHADOWING   __pragma (warning (push)) __pragma (warning (disable: 4457))
+    #define JUCE_END_AVX_SHADOWING     __pragma (warning (pop))
+   #elif JUCE_CLANG
+    #define JUCE_BEGIN_AVX_SHADOWING   _Pragma ("clang diagnostic push") _Pragma ("clang diagnostic ignored \"-Wshadow\"")
+    #define JUCE_END_AVX_SHADOWING     _Pragma ("clang diagnostic pop")
+   #else
+    // (some versions of GCC also give false warnings about the undefined values used by the AVX-512 intrinsics)
+    #define JUCE_BEGIN_AVX_SHADOWING   _Pragma ("GCC diagnostic push") _Pragma ("GCC diagnostic ignored \"-Wshadow\"") \
+                                       _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+    #define JUCE_END_AVX_SHADOWING     _Pragma ("GCC diagnostic pop")
+   #endif
+
+    #define JUCE_BEGIN_AVX_VEC_OP_LAMBDA(level, params, pointer) \
+        [&] params JUCE_##level##_TARGET \
+        { \
+            using Mode = typename FloatVectorHelpers::level##ModeType<sizeof (*pointer)>::Mode; \
+            const int numLongOps = num / Mode::numParallel;
+
+    #define JUCE_END_AVX_VEC_OP_LAMBDA \
+            return numLongOps * Mode::numParallel; \
+        }
+
+    #define JUCE_BEGIN_AVX_VEC_OP \
+        int numDone = 0; \
+        JUCE_BEGIN_AVX_SHADOWING \
+        switch (FloatVectorHelpers::getAVXLevel()) \
+        {
+
+    #define JUCE_AVX_VEC_OP_CASE(levelName, level, params, pointer) \
+            case FloatVectorHelpers::AVXLevel::levelName:  numDone = JUCE_BEGIN_AVX_VEC_OP_LAMBDA (level, params, pointer)
+
+    #define JUCE_END_AVX_VEC_OP_CASE(args) \
+            JUCE_END_AVX_VEC_OP_LAMBDA args; break;
+
+    #define JUCE_END_AVX_VEC_OP \
+            case FloatVectorHelpers::AVXLevel::none: \
+            default: break; \
+        } \
+        JUCE_END_AVX_SHADOWING
+
+    // These process as many samples as possible with the widest registers supported by
+    // the CPU, leaving the remaining ones to the SSE code that follows
+    #define JUCE_PERFORM_AVX_VEC_OP_DEST(vecLoop, setupOp) \
+        if (num * (int) sizeof (*dest) >= 32) \
+        { \
+            JUCE_BEGIN_AVX_VEC_OP \
+            JUCE_AVX_VEC_OP_CASE (avx512, AVX512, (decltype (dest) dest), dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((dest)) \
+            JUCE_AVX_VEC_OP_CASE (fma,    FMA,    (decltype (dest) dest), dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((dest)) \
+            JUCE_AVX_VEC_OP_CASE (avx,    AVX,    (decltype (dest) dest), dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((dest)) \
+            JUCE_END_AVX_VEC_OP \
+            dest += numDone; num -= numDone; \
+        }
+
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC(vecLoop, setupOp) \
+        if (num * (int) sizeof (*src) >= 32) \
+        { \
+            JUCE_BEGIN_AVX_VEC_OP \
+            JUCE_AVX_VEC_OP_CASE (avx512, AVX512, (decltype (src) src), src) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((src)) \
+            JUCE_AVX_VEC_OP_CASE (fma,    FMA,    (decltype (src) src), src) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((src)) \
+            JUCE_AVX_VEC_OP_CASE (avx,    AVX,    (decltype (src) src), src) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE ((src)) \
+            JUCE_END_AVX_VEC_OP \
+            src += numDone; num -= numDone; \
+        }
+
+    #define JUCE_AVX_SRC_DEST_PARAMS    (decltype (dest) dest, decltype (src) src)
+    #define JUCE_AVX_SRC_DEST_ARGS      (dest, src)
+
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC_DEST(vecLoop, setupOp) \
+        if (num * (int) sizeof (*dest) >= 32) \
+        { \
+            JUCE_BEGIN_AVX_VEC_OP \
+            JUCE_AVX_VEC_OP_CASE (avx512, AVX512, JUCE_AVX_SRC_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC_DEST_ARGS) \
+            JUCE_AVX_VEC_OP_CASE (fma,    FMA,    JUCE_AVX_SRC_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC_DEST_ARGS) \
+            JUCE_AVX_VEC_OP_CASE (avx,    AVX,    JUCE_AVX_SRC_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC_DEST_ARGS) \
+            JUCE_END_AVX_VEC_OP \
+            dest += numDone; src += numDone; num -= numDone; \
+        }
+
+    #define JUCE_AVX_SRC1_SRC2_DEST_PARAMS  (decltype (dest) dest, decltype (src1) src1, decltype (src2) src2)
+    #define JUCE_AVX_SRC1_SRC2_DEST_ARGS    (dest, src1, src2)
+
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC1_SRC2_DEST(vecLoop, setupOp) \
+        if (num * (int) sizeof (*dest) >= 32) \
+        { \
+            JUCE_BEGIN_AVX_VEC_OP \
+            JUCE_AVX_VEC_OP_CASE (avx512, AVX512, JUCE_AVX_SRC1_SRC2_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC1_SRC2_DEST_ARGS) \
+            JUCE_AVX_VEC_OP_CASE (fma,    FMA,    JUCE_AVX_SRC1_SRC2_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC1_SRC2_DEST_ARGS) \
+            JUCE_AVX_VEC_OP_CASE (avx,    AVX,    JUCE_AVX_SRC1_SRC2_DEST_PARAMS, dest) setupOp vecLoop JUCE_END_AVX_VEC_OP_CASE (JUCE_AVX_SRC1_SRC2_DEST_ARGS) \
+            JUCE_END_AVX_VEC_OP \
+            dest += numDone; src1 += numDone; src2 += numDone; num -= numDone; \
+        }
+   #else
+    #define JUCE_PERFORM_AVX_VEC_OP_DEST(vecLoop, setupOp)
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC(vecLoop, setupOp)
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC_DEST(vecLoop, setupOp)
+    #define JUCE_PERFORM_AVX_VEC_OP_SRC1_SRC2_DEST(vecLoop, setupOp)
+   #endif
 
     #define JUCE_BEGIN_VEC_OP \
         using Mode = FloatVectorHelpers::ModeType<sizeof(*dest)>::Mode; \
@@ -113,6 +427,7 @@ namespace FloatVectorHelpers
         for (int i = 0; i < num; ++i) normalOp;
 
     #define JUCE_PERFORM_VEC_OP_DEST(normalOp, vecOp, locals, setupOp) \
+        JUCE_PERFORM_AVX_VEC_OP_DEST (JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST), setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
         if (FloatVectorHelpers::isAligned (dest))   JUCE_VEC_LOOP (vecOp, dummy, Mode::loadA, Mode::storeA, locals, JUCE_INCREMENT_DEST) \
@@ -120,6 +435,7 @@ namespace FloatVectorHelpers
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_PERFORM_AVX_VEC_OP_SRC_DEST (JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment), setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
         if (FloatVectorHelpers::isAligned (dest)) \
@@ -135,6 +451,7 @@ namespace FloatVectorHelpers
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_PERFORM_AVX_VEC_OP_SRC1_SRC2_DEST (JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment), setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
         if (FloatVectorHelpers::isAligned (dest)) \
@@ -166,6 +483,7 @@ namespace FloatVectorHelpers
         JUCE_FINISH_VEC_OP (normalOp)
 
     #define JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_PERFORM_AVX_VEC_OP_SRC1_SRC2_DEST (JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment), setupOp) \
         JUCE_BEGIN_VEC_OP \
         setupOp \
         if (FloatVectorHelpers::isAligned (dest)) \
@@ -223,6 +541,9 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return vmaxq_f32 (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return vminq_f32 (a, b); }
 
+        static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return vmlaq_f32 (a, b, c); }
+        static forcedinline ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return vmlsq_f32 (a, b, c); }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  {  return toflt (vandq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  {  return toflt (vbicq_u32 (toint (a), toint (b))); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (vorrq_u32 (toint (a), toint (b))); }
@@ -255,6 +576,9 @@ namespace FloatVectorHelpers
         static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return jmax (a, b); }
         static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return jmin (a, b); }
 
+        static forcedinline ParallelType multiplyAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return a + b * c; }
+        static forcedinline ParallelType multiplySub (ParallelType a, ParallelType b, ParallelType c) noexcept  { return a - b * c; }
+
         static forcedinline ParallelType bit_and (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) & toint (b)); }
         static forcedinline ParallelType bit_not (ParallelType a, ParallelType b) noexcept  {  return toflt ((~toint (a)) & toint (b)); }
         static forcedinline ParallelType bit_or  (ParallelType a, ParallelType b) noexcept  {  return toflt (toint (a) | toint (b)); }
@@ -349,6 +673,72 @@ namespace FloatVectorHelpers
     #define JUCE_LOAD_SRC1_SRC2_DEST(src1Load, src2Load, dstLoad)   const Mode::ParallelType d = dstLoad (dest), s1 = src1Load (src1), s2 = src2Load (src2);
     #define JUCE_LOAD_SRC_DEST(srcLoad, dstLoad)                    const Mode::ParallelType d = dstLoad (dest), s = srcLoad (src);
 
+    //==============================================================================
+    // The gains of the ramps are worked out from the index of each value relative to destStart,
+    // so that the AVX, SSE and scalar loops can each carry on from where the previous one stopped
+    #define JUCE_SETUP_RAMP_INDEX \
+        Mode::Type firstIndices[Mode::numParallel]; \
+        for (int lane = 0; lane < Mode::numParallel; ++lane) \
+            firstIndices[lane] = (Mode::Type) (dest - destStart + lane); \
+        Mode::ParallelType index = Mode::loadU (firstIndices); \
+        const Mode::ParallelType indexIncrement = Mode::load1 ((Mode::Type) Mode::numParallel);
+
+    #define JUCE_SETUP_LINEAR_RAMP \
+        JUCE_SETUP_RAMP_INDEX \
+        const Mode::ParallelType rampStart = Mode::load1 (startGain); \
+        const Mode::ParallelType rampIncrement = Mode::load1 (gainIncrement);
+
+    #define JUCE_SETUP_EXPONENTIAL_RAMP \
+        Mode::Type firstGains[Mode::numParallel]; \
+        firstGains[0] = FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest - destStart)); \
+        for (int lane = 1; lane < Mode::numParallel; ++lane) \
+            firstGains[lane] = firstGains[lane - 1] * gainMultiplier; \
+        Mode::ParallelType nextGain = Mode::loadU (firstGains); \
+        const Mode::ParallelType multiplierPerOp = Mode::load1 (FloatVectorHelpers::getExponentialRampGain ((Mode::Type) 1, gainMultiplier, Mode::numParallel));
+
+    #define JUCE_NEXT_LINEAR_RAMP_GAIN \
+        const Mode::ParallelType gain = Mode::multiplyAdd (rampStart, rampIncrement, index); \
+        index = Mode::add (index, indexIncrement);
+
+    #define JUCE_NEXT_EXPONENTIAL_RAMP_GAIN \
+        const Mode::ParallelType gain = nextGain; \
+        nextGain = Mode::mul (nextGain, multiplierPerOp);
+
+    #define JUCE_LOAD_DEST_WITH_LINEAR_RAMP(srcLoad, dstLoad)            JUCE_LOAD_DEST (srcLoad, dstLoad) JUCE_NEXT_LINEAR_RAMP_GAIN
+    #define JUCE_LOAD_SRC_WITH_LINEAR_RAMP(srcLoad, dstLoad)             JUCE_LOAD_SRC (srcLoad, dstLoad) JUCE_NEXT_LINEAR_RAMP_GAIN
+    #define JUCE_LOAD_SRC_DEST_WITH_LINEAR_RAMP(srcLoad, dstLoad)        JUCE_LOAD_SRC_DEST (srcLoad, dstLoad) JUCE_NEXT_LINEAR_RAMP_GAIN
+    #define JUCE_LOAD_DEST_WITH_EXPONENTIAL_RAMP(srcLoad, dstLoad)       JUCE_LOAD_DEST (srcLoad, dstLoad) JUCE_NEXT_EXPONENTIAL_RAMP_GAIN
+    #define JUCE_LOAD_SRC_WITH_EXPONENTIAL_RAMP(srcLoad, dstLoad)        JUCE_LOAD_SRC (srcLoad, dstLoad) JUCE_NEXT_EXPONENTIAL_RAMP_GAIN
+    #define JUCE_LOAD_SRC_DEST_WITH_EXPONENTIAL_RAMP(srcLoad, dstLoad)   JUCE_LOAD_SRC_DEST (srcLoad, dstLoad) JUCE_NEXT_EXPONENTIAL_RAMP_GAIN
+
+    #define JUCE_LOAD_DEST_AND_MIX_SOURCES_WITH_RAMPS(srcLoad, dstLoad) \
+        Mode::ParallelType mix = dstLoad (dest); \
+        \
+        for (int source = 0; source < numSources; ++source) \
+        { \
+            const Mode::ParallelType gain = Mode::multiplyAdd (Mode::load1 (startGains[source]), Mode::load1 (gainIncrements[source]), index); \
+            mix = Mode::multiplyAdd (mix, Mode::loadU (sources[source] + (dest - destStart)), gain); \
+        } \
+        \
+        index = Mode::add (index, indexIncrement);
+
+    // Squaring doubles the relative error of the multiplier, so this is done in double precision
+    template <typename Type>
+    static Type getExponentialRampGain (Type startGain, Type gainMultiplier, int index) noexcept
+    {
+        double gain = startGain, multiplier = gainMultiplier;
+
+        for (; index > 0; index >>= 1)
+        {
+            if ((index & 1) != 0)
+                gain *= multiplier;
+
+            multiplier *= multiplier;
+        }
+
+        return (Type) gain;
+    }
+
     union signMask32 { float  f; uint32 i; };
     union signMask64 { double d; uint64 i; };
 
@@ -356,6 +746,35 @@ namespace FloatVectorHelpers
     template<int typeSize> struct ModeType    { using Mode = BasicOps32; };
     template<>             struct ModeType<8> { using Mode = BasicOps64; };
 
+   #if JUCE_USE_AVX_INTRINSICS
+    #define JUCE_AVX_MIN_MAX_LOOP \
+        if (numLongOps > 0) \
+        { \
+            auto mn = Mode::loadU (src); \
+            auto mx = mn; \
+        \
+            for (int i = 1; i < numLongOps; ++i) \
+            { \
+                src += Mode::numParallel; \
+                auto v = Mode::loadU (src); \
+                mn = Mode::min (mn, v); \
+                mx = Mode::max (mx, v); \
+            } \
+        \
+            avxResult = Range<Type> (Mode::min (mn), Mode::max (mx)); \
+        }
+
+    // Finds the range of as many values as possible with the AVX registers, and
+    // returns the number of values that were processed, which may be zero.
+    template <typename Type>
+    static int findMinAndMaxAVX (const Type* src, int num, Range<Type>& avxResult) noexcept
+    {
+        const int numValues = num;
+        JUCE_PERFORM_AVX_VEC_OP_SRC (JUCE_AVX_MIN_MAX_LOOP, )
+        return numValues - num;
+    }
+   #endif
+
     template <typename Mode>
     struct MinMax
     {
@@ -433,6 +852,20 @@ namespace FloatVectorHelpers
         }
 
         static Range<Type> findMinAndMax (const Type* src, int num) noexcept
+        {
+           #if JUCE_USE_AVX_INTRINSICS
+            Range<Type> avxResult;
+            const int numDone = findMinAndMaxAVX (src, num, avxResult);
+
+            if (numDone > 0)
+                return numDone < num ? avxResult.getUnionWith (findMinAndMaxWithoutAVX (src + numDone, num - numDone))
+                                     : avxResult;
+           #endif
+
+            return findMinAndMaxWithoutAVX (src, num);
+        }
+
+        static Range<Type> findMinAndMaxWithoutAVX (const Type* src, int num) noexcept
         {
             int numLongOps = num / Mode::numParallel;
 
@@ -684,7 +1117,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::multiplyAdd (d, mult, s),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -695,7 +1128,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::multiplyAdd (d, mult, s),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -706,7 +1139,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
+    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::multiplyAdd (d, s1, s2),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
@@ -717,7 +1150,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
+    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::multiplyAdd (d, s1, s2),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
@@ -725,28 +1158,28 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::multiplySub (d, mult, s),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::multiplySub (d, mult, s),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
+    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::multiplySub (d, s1, s2),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
-    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
+    JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::multiplySub (d, s1, s2),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
 }
@@ -821,6 +1254,146 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::multiplyWithRamp (float* dest, float startGain, float gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmul (dest, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= startGain + gainIncrement * (float) (dest + i - destStart), Mode::mul (d, gain),
+                              JUCE_LOAD_DEST_WITH_LINEAR_RAMP, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (float* dest, const float* src, float startGain, float gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmul (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * (startGain + gainIncrement * (float) (dest + i - destStart)), Mode::mul (s, gain),
+                                  JUCE_LOAD_SRC_WITH_LINEAR_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (float* dest, const float* src, float startGain, float gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladd (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * (startGain + gainIncrement * (float) (dest + i - destStart)), Mode::multiplyAdd (d, s, gain),
+                                  JUCE_LOAD_SRC_DEST_WITH_LINEAR_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyWithRamp (double* dest, double startGain, double gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmulD (dest, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= startGain + gainIncrement * (double) (dest + i - destStart), Mode::mul (d, gain),
+                              JUCE_LOAD_DEST_WITH_LINEAR_RAMP, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (double* dest, const double* src, double startGain, double gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmulD (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * (startGain + gainIncrement * (double) (dest + i - destStart)), Mode::mul (s, gain),
+                                  JUCE_LOAD_SRC_WITH_LINEAR_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (double* dest, const double* src, double startGain, double gainIncrement, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladdD (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * (startGain + gainIncrement * (double) (dest + i - destStart)), Mode::multiplyAdd (d, s, gain),
+                                  JUCE_LOAD_SRC_DEST_WITH_LINEAR_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_LINEAR_RAMP)
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyWithExponentialRamp (float* dest, float startGain, float gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                              Mode::mul (d, gain), JUCE_LOAD_DEST_WITH_EXPONENTIAL_RAMP, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithExponentialRamp (float* dest, const float* src, float startGain, float gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                                  Mode::mul (s, gain), JUCE_LOAD_SRC_WITH_EXPONENTIAL_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithExponentialRamp (float* dest, const float* src, float startGain, float gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                                  Mode::multiplyAdd (d, s, gain), JUCE_LOAD_SRC_DEST_WITH_EXPONENTIAL_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::multiplyWithExponentialRamp (double* dest, double startGain, double gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (dest[i] *= FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                              Mode::mul (d, gain), JUCE_LOAD_DEST_WITH_EXPONENTIAL_RAMP, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithExponentialRamp (double* dest, const double* src, double startGain, double gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                                  Mode::mul (s, gain), JUCE_LOAD_SRC_WITH_EXPONENTIAL_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithExponentialRamp (double* dest, const double* src, double startGain, double gainMultiplier, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * FloatVectorHelpers::getExponentialRampGain (startGain, gainMultiplier, (int) (dest + i - destStart)),
+                                  Mode::multiplyAdd (d, s, gain), JUCE_LOAD_SRC_DEST_WITH_EXPONENTIAL_RAMP, JUCE_INCREMENT_SRC_DEST, JUCE_SETUP_EXPONENTIAL_RAMP)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamps (float* dest, const float* const* sources, const float* startGains,
+                                                   const float* gainIncrements, int numSources, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (for (int source = 0; source < numSources; ++source)
+                                  dest[i] += sources[source][dest + i - destStart] * (startGains[source] + gainIncrements[source] * (float) (dest + i - destStart)),
+                              mix, JUCE_LOAD_DEST_AND_MIX_SOURCES_WITH_RAMPS, JUCE_SETUP_RAMP_INDEX)
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamps (double* dest, const double* const* sources, const double* startGains,
+                                                   const double* gainIncrements, int numSources, int num) noexcept
+{
+    auto* destStart = dest;
+
+    JUCE_PERFORM_VEC_OP_DEST (for (int source = 0; source < numSources; ++source)
+                                  dest[i] += sources[source][dest + i - destStart] * (startGains[source] + gainIncrements[source] * (double) (dest + i - destStart)),
+                              mix, JUCE_LOAD_DEST_AND_MIX_SOURCES_WITH_RAMPS, JUCE_SETUP_RAMP_INDEX)
+}
+
 void FloatVectorOperations::negate (float* dest, const float* src, int num) noexcept
 {
    #if JUCE_USE_VDSP_FRAMEWORK
@@ -878,7 +1451,7 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, )
    #else
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
-                                  Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*) src))),
+                                  Mode::mul (mult, Mode::loadIntU (src)),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -1230,6 +1803,89 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            doRampTests (u, random, data1, data2, num);
+        }
+
+        static void doRampTests (UnitTest& u, Random& random, ValueType* data1, ValueType* data2, int num)
+        {
+            HeapBlock<ValueType> expected (num), magnitudes (num);
+            auto startGain = (ValueType) random.nextDouble();
+            auto increment = (ValueType) ((random.nextDouble() - 0.5) / num);
+            auto multiplier = (ValueType) (1.0 + (random.nextDouble() - 0.5) / num);
+
+            auto linearGain      = [=] (int i) { return startGain + increment * (ValueType) i; };
+            auto exponentialGain = [=] (int i) { return startGain * (ValueType) std::pow (multiplier, (ValueType) i); };
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+
+            // the linear gains can cross zero, where the rounding errors of the terms
+            // of the sum are much bigger than the result
+            auto linearGainMagnitude = [=] (int i) { return std::abs (startGain) + std::abs (increment * (ValueType) i); };
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] = data1[i] * linearGain (i);
+                magnitudes[i] = std::abs (data1[i]) * linearGainMagnitude (i);
+            }
+
+            FloatVectorOperations::copyWithRamp (data2, data1, startGain, increment, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            FloatVectorOperations::copy (data2, data1, num);
+            FloatVectorOperations::multiplyWithRamp (data2, startGain, increment, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] = data2[i] + data1[i] * linearGain (i);
+                magnitudes[i] = std::abs (data2[i]) + std::abs (data1[i]) * linearGainMagnitude (i);
+            }
+
+            FloatVectorOperations::addWithRamp (data2, data1, startGain, increment, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            // the exponential gains are worked out by repeated multiplications, whose
+            // rounding errors add up along the ramp
+            auto exponentialErrorScale = [] (int i) { return (ValueType) 1 + (ValueType) i / (ValueType) 128; };
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] = data1[i] * exponentialGain (i);
+                magnitudes[i] = std::abs (expected[i]) * exponentialErrorScale (i);
+            }
+
+            FloatVectorOperations::copyWithExponentialRamp (data2, data1, startGain, multiplier, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            FloatVectorOperations::copy (data2, data1, num);
+            FloatVectorOperations::multiplyWithExponentialRamp (data2, startGain, multiplier, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected[i] = data2[i] + data1[i] * exponentialGain (i);
+                magnitudes[i] = std::abs (data2[i]) + std::abs (data1[i] * exponentialGain (i)) * exponentialErrorScale (i);
+            }
+
+            FloatVectorOperations::addWithExponentialRamp (data2, data1, startGain, multiplier, num);
+            u.expect (buffersMatchApproximately (data2, expected, num, magnitudes));
+
+            const ValueType* sources[] = { data1, data1 + 1 };
+            const ValueType startGains[] = { startGain, (ValueType) 1 - startGain };
+            const ValueType increments[] = { increment, -increment };
+            const int numToMix = num - 1;
+
+            for (int i = 0; i < numToMix; ++i)
+            {
+                expected[i] = data2[i] + data1[i] * linearGain (i) + data1[i + 1] * ((ValueType) 1 - linearGain (i));
+                magnitudes[i] = std::abs (data2[i]) + std::abs (data1[i]) * linearGainMagnitude (i)
+                                  + std::abs (data1[i + 1]) * ((ValueType) 1 + linearGainMagnitude (i));
+            }
+
+            FloatVectorOperations::addWithRamps (data2, sources, startGains, increments, 2, numToMix);
+            u.expect (buffersMatchApproximately (data2, expected, numToMix, magnitudes));
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1281,22 +1937,166 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        static bool buffersMatchApproximately (const ValueType* d1, const ValueType* d2, int num,
+                                               const ValueType* magnitudes = nullptr)
+        {
+            for (int i = 0; i < num; ++i)
+            {
+                auto v1 = d1[i];
+                auto v2 = d2[i];
+                auto magnitude = jmax (std::abs (v1), std::abs (v2), magnitudes != nullptr ? magnitudes[i] : (ValueType) 0);
+
+                if (std::abs (v1 - v2) > magnitude * std::numeric_limits<ValueType>::epsilon() * 64)
+                    return false;
+            }
+
+            return true;
+        }
     };
 
     void runTest() override
     {
+       #if JUCE_USE_AVX_INTRINSICS
+        const ScopedAVXLevelRestorer restorer;
+
+        auto& currentLevel = FloatVectorHelpers::getCurrentAVXLevel();
+        const auto supportedLevel = currentLevel.load();
+
+        for (auto level : getAVXLevelsToTest (supportedLevel))
+        {
+            currentLevel = level;
+            beginTest ("FloatVectorOperations (" + String (getAVXLevelName (level)) + ")");
+            runTestsOnRandomData();
+        }
+       #else
         beginTest ("FloatVectorOperations");
+        runTestsOnRandomData();
+       #endif
+    }
 
+    void runTestsOnRandomData()
+    {
         for (int i = 1000; --i >= 0;)
         {
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
     }
+
+   #if JUCE_USE_AVX_INTRINSICS
+    /** Restores the code paths used by the other tests, even if this one throws. */
+    struct ScopedAVXLevelRestorer
+    {
+        ScopedAVXLevelRestorer() noexcept   : savedLevel (FloatVectorHelpers::getCurrentAVXLevel().load()) {}
+        ~ScopedAVXLevelRestorer() noexcept  { FloatVectorHelpers::getCurrentAVXLevel() = savedLevel; }
+
+        const FloatVectorHelpers::AVXLevel savedLevel;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAVXLevelRestorer)
+    };
+
+    static Array<FloatVectorHelpers::AVXLevel> getAVXLevelsToTest (FloatVectorHelpers::AVXLevel supportedLevel)
+    {
+        using Level = FloatVectorHelpers::AVXLevel;
+        Array<Level> levels;
+
+        for (auto level : { Level::none, Level::avx, Level::fma, Level::avx512 })
+            if (level <= supportedLevel)
+                levels.add (level);
+
+        return levels;
+    }
+
+    static const char* getAVXLevelName (FloatVectorHelpers::AVXLevel level)
+    {
+        switch (level)
+        {
+            case FloatVectorHelpers::AVXLevel::avx:     return "AVX";
+            case FloatVectorHelpers::AVXLevel::fma:     return "AVX2 and FMA";
+            case FloatVectorHelpers::AVXLevel::avx512:  return "AVX-512";
+            case FloatVectorHelpers::AVXLevel::none:
+            default:                                    return "SSE";
+        }
+    }
+   #endif
 };
 
 static FloatVectorOperationsTests vectorOpTests;
 
+//==============================================================================
+#if JUCE_USE_AVX_INTRINSICS && JUCE_FLOAT_VECTOR_OPERATIONS_BENCHMARK
+
+/*  Logs the time taken by some typical operations on a block of 512 samples, to
+    compare the code paths available on the current CPU.
+
+    Its results depend on the machine and on its load, so it isn't one of the unit
+    tests: it's only built when JUCE_FLOAT_VECTOR_OPERATIONS_BENCHMARK is defined, and
+    can be run with UnitTestRunner::runTestsInCategory ("Benchmarks").
+*/
+class FloatVectorOperationsBenchmark  : public UnitTest
+{
+public:
+    FloatVectorOperationsBenchmark() : UnitTest ("FloatVectorOperations", "Benchmarks") {}
+
+    void runTest() override
+    {
+        using Tests = FloatVectorOperationsTests;
+        const Tests::ScopedAVXLevelRestorer restorer;
+
+        auto& currentLevel = FloatVectorHelpers::getCurrentAVXLevel();
+        const auto supportedLevel = currentLevel.load();
+
+        for (auto level : Tests::getAVXLevelsToTest (supportedLevel))
+        {
+            currentLevel = level;
+            beginTest ("Performance (" + String (Tests::getAVXLevelName (level)) + ")");
+            runBenchmark();
+        }
+    }
+
+    void runBenchmark()
+    {
+        const int numSamples = 512;
+        HeapBlock<float> buffer1 (numSamples), buffer2 (numSamples);
+        HeapBlock<int> intBuffer (numSamples);
+
+        auto random = getRandom();
+        FloatVectorOperationsTests::TestRunner<float>::fillRandomly (random, buffer1, numSamples);
+        FloatVectorOperationsTests::TestRunner<float>::fillRandomly (random, buffer2, numSamples);
+        FloatVectorOperationsTests::TestRunner<float>::fillRandomly (random, intBuffer, numSamples);
+
+        float total = 0;
+
+        auto addWithMultiply = timeOperation ([&] { FloatVectorOperations::addWithMultiply (buffer1, buffer2, 1.0e-6f, numSamples); });
+        auto multiply        = timeOperation ([&] { FloatVectorOperations::multiply (buffer1, buffer2, numSamples); FloatVectorOperations::fill (buffer1, 1.0f, numSamples); });
+        auto findMinAndMax   = timeOperation ([&] { total += FloatVectorOperations::findMinAndMax (buffer2, numSamples).getLength(); });
+        auto convert         = timeOperation ([&] { FloatVectorOperations::convertFixedToFloat (buffer1, intBuffer, 1.0f / 0x7fffffff, numSamples); });
+
+        logMessage ("addWithMultiply: " + String (addWithMultiply, 3) + " us, "
+                     + "multiply: " + String (multiply, 3) + " us, "
+                     + "findMinAndMax: " + String (findMinAndMax, 3) + " us, "
+                     + "convertFixedToFloat: " + String (convert, 3) + " us");
+
+        expect (total > 0);
+    }
+
+    template <typename OperationType>
+    static double timeOperation (OperationType&& operation)
+    {
+        const int numIterations = 2000;
+        auto startTicks = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numIterations; ++i)
+            operation();
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1.0e6 / numIterations;
+    }
+};
+
+static FloatVectorOperationsBenchmark vectorOpBenchmark;
+
+#endif
 #endif
 
 } // namespace juce
@@ -37,6 +37,13 @@ class ScopedNoDenormals;
     A collection of simple vector operations on arrays of floats, accelerated with
     SIMD instructions where possible.
 
+    On Intel CPUs, the operations also have AVX, AVX2/FMA and AVX-512 code paths,
+    the widest one supported by the CPU being selected at runtime, so a binary built
+    for SSE2 uses the wider registers when available. The multiply-accumulate
+    operations use fused multiply-adds on the CPUs that have them, so their results
+    may differ very slightly from the SSE ones. This can be disabled by setting the
+    preprocessor flag JUCE_USE_AVX_INTRINSICS to 0.
+
     @tags{Audio}
 */
 class JUCE_API  FloatVectorOperations
@@ -151,6 +158,68 @@ public:
     /** Multiplies each of the source values by a fixed multiplier and stores the result in the destination array. */
     static void JUCE_CALLTYPE multiply (double* dest, const double* src, double multiplier, int num) noexcept;
 
+    /** Multiplies the destination values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement. */
+    static void JUCE_CALLTYPE multiplyWithRamp (float* dest, float startGain, float gainIncrement, int num) noexcept;
+
+    /** Multiplies the destination values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement. */
+    static void JUCE_CALLTYPE multiplyWithRamp (double* dest, double startGain, double gainIncrement, int num) noexcept;
+
+    /** Multiplies the source values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement, and stores them in the destination array. */
+    static void JUCE_CALLTYPE copyWithRamp (float* dest, const float* src, float startGain, float gainIncrement, int num) noexcept;
+
+    /** Multiplies the source values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement, and stores them in the destination array. */
+    static void JUCE_CALLTYPE copyWithRamp (double* dest, const double* src, double startGain, double gainIncrement, int num) noexcept;
+
+    /** Multiplies the source values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement, then adds them to the destination values. */
+    static void JUCE_CALLTYPE addWithRamp (float* dest, const float* src, float startGain, float gainIncrement, int num) noexcept;
+
+    /** Multiplies the source values by a linear gain ramp, the gain of the value i being startGain + i * gainIncrement, then adds them to the destination values. */
+    static void JUCE_CALLTYPE addWithRamp (double* dest, const double* src, double startGain, double gainIncrement, int num) noexcept;
+
+    /** Multiplies the destination values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i. */
+    static void JUCE_CALLTYPE multiplyWithExponentialRamp (float* dest, float startGain, float gainMultiplier, int num) noexcept;
+
+    /** Multiplies the destination values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i. */
+    static void JUCE_CALLTYPE multiplyWithExponentialRamp (double* dest, double startGain, double gainMultiplier, int num) noexcept;
+
+    /** Multiplies the source values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i, and stores them in the destination array. */
+    static void JUCE_CALLTYPE copyWithExponentialRamp (float* dest, const float* src, float startGain, float gainMultiplier, int num) noexcept;
+
+    /** Multiplies the source values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i, and stores them in the destination array. */
+    static void JUCE_CALLTYPE copyWithExponentialRamp (double* dest, const double* src, double startGain, double gainMultiplier, int num) noexcept;
+
+    /** Multiplies the source values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i, then adds them to the destination values. */
+    static void JUCE_CALLTYPE addWithExponentialRamp (float* dest, const float* src, float startGain, float gainMultiplier, int num) noexcept;
+
+    /** Multiplies the source values by an exponential gain ramp, the gain of the value i being startGain * gainMultiplier^i, then adds them to the destination values. */
+    static void JUCE_CALLTYPE addWithExponentialRamp (double* dest, const double* src, double startGain, double gainMultiplier, int num) noexcept;
+
+    /** Mixes several source vectors into the destination values in a single pass, each source having its own
+        linear gain ramp, as described for addWithRamp().
+
+        @param dest             the values to add the sources to
+        @param sources          an array of numSources pointers to the source values
+        @param startGains       an array of numSources gains to apply to the first value of each source
+        @param gainIncrements   an array of numSources increments added to the gain of each source after every value
+        @param numSources       the number of sources to mix
+        @param num              the number of values to process
+    */
+    static void JUCE_CALLTYPE addWithRamps (float* dest, const float* const* sources, const float* startGains,
+                                            const float* gainIncrements, int numSources, int num) noexcept;
+
+    /** Mixes several source vectors into the destination values in a single pass, each source having its own
+        linear gain ramp, as described for addWithRamp().
+
+        @param dest             the values to add the sources to
+        @param sources          an array of numSources pointers to the source values
+        @param startGains       an array of numSources gains to apply to the first value of each source
+        @param gainIncrements   an array of numSources increments added to the gain of each source after every value
+        @param numSources       the number of sources to mix
+        @param num              the number of values to process
+    */
+    static void JUCE_CALLTYPE addWithRamps (double* dest, const double* const* sources, const double* startGains,
+                                            const double* gainIncrements, int numSources, int num) noexcept;
+
     /** Copies a source vector to a destination, negating each value. */
     static void JUCE_CALLTYPE negate (float* dest, const float* src, int numValues) noexcept;
 
@@ -28,6 +28,8 @@ namespace juce
     Utility class for linearly smoothed values like volume etc. that should
     not change abruptly but as a linear ramp, to avoid audio glitches.
 
+    @see SmoothedValue
+
     @tags{Audio}
 */
 template <typename FloatType>
@@ -123,8 +125,11 @@ public:
 
         if (isSmoothing())
         {
-            for (int i = 0; i < numSamples; i++)
-                samples[i] *= getNextValue();
+            auto numRamp = jmin (numSamples, countdown);
+
+            FloatVectorOperations::multiplyWithRamp (samples, currentValue + step, step, numRamp);
+            FloatVectorOperations::multiply (samples + numRamp, target, numSamples - numRamp);
+            skip (numSamples);
         }
         else
         {
@@ -145,8 +150,11 @@ public:
 
         if (isSmoothing())
         {
-            for (int i = 0; i < numSamples; i++)
-                samplesOut[i] = samplesIn[i] * getNextValue();
+            auto numRamp = jmin (numSamples, countdown);
+
+            FloatVectorOperations::copyWithRamp (samplesOut, samplesIn, currentValue + step, step, numRamp);
+            FloatVectorOperations::multiply (samplesOut + numRamp, samplesIn + numRamp, target, numSamples - numRamp);
+            skip (numSamples);
         }
         else
         {
@@ -162,23 +170,17 @@ public:
 
         if (isSmoothing())
         {
-            if (buffer.getNumChannels() == 1)
-            {
-                FloatType* samples = buffer.getWritePointer(0);
+            auto numRamp = jmin (numSamples, countdown);
 
-                for (int i = 0; i < numSamples; i++)
-                    samples[i] *= getNextValue();
-            }
-            else
+            for (int channel = 0; channel < buffer.getNumChannels(); channel++)
             {
-                for (int i = 0; i < numSamples; i++)
-                {
-                    const FloatType gain = getNextValue();
+                auto* samples = buffer.getWritePointer (channel);
 
-                    for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-                        buffer.setSample (channel, i, buffer.getSample (channel, i) * gain);
-                }
+                FloatVectorOperations::multiplyWithRamp (samples, currentValue + step, step, numRamp);
+                FloatVectorOperations::multiply (samples + numRamp, target, numSamples - numRamp);
             }
+
+            skip (numSamples);
         }
         else
         {
@@ -0,0 +1,781 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+namespace SincResamplerHelpers
+{
+    enum
+    {
+        maxExactPhases = 1024,      // the largest denominator of a ratio using exact phases
+        numInterpolatedPhases = 256,
+        interpolationBits = 16,
+        maxChunkSize = 1024
+    };
+
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; term > sum * 1.0e-12; ++k)
+        {
+            auto a = x / (2.0 * k);
+            term *= a * a;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    static int64 greatestCommonDivisor (int64 a, int64 b) noexcept
+    {
+        while (b != 0)
+        {
+            auto remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+
+        return a;
+    }
+
+    // the number of values must be a multiple of 4
+    static float dotProduct (const float* a, const float* b, int num) noexcept
+    {
+        jassert (num % 4 == 0);
+
+       #if JUCE_USE_SSE_INTRINSICS
+        auto sum1 = _mm_setzero_ps();
+        auto sum2 = _mm_setzero_ps();
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            sum1 = _mm_add_ps (sum1, _mm_mul_ps (_mm_loadu_ps (a + i),     _mm_loadu_ps (b + i)));
+            sum2 = _mm_add_ps (sum2, _mm_mul_ps (_mm_loadu_ps (a + i + 4), _mm_loadu_ps (b + i + 4)));
+        }
+
+        if (i < num)
+            sum1 = _mm_add_ps (sum1, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+
+        sum1 = _mm_add_ps (sum1, sum2);
+        sum1 = _mm_add_ps (sum1, _mm_movehl_ps (sum1, sum1));
+        sum1 = _mm_add_ss (sum1, _mm_shuffle_ps (sum1, sum1, 1));
+        return _mm_cvtss_f32 (sum1);
+       #elif JUCE_USE_ARM_NEON
+        auto sum = vdupq_n_f32 (0);
+
+        for (int i = 0; i < num; i += 4)
+            sum = vmlaq_f32 (sum, vld1q_f32 (a + i), vld1q_f32 (b + i));
+
+        auto pair = vadd_f32 (vget_low_f32 (sum), vget_high_f32 (sum));
+        return vget_lane_f32 (vpadd_f32 (pair, pair), 0);
+       #else
+        float sums[4] = {};
+
+        for (int i = 0; i < num; i += 4)
+            for (int j = 0; j < 4; ++j)
+                sums[j] += a[i + j] * b[i + j];
+
+        return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+       #endif
+    }
+}
+
+//==============================================================================
+SincResampler::SincResampler (int zeroCrossings)  : numZeroCrossings (zeroCrossings)
+{
+    jassert (numZeroCrossings > 0);
+    setRatio (1.0, 1, 1);
+}
+
+SincResampler::~SincResampler() {}
+
+//==============================================================================
+void SincResampler::setResamplingRatio (double samplesInPerOutputSample)
+{
+    jassert (samplesInPerOutputSample > 0);
+
+    // looks for the smallest fraction equal to the ratio
+    for (int64 denominator = 1; denominator <= SincResamplerHelpers::maxExactPhases; ++denominator)
+    {
+        auto numerator = (int64) std::llround (samplesInPerOutputSample * (double) denominator);
+
+        if (numerator > 0 && std::abs ((double) numerator / (double) denominator - samplesInPerOutputSample)
+                               <= samplesInPerOutputSample * 1.0e-12)
+        {
+            setRatio (samplesInPerOutputSample, numerator, denominator);
+            return;
+        }
+    }
+
+    setRatio (samplesInPerOutputSample, 0, 0);
+}
+
+void SincResampler::setSampleRates (double inputSampleRate, double outputSampleRate)
+{
+    jassert (inputSampleRate > 0 && outputSampleRate > 0);
+
+    auto inputRate  = (int64) inputSampleRate;
+    auto outputRate = (int64) outputSampleRate;
+
+    if (inputRate > 0 && outputRate > 0
+         && (double) inputRate == inputSampleRate && (double) outputRate == outputSampleRate)
+    {
+        auto divisor = SincResamplerHelpers::greatestCommonDivisor (inputRate, outputRate);
+        setRatio (inputSampleRate / outputSampleRate, inputRate / divisor, outputRate / divisor);
+    }
+    else
+    {
+        setResamplingRatio (inputSampleRate / outputSampleRate);
+    }
+}
+
+void SincResampler::setRatio (double newRatio, int64 numerator, int64 denominator)
+{
+    auto oldDenominator = phaseDenominator;
+    ratio = newRatio;
+
+    if (denominator > 0 && denominator <= SincResamplerHelpers::maxExactPhases)
+    {
+        numTablePhases = (int) denominator;
+        phaseShift = 0;
+        phaseDenominator = (uint32) denominator;
+        stepInSamples = (int) (numerator / denominator);
+        phaseStep = (uint32) (numerator % denominator);
+    }
+    else
+    {
+        numTablePhases = SincResamplerHelpers::numInterpolatedPhases;
+        phaseShift = SincResamplerHelpers::interpolationBits;
+        phaseDenominator = (uint32) numTablePhases << phaseShift;
+
+        auto step = (int64) std::llround (ratio * phaseDenominator);
+        stepInSamples = (int) (step / phaseDenominator);
+        phaseStep = (uint32) (step % phaseDenominator);
+    }
+
+    phase = (uint32) (((uint64) phase * phaseDenominator) / oldDenominator);
+
+    auto oldNumTaps = numTaps;
+    createTable();
+
+    if (numTaps != oldNumTaps && numChannels > 0)
+        prepare (numChannels);
+}
+
+void SincResampler::createTable()
+{
+    auto scale = jmin (1.0, 1.0 / ratio);
+
+    // the filter is made longer when downsampling, and rounded up to a multiple of 4
+    // for the SIMD inner products
+    numTaps = ((int) std::ceil (2.0 * numZeroCrossings / scale) + 3) & ~3;
+
+    // Kaiser window design for a 90 dB stopband attenuation, with the transition band
+    // ending at the output Nyquist frequency
+    const double attenuation = 90.0;
+    auto beta = 0.1102 * (attenuation - 8.7);
+    auto transitionWidth = (attenuation - 8.0) / (2.285 * MathConstants<double>::twoPi * numTaps);
+    auto cutoff = jmax (0.1 * scale, 0.5 * scale - 0.5 * transitionWidth);
+
+    auto halfLength = numTaps / 2;
+    auto centre = halfLength - 1;
+    auto windowScale = 1.0 / SincResamplerHelpers::besselI0 (beta);
+
+    // with interpolated phases, an extra row holds the phase 1 for the last interpolation
+    auto numRows = numTablePhases + (phaseShift > 0 ? 1 : 0);
+    table.malloc ((size_t) (numRows * numTaps));
+    interpolatedCoefficients.malloc ((size_t) numTaps);
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        auto* coefficients = table + row * numTaps;
+        auto fraction = row / (double) numTablePhases;
+        double sum = 0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            auto t = i - centre - fraction;
+            auto x = t / halfLength;
+            auto window = std::abs (x) < 1.0 ? SincResamplerHelpers::besselI0 (beta * std::sqrt (1.0 - x * x)) * windowScale : 0.0;
+            auto phi = MathConstants<double>::twoPi * cutoff * t;
+            auto sinc = std::abs (phi) < 1.0e-9 ? 1.0 : std::sin (phi) / phi;
+
+            auto c = 2.0 * cutoff * sinc * window;
+            coefficients[i] = (float) c;
+            sum += c;
+        }
+
+        // every phase is normalised for a unity gain at DC
+        FloatVectorOperations::multiply (coefficients, (float) (1.0 / sum), numTaps);
+    }
+}
+
+//==============================================================================
+void SincResampler::prepare (int newNumChannels)
+{
+    jassert (newNumChannels >= 0);
+
+    numChannels = newNumChannels;
+    history.setSize (numChannels, numTaps + SincResamplerHelpers::maxChunkSize);
+    reset();
+}
+
+void SincResampler::reset() noexcept
+{
+    history.clear();
+
+    // the history starts with zeros up to the centre of the filter, so that the first
+    // output sample lies on the first input sample
+    numBuffered = numTaps / 2 - 1;
+    readPosition = 0;
+    phase = 0;
+}
+
+void SincResampler::continueFrom (const SincResampler& other) noexcept
+{
+    jassert (numChannels == other.numChannels);
+
+    reset();
+
+    if (numTaps != other.numTaps || numChannels != other.numChannels)
+        return;
+
+    numBuffered = other.numBuffered - other.readPosition;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        FloatVectorOperations::copy (history.getWritePointer (channel),
+                                     other.history.getReadPointer (channel, other.readPosition), numBuffered);
+
+    phase = (uint32) (((uint64) other.phase * phaseDenominator) / other.phaseDenominator);
+}
+
+int64 SincResampler::getPositionInPhases() const noexcept
+{
+    return (int64) readPosition * phaseDenominator + phase;
+}
+
+int64 SincResampler::getStepInPhases() const noexcept
+{
+    return (int64) stepInSamples * phaseDenominator + phaseStep;
+}
+
+int SincResampler::getNumOutputSamples (int numInputSamples) const noexcept
+{
+    // the output samples whose filter ends before the last input sample
+    auto limit = (int64) (numBuffered + numInputSamples - numTaps + 1) * phaseDenominator;
+    auto position = getPositionInPhases();
+
+    if (limit <= position)
+        return 0;
+
+    auto step = getStepInPhases();
+    return (int) ((limit - position + step - 1) / step);
+}
+
+int SincResampler::getNumInputSamplesNeeded (int numOutputSamples) const noexcept
+{
+    if (numOutputSamples <= 0)
+        return 0;
+
+    auto lastPosition = getPositionInPhases() + (int64) (numOutputSamples - 1) * getStepInPhases();
+    auto lastSample = lastPosition / phaseDenominator;
+
+    return jmax (0, (int) (lastSample + numTaps - numBuffered));
+}
+
+//==============================================================================
+int SincResampler::process (const float* const* inputChannels, int numInputSamples,
+                            float* const* outputChannels, int maxNumOutputSamples) noexcept
+{
+    jassert (history.getNumChannels() == numChannels && numChannels > 0);
+    jassert (maxNumOutputSamples >= 0);
+
+    auto capacity = history.getNumSamples();
+    int numProduced = 0;
+
+    // the history can hold enough samples for some output samples that were left
+    // over by a limited call, so this runs at least once even without any input
+    for (int numUsed = 0;;)
+    {
+        auto numToCopy = jmin (numInputSamples - numUsed, capacity - numBuffered);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            FloatVectorOperations::copy (history.getWritePointer (channel, numBuffered),
+                                         inputChannels[channel] + numUsed, numToCopy);
+
+        numBuffered += numToCopy;
+        numUsed += numToCopy;
+
+        numProduced += produceOutputs (outputChannels, numProduced, maxNumOutputSamples - numProduced);
+
+        // only the samples needed by the next output samples are kept
+        jassert (readPosition <= numBuffered);
+        auto numToKeep = numBuffered - readPosition;
+
+        if (readPosition > 0)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = history.getWritePointer (channel);
+                memmove (data, data + readPosition, sizeof (float) * (size_t) numToKeep);
+            }
+        }
+
+        numBuffered = numToKeep;
+        readPosition = 0;
+
+        if (numUsed >= numInputSamples)
+            break;
+
+        if (numBuffered == capacity)
+        {
+            // once the output is limited, the input left over has to fit in the history
+            jassertfalse;
+            break;
+        }
+    }
+
+    return numProduced;
+}
+
+int SincResampler::produceOutputs (float* const* outputChannels, int startSample, int maxNumOutputSamples) noexcept
+{
+    auto subPhaseMask = (1u << phaseShift) - 1;
+    auto subPhaseScale = 1.0f / (float) (1u << phaseShift);
+    int numProduced = 0;
+
+    while (numProduced < maxNumOutputSamples && readPosition + numTaps <= numBuffered)
+    {
+        const float* coefficients = table + (size_t) (phase >> phaseShift) * (size_t) numTaps;
+
+        if (auto subPhase = phase & subPhaseMask)
+        {
+            // the coefficients are interpolated once for all the channels
+            auto* next = coefficients + numTaps;
+            auto amount = (float) subPhase * subPhaseScale;
+
+            for (int i = 0; i < numTaps; ++i)
+                interpolatedCoefficients[i] = coefficients[i] + amount * (next[i] - coefficients[i]);
+
+            coefficients = interpolatedCoefficients;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            if (auto* dest = outputChannels[channel])
+                dest[startSample + numProduced] = SincResamplerHelpers::dotProduct (coefficients,
+                                                                                    history.getReadPointer (channel, readPosition),
+                                                                                    numTaps);
+
+        ++numProduced;
+        readPosition += stepInSamples;
+        phase += phaseStep;
+
+        if (phase >= phaseDenominator)
+        {
+            phase -= phaseDenominator;
+            ++readPosition;
+        }
+    }
+
+    return numProduced;
+}
+
+//==============================================================================
+AudioBuffer<float> SincResampler::resample (const AudioBuffer<float>& source,
+                                            double inputSampleRate, double outputSampleRate,
+                                            int numZeroCrossings)
+{
+    SincResampler resampler (numZeroCrossings);
+    resampler.setSampleRates (inputSampleRate, outputSampleRate);
+
+    auto numChannels = source.getNumChannels();
+    auto numOutputSamples = roundToInt (source.getNumSamples() / resampler.getResamplingRatio());
+
+    AudioBuffer<float> result (numChannels, numOutputSamples);
+
+    if (numChannels == 0)
+        return result;
+
+    resampler.prepare (numChannels);
+    auto numProduced = resampler.process (source.getArrayOfReadPointers(), source.getNumSamples(),
+                                          result.getArrayOfWritePointers(), numOutputSamples);
+
+    // the end of the stream is flushed with zeros
+    AudioBuffer<float> zeros (numChannels, resampler.getNumInputSamplesNeeded (numOutputSamples - numProduced));
+    zeros.clear();
+
+    HeapBlock<float*> dest ((size_t) numChannels);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        dest[channel] = result.getWritePointer (channel, numProduced);
+
+    numProduced += resampler.process (zeros.getArrayOfReadPointers(), zeros.getNumSamples(), dest,
+                                      numOutputSamples - numProduced);
+    jassert (numProduced == numOutputSamples);
+
+    return result;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SincResamplerTests  : public UnitTest
+{
+public:
+    SincResamplerTests()  : UnitTest ("SincResampler", "Audio") {}
+
+    static AudioBuffer<float> createSine (int numChannels, int numSamples, double frequency, double sampleRate)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, (float) std::sin (MathConstants<double>::twoPi * frequency * i / sampleRate + channel));
+
+        return buffer;
+    }
+
+    // returns the largest difference with a sine, away from the ends of the buffer
+    static float getSineError (const AudioBuffer<float>& buffer, double frequency, double sampleRate, int margin)
+    {
+        float maxError = 0;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = margin; i < buffer.getNumSamples() - margin; ++i)
+                maxError = jmax (maxError, std::abs (buffer.getSample (channel, i)
+                                                       - (float) std::sin (MathConstants<double>::twoPi * frequency * i / sampleRate + channel)));
+
+        return maxError;
+    }
+
+    // plays a buffer once
+    struct BufferSource  : public AudioSource
+    {
+        BufferSource (const AudioBuffer<float>& b)  : buffer (b) {}
+
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            auto numToCopy = jmin (info.numSamples, buffer.getNumSamples() - position);
+            info.clearActiveBufferRegion();
+
+            for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel)
+                info.buffer->copyFrom (channel, info.startSample, buffer, channel % buffer.getNumChannels(), position, numToCopy);
+
+            position += numToCopy;
+        }
+
+        const AudioBuffer<float>& buffer;
+        int position = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Conversions between sample rates");
+        {
+            struct Conversion { double inputRate, outputRate; bool exact; };
+
+            for (auto c : { Conversion { 96000.0, 48000.0, true },
+                            Conversion { 44100.0, 48000.0, true },
+                            Conversion { 48000.0, 44100.0, true },
+                            Conversion { 44100.0, 44100.0, true },
+                            Conversion { 48000.0, 37993.7, false } })
+            {
+                auto input = createSine (2, 9600, 1000.0, c.inputRate);
+                auto output = SincResampler::resample (input, c.inputRate, c.outputRate);
+
+                expectEquals (output.getNumSamples(), roundToInt (9600 * c.outputRate / c.inputRate));
+                expect (getSineError (output, 1000.0, c.outputRate, 100) < 1.0e-3f);
+
+                SincResampler resampler;
+                resampler.setSampleRates (c.inputRate, c.outputRate);
+                expect (resampler.isRatioExact() == c.exact);
+            }
+        }
+
+        beginTest ("Frequencies above the output Nyquist frequency are removed");
+        {
+            auto output = SincResampler::resample (createSine (1, 9600, 30000.0, 96000.0), 96000.0, 48000.0);
+            auto range = FloatVectorOperations::findMinAndMax (output.getReadPointer (0, 200), output.getNumSamples() - 400);
+
+            expect (jmax (-range.getStart(), range.getEnd()) < 1.0e-3f);
+        }
+
+        beginTest ("Processing in blocks");
+        {
+            Random random (0x1234);
+
+            for (auto ratio : { 2.0, 0.75, 1.2345678 })
+            {
+                auto input = createSine (3, 5000, 500.0, 44100.0);
+
+                SincResampler reference, resampler;
+
+                for (auto* r : { &reference, &resampler })
+                {
+                    r->setResamplingRatio (ratio);
+                    r->prepare (3);
+                }
+
+                AudioBuffer<float> expected (3, reference.getNumOutputSamples (5000));
+                expectEquals (reference.process (input.getArrayOfReadPointers(), 5000, expected.getArrayOfWritePointers()),
+                              expected.getNumSamples());
+
+                AudioBuffer<float> output (3, expected.getNumSamples());
+                int numInput = 0, numOutput = 0;
+
+                while (numInput < 5000)
+                {
+                    auto blockSize = jmin (5000 - numInput, random.nextInt (1500));
+                    const float* in[3];
+                    float* out[3];
+
+                    for (int channel = 0; channel < 3; ++channel)
+                    {
+                        in[channel]  = input.getReadPointer (channel, numInput);
+                        out[channel] = output.getWritePointer (channel, numOutput);
+                    }
+
+                    auto numExpected = resampler.getNumOutputSamples (blockSize);
+                    expectEquals (resampler.process (in, blockSize, out), numExpected);
+
+                    numInput += blockSize;
+                    numOutput += numExpected;
+                }
+
+                expectEquals (numOutput, expected.getNumSamples());
+
+                for (int channel = 0; channel < 3; ++channel)
+                    for (int i = 0; i < numOutput; ++i)
+                        expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+            }
+        }
+
+        beginTest ("Number of input samples needed");
+        {
+            for (auto ratio : { 1.37, 0.75, 0.3 })
+            {
+                SincResampler resampler;
+                resampler.setResamplingRatio (ratio);
+                resampler.prepare (1);
+
+                for (int numOutput : { 1, 10, 100, 1000 })
+                {
+                    auto numInput = resampler.getNumInputSamplesNeeded (numOutput);
+                    expect (resampler.getNumOutputSamples (numInput) >= numOutput);
+                    expect (resampler.getNumOutputSamples (numInput - 1) < numOutput);
+                }
+            }
+        }
+
+        beginTest ("Limiting the number of output samples");
+        {
+            Random random (0x4321);
+
+            for (auto ratio : { 1.37, 0.75, 0.3 })
+            {
+                auto input = createSine (2, 6000, 500.0, 44100.0);
+                SincResampler reference, resampler;
+
+                for (auto* r : { &reference, &resampler })
+                {
+                    r->setResamplingRatio (ratio);
+                    r->prepare (2);
+                }
+
+                AudioBuffer<float> expected (2, reference.getNumOutputSamples (6000));
+                reference.process (input.getArrayOfReadPointers(), 6000, expected.getArrayOfWritePointers());
+
+                // the output has a guard sample after each block, which mustn't be written
+                AudioBuffer<float> output (2, expected.getNumSamples() + 1);
+                int numInput = 0, numOutput = 0;
+
+                for (;;)
+                {
+                    auto blockSize = 1 + random.nextInt (300);
+                    auto numNeeded = resampler.getNumInputSamplesNeeded (blockSize);
+
+                    if (numInput + numNeeded > 6000 || numOutput + blockSize > expected.getNumSamples())
+                        break;
+
+                    const float* in[] = { input.getReadPointer (0, numInput), input.getReadPointer (1, numInput) };
+                    float* out[] = { output.getWritePointer (0, numOutput), output.getWritePointer (1, numOutput) };
+
+                    output.setSample (0, numOutput + blockSize, 123.0f);
+                    expectEquals (resampler.process (in, numNeeded, out, blockSize), blockSize);
+                    expectEquals (output.getSample (0, numOutput + blockSize), 123.0f);
+
+                    numInput += numNeeded;
+                    numOutput += blockSize;
+                }
+
+                expect (numOutput > expected.getNumSamples() / 2);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < numOutput; ++i)
+                        expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+            }
+        }
+
+        beginTest ("Continuing a stream with a new filter");
+        {
+            auto input = createSine (2, 4000, 500.0, 44100.0);
+            SincResampler reference, resampler, replacement;
+
+            for (auto* r : { &reference, &resampler })
+            {
+                r->setResamplingRatio (0.75);
+                r->prepare (2);
+            }
+
+            replacement.setResamplingRatio (0.9);
+            replacement.prepare (2);
+
+            AudioBuffer<float> expected (2, 6000), output (2, 6000);
+            auto numExpected = reference.process (input.getArrayOfReadPointers(), 2000, expected.getArrayOfWritePointers());
+            expectEquals (resampler.process (input.getArrayOfReadPointers(), 2000, output.getArrayOfWritePointers()), numExpected);
+
+            reference.setResamplingRatio (0.9);
+            replacement.continueFrom (resampler);
+
+            const float* in[] = { input.getReadPointer (0, 2000), input.getReadPointer (1, 2000) };
+            float* expectedOut[] = { expected.getWritePointer (0, numExpected), expected.getWritePointer (1, numExpected) };
+            float* out[] = { output.getWritePointer (0, numExpected), output.getWritePointer (1, numExpected) };
+
+            auto numRemaining = reference.process (in, 2000, expectedOut);
+            expectEquals (replacement.process (in, 2000, out), numRemaining);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numExpected + numRemaining; ++i)
+                    expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+        }
+
+        beginTest ("Changing the ratio of a SincResamplingAudioSource");
+        {
+            const int blockSize = 256, numBlocks = 20;
+            auto input = createSine (1, 20000, 500.0, 44100.0);
+
+            BufferSource bufferSource (input);
+            SincResamplingAudioSource source (&bufferSource, false, 1);
+            source.setResamplingRatio (0.3);
+            source.prepareToPlay (blockSize, 44100.0);
+
+            SincResampler reference;
+            reference.setResamplingRatio (0.3);
+            reference.prepare (1);
+
+            AudioBuffer<float> output (1, blockSize), expected (1, blockSize);
+            int inputPosition = 0;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                if (block == numBlocks / 2)
+                {
+                    source.setResamplingRatio (0.9);
+                    reference.setResamplingRatio (0.9);
+                }
+
+                source.getNextAudioBlock (AudioSourceChannelInfo (output));
+
+                auto numNeeded = reference.getNumInputSamplesNeeded (blockSize);
+                const float* in[] = { input.getReadPointer (0, inputPosition) };
+                float* out[] = { expected.getWritePointer (0) };
+                expectEquals (reference.process (in, numNeeded, out, blockSize), blockSize);
+                inputPosition += numNeeded;
+
+                for (int i = 0; i < blockSize; ++i)
+                    expectEquals (output.getSample (0, i), expected.getSample (0, i));
+            }
+
+            source.releaseResources();
+        }
+
+        beginTest ("Changing the ratio while the audio thread is running");
+        {
+            // a silent source which counts the samples it was asked for
+            struct CountingSource  : public AudioSource
+            {
+                void prepareToPlay (int, double) override {}
+                void releaseResources() override {}
+
+                void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+                {
+                    info.clearActiveBufferRegion();
+                    numSamplesRead += info.numSamples;
+                }
+
+                std::atomic<int64> numSamplesRead { 0 };
+            };
+
+            const int blockSize = 64;
+            CountingSource countingSource;
+            SincResamplingAudioSource source (&countingSource, false, 1, 4);
+            source.prepareToPlay (blockSize, 44100.0);
+
+            AudioBuffer<float> output (1, blockSize);
+
+            struct AudioThread  : public Thread
+            {
+                AudioThread (AudioSource& s, AudioBuffer<float>& b)  : Thread ("Audio"), audioSource (s), buffer (b) {}
+
+                void run() override
+                {
+                    while (! threadShouldExit())
+                        audioSource.getNextAudioBlock (AudioSourceChannelInfo (buffer));
+                }
+
+                AudioSource& audioSource;
+                AudioBuffer<float>& buffer;
+            };
+
+            AudioThread audioThread (source, output);
+            audioThread.startThread();
+
+            for (int i = 0; i < 300; ++i)
+                source.setResamplingRatio (i % 2 == 0 ? 0.5 : 0.75);
+
+            source.setResamplingRatio (4.0);
+            audioThread.stopThread (-1);
+
+            // the last ratio has to be picked up, whenever the audio thread retired the previous states
+            for (int i = 0; i < 3; ++i)
+                source.getNextAudioBlock (AudioSourceChannelInfo (output));
+
+            auto numRead = countingSource.numSamplesRead.load();
+            source.getNextAudioBlock (AudioSourceChannelInfo (output));
+            expectEquals ((int) (countingSource.numSamplesRead - numRead), 4 * blockSize);
+
+            source.releaseResources();
+        }
+    }
+};
+
+static SincResamplerTests sincResamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high quality resampler for multi-channel streams of floats, using a
+    windowed-sinc polyphase filter.
+
+    The filter is designed when the ratio is set, and its coefficients are stored
+    in a table with one set of coefficients (a phase) for every possible fractional
+    position of the output samples. When the ratio is a fraction with a denominator
+    lower than 1024, such as the ratio between two standard sample rates, each output
+    sample uses one of these phases exactly. Otherwise, the coefficients are linearly
+    interpolated between the 256 phases of the table.
+
+    All the channels are resampled in one pass, using the same coefficients for every
+    channel, and the inner products use SIMD instructions when they're available.
+
+    The output is aligned with the input, so that output sample n corresponds to the
+    input sample n * ratio. That means that the resampler needs half the length of
+    its filter of input samples ahead before producing an output sample, which has
+    to be flushed with zeros at the end of a stream.
+
+    @code
+    SincResampler resampler;
+    resampler.setSampleRates (96000.0, 48000.0);
+    resampler.prepare (2);
+    auto numOutputSamples = resampler.process (input.getArrayOfReadPointers(), input.getNumSamples(),
+                                               output.getArrayOfWritePointers());
+    @endcode
+
+    @see SincResamplingAudioSource, LagrangeInterpolator
+
+    @tags{Audio}
+*/
+class JUCE_API  SincResampler
+{
+public:
+    //==============================================================================
+    /** Creates a resampler with a ratio of 1.
+
+        @param numZeroCrossings     the number of zero crossings of the sinc function on
+                                    each side of its centre, which sets the quality of the
+                                    filter. When downsampling, the filter is made longer by
+                                    the ratio to keep the same transition band.
+    */
+    explicit SincResampler (int numZeroCrossings = 32);
+
+    /** Destructor. */
+    ~SincResampler();
+
+    //==============================================================================
+    /** Changes the resampling ratio, which must be greater than 0.
+
+        This designs a new filter, which allocates memory. If the length of the filter
+        changes, the resampler is reset as well.
+
+        @param samplesInPerOutputSample     the number of input samples used for each output
+                                            sample, so a value greater than 1 downsamples
+    */
+    void setResamplingRatio (double samplesInPerOutputSample);
+
+    /** Changes the resampling ratio to convert a stream from one sample rate to another.
+        Whole sample rates give an exact rational ratio.
+    */
+    void setSampleRates (double inputSampleRate, double outputSampleRate);
+
+    /** Returns the number of input samples used for each output sample. */
+    double getResamplingRatio() const noexcept                  { return ratio; }
+
+    /** Returns true if the ratio is a fraction whose phases are all in the table, so that
+        the coefficients don't have to be interpolated.
+    */
+    bool isRatioExact() const noexcept                          { return phaseShift == 0; }
+
+    /** Returns the length of the filter, in input samples. */
+    int getFilterLength() const noexcept                        { return numTaps; }
+
+    //==============================================================================
+    /** Allocates the buffers for a number of channels, and resets the resampler. */
+    void prepare (int numChannels);
+
+    /** Clears the samples kept from the previous calls to process().
+        Call this when there's a break in the continuity of the input stream.
+    */
+    void reset() noexcept;
+
+    /** Continues the stream that another resampler with the same number of channels
+        was processing, so that one whose filter has been designed on another thread
+        can replace it without a break. The samples it had buffered are only kept if
+        both filters have the same length, otherwise this resampler is reset.
+    */
+    void continueFrom (const SincResampler& other) noexcept;
+
+    /** Returns the number of output samples that the next call to process() will
+        produce for a number of input samples, when the number of output samples isn't
+        limited.
+    */
+    int getNumOutputSamples (int numInputSamples) const noexcept;
+
+    /** Returns the number of input samples that the next call to process() needs to
+        produce a number of output samples.
+
+        When upsampling, these input samples can be enough for a few more output samples,
+        so pass the number of output samples to process() as well to stop there.
+    */
+    int getNumInputSamplesNeeded (int numOutputSamples) const noexcept;
+
+    /** Resamples the channels of a stream.
+
+        All the input samples are used, and as many output samples as possible, up to
+        maxNumOutputSamples, are written to the output channels, which must have enough
+        space for the number of samples returned by getNumOutputSamples() or for
+        maxNumOutputSamples. A null output channel isn't computed, but its input channel
+        is still kept for the next calls.
+
+        When the output is limited, the input samples that aren't used yet are kept for
+        the next calls, so there mustn't be much more of them than the number returned
+        by getNumInputSamplesNeeded() for maxNumOutputSamples.
+
+        @returns the number of output samples written to each channel
+    */
+    int process (const float* const* inputChannels, int numInputSamples,
+                 float* const* outputChannels,
+                 int maxNumOutputSamples = std::numeric_limits<int>::max()) noexcept;
+
+    //==============================================================================
+    /** Converts a whole buffer from one sample rate to another, returning a buffer
+        containing the input length divided by the ratio, rounded to the nearest sample.
+    */
+    static AudioBuffer<float> resample (const AudioBuffer<float>& source,
+                                        double inputSampleRate, double outputSampleRate,
+                                        int numZeroCrossings = 32);
+
+private:
+    //==============================================================================
+    void setRatio (double newRatio, int64 numerator, int64 denominator);
+    void createTable();
+    int produceOutputs (float* const* outputChannels, int startSample, int maxNumOutputSamples) noexcept;
+
+    int64 getPositionInPhases() const noexcept;
+    int64 getStepInPhases() const noexcept;
+
+    //==============================================================================
+    double ratio = 1.0;
+    const int numZeroCrossings;
+    int numTaps = 0, numTablePhases = 0, numChannels = 0;
+
+    // the position of the next output sample is readPosition + phase / phaseDenominator
+    // input samples from the start of the history buffer, and the table row of a phase
+    // is phase >> phaseShift
+    int readPosition = 0, numBuffered = 0, stepInSamples = 1;
+    uint32 phase = 0, phaseStep = 0, phaseDenominator = 1, phaseShift = 0;
+
+    HeapBlock<float> table, interpolatedCoefficients;
+    AudioBuffer<float> history;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SincResampler)
+};
+
+} // namespace juce
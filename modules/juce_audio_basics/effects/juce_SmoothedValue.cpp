@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_UNIT_TESTS
+
+class SmoothedValueTests  : public UnitTest
+{
+public:
+    SmoothedValueTests() : UnitTest ("SmoothedValue", "Audio") {}
+
+    void runTest() override
+    {
+        beginTest ("Linear");
+        runTestsForType<ValueSmoothingTypes::Linear>();
+
+        beginTest ("Multiplicative");
+        runTestsForType<ValueSmoothingTypes::Multiplicative>();
+
+        beginTest ("OnePole");
+        runTestsForType<ValueSmoothingTypes::OnePole>();
+
+        beginTest ("LinearSmoothedValue gain");
+        {
+            LinearSmoothedValue<float> a (1.0f), b (1.0f);
+            a.reset (100.0, 1.0);
+            b.reset (100.0, 1.0);
+            a.setValue (0.25f);
+            b.setValue (0.25f);
+
+            AudioBuffer<float> buffer (2, 150);
+            buffer.clear();
+            FloatVectorOperations::fill (buffer.getWritePointer (0), 1.0f, 150);
+            FloatVectorOperations::fill (buffer.getWritePointer (1), 2.0f, 150);
+
+            a.applyGain (buffer, 150);
+
+            for (int i = 0; i < 150; ++i)
+            {
+                auto gain = b.getNextValue();
+                expectWithinAbsoluteError (buffer.getSample (0, i), gain, 1.0e-5f);
+                expectWithinAbsoluteError (buffer.getSample (1, i), 2.0f * gain, 1.0e-5f);
+            }
+
+            expect (! a.isSmoothing());
+        }
+    }
+
+private:
+    template <typename SmoothingType>
+    void runTestsForType()
+    {
+        runTestsForType<float, SmoothingType>  (1.0e-4);
+        runTestsForType<double, SmoothingType> (1.0e-10);
+    }
+
+    template <typename FloatType, typename SmoothingType>
+    void runTestsForType (double tolerance)
+    {
+        const int numSamples = 300, rampLength = 200;
+        auto maxError = static_cast<FloatType> (tolerance);
+
+        SmoothedValue<FloatType, SmoothingType> reference (static_cast<FloatType> (2));
+        reference.reset (rampLength);
+        reference.setValue (static_cast<FloatType> (0.5));
+
+        HeapBlock<FloatType> expected (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            expected[i] = reference.getNextValue();
+
+        expect (! reference.isSmoothing());
+        expectWithinAbsoluteError (expected[rampLength - 1], static_cast<FloatType> (0.5), static_cast<FloatType> (0.002));
+        expectEquals (expected[rampLength], static_cast<FloatType> (0.5));
+        expect (expected[rampLength / 2] < static_cast<FloatType> (2) && expected[rampLength / 2] > static_cast<FloatType> (0.5));
+
+        // the block methods must give the same values as getNextValue(), whatever
+        // the size of the blocks
+        for (auto blockSize : { 1, 7, 64, 150, numSamples })
+        {
+            SmoothedValue<FloatType, SmoothingType> values (static_cast<FloatType> (2)), gain (static_cast<FloatType> (2));
+            values.reset (rampLength);
+            values.setValue (static_cast<FloatType> (0.5));
+            gain.reset (rampLength);
+            gain.setValue (static_cast<FloatType> (0.5));
+
+            HeapBlock<FloatType> block (numSamples), samples (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] = static_cast<FloatType> (i % 3 + 1);
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                auto num = jmin (blockSize, numSamples - start);
+                values.getNextValues (block + start, num);
+                gain.applyGain (samples + start, num);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                expectWithinAbsoluteError (block[i], expected[i], maxError);
+                expectWithinAbsoluteError (samples[i], static_cast<FloatType> (i % 3 + 1) * expected[i], 3 * maxError);
+            }
+        }
+
+        // skipping samples is the same as reading them
+        {
+            SmoothedValue<FloatType, SmoothingType> value (static_cast<FloatType> (2));
+            value.reset (rampLength);
+            value.setValue (static_cast<FloatType> (0.5));
+            value.skip (rampLength / 3);
+
+            expectWithinAbsoluteError (value.getNextValue(), expected[rampLength / 3], maxError);
+        }
+
+        // all the channels of a buffer get the same gain
+        {
+            SmoothedValue<FloatType, SmoothingType> gain (static_cast<FloatType> (2));
+            gain.reset (rampLength);
+            gain.setValue (static_cast<FloatType> (0.5));
+
+            AudioBuffer<FloatType> buffer (3, numSamples);
+
+            for (int channel = 0; channel < 3; ++channel)
+                FloatVectorOperations::fill (buffer.getWritePointer (channel), static_cast<FloatType> (channel + 1), numSamples);
+
+            gain.applyGain (buffer, numSamples);
+
+            for (int channel = 0; channel < 3; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (buffer.getSample (channel, i), static_cast<FloatType> (channel + 1) * expected[i], 3 * maxError);
+        }
+    }
+};
+
+static SmoothedValueTests smoothedValueTests;
+
+#endif // JUCE_UNIT_TESTS
+
+} // namespace juce
@@ -0,0 +1,336 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    The types of smoothing which can be used by the SmoothedValue class.
+
+    @see SmoothedValue
+
+    @tags{Audio}
+*/
+namespace ValueSmoothingTypes
+{
+    /** The value changes by the same amount at every sample. */
+    struct Linear {};
+
+    /** The value is multiplied by the same amount at every sample, which is better
+        suited to frequencies and gains. The current and target values must be
+        non-zero and have the same sign.
+    */
+    struct Multiplicative {};
+
+    /** The value follows a one-pole lowpass filter, moving quickly at first and
+        then more and more slowly towards the target, which it reaches at the end
+        of the ramp when it's within 0.1% of the change.
+    */
+    struct OnePole {};
+}
+
+//==============================================================================
+/**
+    Smooths the changes of a value, like a gain or a frequency, so that they
+    happen over a ramp rather than abruptly, to avoid audio glitches.
+
+    Unlike LinearSmoothedValue, the values of the ramp can be computed for a whole
+    block at once with getNextValues(), and applied to blocks of samples with the
+    applyGain() methods, which all use the vectorised functions of
+    FloatVectorOperations rather than computing the values one by one.
+
+    @code
+    SmoothedValue<float, ValueSmoothingTypes::Multiplicative> gain (1.0f);
+    gain.reset (sampleRate, 0.05);
+    gain.setValue (0.5f);
+    gain.applyGain (buffer, buffer.getNumSamples());
+    @endcode
+
+    @see LinearSmoothedValue, ValueSmoothingTypes
+
+    @tags{Audio}
+*/
+template <typename FloatType, typename SmoothingType = ValueSmoothingTypes::Linear>
+class SmoothedValue
+{
+public:
+    /** Constructor. */
+    SmoothedValue() noexcept
+        : SmoothedValue (std::is_same<SmoothingType, ValueSmoothingTypes::Multiplicative>::value ? 1 : 0)
+    {
+    }
+
+    /** Constructor. */
+    SmoothedValue (FloatType initialValue) noexcept
+        : currentValue (initialValue), target (initialValue)
+    {
+        // multiplicative smoothing can't start from zero
+        jassert (! (std::is_same<SmoothingType, ValueSmoothingTypes::Multiplicative>::value && initialValue == 0));
+    }
+
+    //==============================================================================
+    /** Reset to a new sample rate and ramp length.
+        @param sampleRate The sampling rate
+        @param rampLengthInSeconds The duration of the ramp in seconds
+    */
+    void reset (double sampleRate, double rampLengthInSeconds) noexcept
+    {
+        jassert (sampleRate > 0 && rampLengthInSeconds >= 0);
+        reset ((int) std::floor (rampLengthInSeconds * sampleRate));
+    }
+
+    /** Reset to a new ramp length, in samples. */
+    void reset (int numSteps) noexcept
+    {
+        stepsToTarget = jmax (0, numSteps);
+        currentValue = target;
+        countdown = 0;
+
+        // after stepsToTarget steps of the one-pole filter, the value is within 0.1% of the change
+        coefficient = stepsToTarget > 0 ? static_cast<FloatType> (std::pow (0.001, 1.0 / stepsToTarget)) : 0;
+    }
+
+    //==============================================================================
+    /** Set a new target value.
+
+        @param newValue     The new target value
+        @param force        If true, the value will be set immediately, bypassing the ramp
+    */
+    void setValue (FloatType newValue, bool force = false) noexcept
+    {
+        jassert (! (std::is_same<SmoothingType, ValueSmoothingTypes::Multiplicative>::value && newValue == 0));
+
+        if (force)
+        {
+            target = currentValue = newValue;
+            countdown = 0;
+            return;
+        }
+
+        if (target != newValue)
+        {
+            target = newValue;
+            countdown = stepsToTarget;
+
+            if (countdown <= 0)
+                currentValue = target;
+            else
+                setStep (SmoothingType());
+        }
+    }
+
+    //==============================================================================
+    /** Compute the next value.
+        @returns Smoothed value
+    */
+    FloatType getNextValue() noexcept
+    {
+        if (countdown <= 0)
+            return target;
+
+        --countdown;
+        auto value = getValueAfterOneStep (SmoothingType());
+        currentValue = countdown > 0 ? value : target;
+        return value;
+    }
+
+    /** Computes the next values for a whole block, which is the same as calling
+        getNextValue() for each one of them.
+        @param values       A pointer to a raw array of values to fill
+        @param numValues    The number of values to compute
+    */
+    void getNextValues (FloatType* values, int numValues) noexcept
+    {
+        jassert (numValues >= 0);
+
+        auto numRamp = jmin (numValues, countdown);
+
+        if (numRamp > 0)
+        {
+            FloatVectorOperations::fill (values, 1, numRamp);
+            applyRamp (values, values, numRamp, SmoothingType());
+        }
+
+        FloatVectorOperations::fill (values + numRamp, target, numValues - numRamp);
+        skip (numValues);
+    }
+
+    /** Returns true if the current value is currently being interpolated. */
+    bool isSmoothing() const noexcept
+    {
+        return countdown > 0;
+    }
+
+    /** Returns the current value of the ramp. */
+    FloatType getCurrentValue() const noexcept
+    {
+        return currentValue;
+    }
+
+    /** Returns the target value towards which the smoothed value is currently moving. */
+    FloatType getTargetValue() const noexcept
+    {
+        return target;
+    }
+
+    //==============================================================================
+    /** Applies a smoothed gain to a stream of samples
+        S[i] *= gain
+        @param samples Pointer to a raw array of samples
+        @param numSamples Length of array of samples
+    */
+    void applyGain (FloatType* samples, int numSamples) noexcept
+    {
+        applyGain (samples, samples, numSamples);
+    }
+
+    /** Computes output as smoothed gain applied to a stream of samples.
+        Sout[i] = Sin[i] * gain
+        @param samplesOut A pointer to a raw array of output samples
+        @param samplesIn  A pointer to a raw array of input samples
+        @param numSamples The length of the array of samples
+    */
+    void applyGain (FloatType* samplesOut, const FloatType* samplesIn, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        applyGainWithoutSkipping (samplesOut, samplesIn, numSamples);
+        skip (numSamples);
+    }
+
+    /** Applies a smoothed gain to all the channels of a buffer */
+    void applyGain (AudioBuffer<FloatType>& buffer, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0 && numSamples <= buffer.getNumSamples());
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* samples = buffer.getWritePointer (channel);
+            applyGainWithoutSkipping (samples, samples, numSamples);
+        }
+
+        skip (numSamples);
+    }
+
+    //==============================================================================
+    /** Skip the next numSamples samples.
+
+        This is identical to calling getNextValue numSamples times.
+        @see getNextValue
+    */
+    void skip (int numSamples) noexcept
+    {
+        if (numSamples >= countdown)
+        {
+            currentValue = target;
+            countdown = 0;
+        }
+        else if (numSamples > 0)
+        {
+            currentValue = getValueAfter (numSamples, SmoothingType());
+            countdown -= numSamples;
+        }
+    }
+
+private:
+    //==============================================================================
+    void setStep (ValueSmoothingTypes::Linear) noexcept
+    {
+        step = (target - currentValue) / (FloatType) countdown;
+    }
+
+    void setStep (ValueSmoothingTypes::Multiplicative) noexcept
+    {
+        jassert (currentValue != 0 && (target > 0) == (currentValue > 0));
+        step = std::exp (std::log (target / currentValue) / (FloatType) countdown);
+    }
+
+    void setStep (ValueSmoothingTypes::OnePole) noexcept {}
+
+    FloatType getValueAfterOneStep (ValueSmoothingTypes::Linear) const noexcept            { return currentValue + step; }
+    FloatType getValueAfterOneStep (ValueSmoothingTypes::Multiplicative) const noexcept    { return currentValue * step; }
+    FloatType getValueAfterOneStep (ValueSmoothingTypes::OnePole) const noexcept           { return target + (currentValue - target) * coefficient; }
+
+    FloatType getValueAfter (int numSteps, ValueSmoothingTypes::Linear) const noexcept
+    {
+        return currentValue + step * (FloatType) numSteps;
+    }
+
+    FloatType getValueAfter (int numSteps, ValueSmoothingTypes::Multiplicative) const noexcept
+    {
+        return currentValue * std::pow (step, (FloatType) numSteps);
+    }
+
+    FloatType getValueAfter (int numSteps, ValueSmoothingTypes::OnePole) const noexcept
+    {
+        return target + (currentValue - target) * std::pow (coefficient, (FloatType) numSteps);
+    }
+
+    //==============================================================================
+    // Multiplies the source values by the next values of the ramp, which must not
+    // go beyond its end
+    void applyRamp (FloatType* dest, const FloatType* src, int num, ValueSmoothingTypes::Linear) const noexcept
+    {
+        FloatVectorOperations::copyWithRamp (dest, src, currentValue + step, step, num);
+    }
+
+    void applyRamp (FloatType* dest, const FloatType* src, int num, ValueSmoothingTypes::Multiplicative) const noexcept
+    {
+        FloatVectorOperations::copyWithExponentialRamp (dest, src, currentValue * step, step, num);
+    }
+
+    void applyRamp (FloatType* dest, const FloatType* src, int num, ValueSmoothingTypes::OnePole) const noexcept
+    {
+        // the gain is the target plus an exponentially decaying difference, which
+        // is computed in chunks so that the source can be the destination
+        const int maxChunkSize = 256;
+        FloatType gains[maxChunkSize];
+
+        for (int start = 0; start < num; start += maxChunkSize)
+        {
+            auto chunkSize = jmin (maxChunkSize, num - start);
+            auto difference = (currentValue - target) * std::pow (coefficient, (FloatType) (start + 1));
+
+            FloatVectorOperations::fill (gains, 1, chunkSize);
+            FloatVectorOperations::multiplyWithExponentialRamp (gains, difference, coefficient, chunkSize);
+            FloatVectorOperations::add (gains, target, chunkSize);
+            FloatVectorOperations::multiply (dest + start, src + start, gains, chunkSize);
+        }
+    }
+
+    void applyGainWithoutSkipping (FloatType* samplesOut, const FloatType* samplesIn, int numSamples) const noexcept
+    {
+        auto numRamp = jmin (numSamples, countdown);
+
+        if (numRamp > 0)
+            applyRamp (samplesOut, samplesIn, numRamp, SmoothingType());
+
+        FloatVectorOperations::multiply (samplesOut + numRamp, samplesIn + numRamp, target, numSamples - numRamp);
+    }
+
+    //==============================================================================
+    FloatType currentValue = 0, target = 0, step = 0, coefficient = 0;
+    int countdown = 0, stepsToTarget = 0;
+};
+
+} // namespace juce
@@ -68,6 +68,18 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+// The AVX, FMA and AVX-512 code paths are compiled for their own target within
+// the same binary, and are only used when the CPU running it supports them
+#if JUCE_USE_SSE_INTRINSICS && ! defined (JUCE_USE_AVX_INTRINSICS)
+ #if (JUCE_MSVC && _MSC_VER >= 1910) || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5)
+  #define JUCE_USE_AVX_INTRINSICS 1
+ #endif
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -88,14 +100,19 @@
 #include "effects/juce_IIRFilter.h"
 #include "effects/juce_LagrangeInterpolator.h"
 #include "effects/juce_CatmullRomInterpolator.h"
+#include "effects/juce_SincResampler.h"
 #include "effects/juce_LinearSmoothedValue.h"
+#include "effects/juce_SmoothedValue.h"
 #include "effects/juce_Reverb.h"
 #include "midi/juce_MidiMessage.h"
+#include "midi/juce_MidiMessageView.h"
 #include "midi/juce_MidiBuffer.h"
+#include "midi/juce_MidiEventList.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "midi/juce_MidiRPN.h"
+#include "synthesisers/juce_RenderingThreadPool.h"
 #include "mpe/juce_MPEValue.h"
 #include "mpe/juce_MPENote.h"
 #include "mpe/juce_MPEZoneLayout.h"
@@ -113,6 +130,7 @@
 #include "sources/juce_MemoryAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
+#include "sources/juce_SincResamplingAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
 #include "synthesisers/juce_Synthesiser.h"
@@ -105,7 +105,7 @@ void MidiBuffer::clear (const int startSample, const int numSamples)
     uint8* const start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     uint8* const end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - data.begin()));
+    data.removeRange ((int) (start - data.begin()), (int) (end - start));
 }
 
 void MidiBuffer::addEvent (const MidiMessage& m, const int sampleNumber)
@@ -183,6 +183,11 @@ int MidiBuffer::getLastEventTime() const noexcept
     }
 }
 
+MidiBufferIterator MidiBuffer::findNextSamplePosition (const int samplePosition) const noexcept
+{
+    return MidiBufferIterator (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), samplePosition - 1));
+}
+
 //==============================================================================
 MidiBuffer::Iterator::Iterator (const MidiBuffer& b) noexcept
     : buffer (b), data (b.data.begin())
@@ -227,4 +232,135 @@ bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePositio
     return true;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiBufferTests  : public UnitTest
+{
+    MidiBufferTests() : UnitTest ("MidiBuffer", "Audio") {}
+
+    void runTest() override
+    {
+        beginTest ("Range-based iteration");
+        {
+            MidiBuffer buffer;
+            expect (buffer.begin() == buffer.end());
+
+            const uint8 sysExData[] = { 1, 2, 3, 4, 5 };
+
+            buffer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 10);
+            buffer.addEvent (MidiMessage::controllerEvent (2, 7, 64), 5);
+            buffer.addEvent (MidiMessage::createSysExMessage (sysExData, 5), 20);
+            buffer.addEvent (MidiMessage::noteOff (1, 60), 10);
+
+            MidiBuffer::Iterator iterator (buffer);
+            MidiMessage message;
+            int position, numEvents = 0;
+
+            for (auto event : buffer)
+            {
+                expect (iterator.getNextEvent (message, position));
+                expectEquals (event.samplePosition, position);
+                expectEquals (event.numBytes, message.getRawDataSize());
+                expect (memcmp (event.data, message.getRawData(), (size_t) event.numBytes) == 0);
+                expect (event.getMessage().getTimeStamp() == position);
+                ++numEvents;
+            }
+
+            expect (! iterator.getNextEvent (message, position));
+            expectEquals (numEvents, buffer.getNumEvents());
+
+            auto first = *buffer.begin();
+            expect (first.isController());
+            expectEquals (first.getChannel(), 2);
+            expectEquals (first.getControllerNumber(), 7);
+            expectEquals (first.getControllerValue(), 64);
+
+            auto sysEx = *buffer.findNextSamplePosition (11);
+            expect (sysEx.isSysEx());
+            expectEquals (sysEx.getSysExDataSize(), 5);
+            expect (memcmp (sysEx.getSysExData(), sysExData, 5) == 0);
+            expect (! sysEx.isNoteOn() && ! sysEx.isNoteOff());
+        }
+
+        beginTest ("Finding sample positions");
+        {
+            MidiBuffer buffer;
+
+            for (int i = 0; i < 10; ++i)
+                buffer.addEvent (MidiMessage::noteOn (1, 60 + i, (uint8) 100), i * 10);
+
+            expect (buffer.findNextSamplePosition (-5) == buffer.begin());
+            expect (buffer.findNextSamplePosition (0) == buffer.begin());
+            expect (buffer.findNextSamplePosition (91) == buffer.end());
+
+            expectEquals ((*buffer.findNextSamplePosition (30)).samplePosition, 30);
+            expectEquals ((*buffer.findNextSamplePosition (31)).samplePosition, 40);
+            expectEquals ((*buffer.findNextSamplePosition (90)).getNoteNumber(), 69);
+
+            int numEvents = 0;
+
+            for (auto i = buffer.findNextSamplePosition (45); i != buffer.end(); ++i)
+            {
+                expect ((*i).samplePosition >= 45);
+                ++numEvents;
+            }
+
+            expectEquals (numEvents, 5);
+        }
+
+        beginTest ("Note events in views");
+        {
+            MidiBuffer buffer;
+            buffer.addEvent (MidiMessage::noteOn (3, 64, (uint8) 90), 0);
+            buffer.addEvent (MidiMessage::noteOn (3, 64, (uint8) 0), 1);
+            buffer.addEvent (MidiMessage::noteOff (3, 64, (uint8) 20), 2);
+
+            auto i = buffer.begin();
+            auto noteOn = *i;
+            auto noteOnVelocity0 = *++i;
+            auto noteOff = *++i;
+
+            expect (noteOn.isNoteOn() && ! noteOn.isNoteOff() && noteOn.isNoteOnOrOff());
+            expectEquals ((int) noteOn.getVelocity(), 90);
+            expectEquals (noteOn.getChannel(), 3);
+            expect (noteOn.isForChannel (3) && ! noteOn.isForChannel (4));
+
+            expect (! noteOnVelocity0.isNoteOn() && noteOnVelocity0.isNoteOn (true));
+            expect (noteOnVelocity0.isNoteOff() && ! noteOnVelocity0.isNoteOff (false));
+
+            expect (noteOff.isNoteOff() && noteOff.isNoteOff (false) && ! noteOff.isNoteOn (true));
+            expectEquals ((int) noteOff.getVelocity(), 20);
+        }
+
+        beginTest ("Truncated note events in views");
+        {
+            // the third byte is outside the event, so it must not be read
+            const uint8 noteOn[] = { 0x90, 60, 0 };
+            const uint8 noteOff[] = { 0x80, 60, 0 };
+
+            MidiBuffer buffer;
+            buffer.addEvent (noteOn, 2, 0);
+            buffer.addEvent (noteOff, 2, 1);
+            buffer.addEvent (noteOn, 1, 2);
+
+            expectEquals (buffer.getNumEvents(), 3);
+
+            for (auto event : buffer)
+            {
+                expect (event.numBytes < 3);
+                expect (! event.isNoteOn (true));
+                expect (! event.isNoteOff (true));
+                expect (! event.isNoteOnOrOff());
+                expectEquals ((int) event.getVelocity(), 0);
+            }
+        }
+    }
+};
+
+static MidiBufferTests midiBufferTests;
+
+#endif
+
 } // namespace juce
@@ -23,6 +23,47 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    Iterates through the events of a MidiBuffer in a range-based for loop, giving
+    a MidiMessageView of each event which points into the buffer's data.
+
+    Note that altering the buffer while an iterator is using it will produce
+    undefined behaviour.
+
+    @see MidiBuffer
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiBufferIterator
+{
+public:
+    /** Creates an iterator pointing to the header of an event in a MidiBuffer's data. */
+    explicit MidiBufferIterator (const uint8* eventData) noexcept  : data (eventData) {}
+
+    /** Returns a view of the current event. */
+    MidiMessageView operator*() const noexcept
+    {
+        return { data + headerSize, (int) readUnaligned<uint16> (data + sizeof (int32)), readUnaligned<int32> (data) };
+    }
+
+    /** Moves to the next event. */
+    MidiBufferIterator& operator++() noexcept
+    {
+        data += headerSize + readUnaligned<uint16> (data + sizeof (int32));
+        return *this;
+    }
+
+    bool operator== (const MidiBufferIterator& other) const noexcept    { return data == other.data; }
+    bool operator!= (const MidiBufferIterator& other) const noexcept    { return data != other.data; }
+
+private:
+    // each event starts with its sample position and its size
+    enum { headerSize = sizeof (int32) + sizeof (uint16) };
+
+    const uint8* data;
+};
+
 //==============================================================================
 /**
     Holds a sequence of time-stamped midi events.
@@ -91,7 +132,7 @@ public:
         If an event is added whose sample position is the same as one or more events
         already in the buffer, the new event will be placed after the existing ones.
 
-        To retrieve events, use a MidiBuffer::Iterator object
+        To retrieve events, use a range-based for loop or a MidiBuffer::Iterator object
     */
     void addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
@@ -158,6 +199,27 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    //==============================================================================
+    /** Returns an iterator to the first event, for use in range-based for loops.
+
+        @code
+        for (auto event : midiBuffer)
+            if (event.isController())
+                handleController (event.samplePosition, event.getControllerNumber(), event.getControllerValue());
+        @endcode
+
+        @see MidiMessageView
+    */
+    MidiBufferIterator begin() const noexcept                       { return MidiBufferIterator (data.begin()); }
+
+    /** Returns an iterator to the end of the buffer. */
+    MidiBufferIterator end() const noexcept                         { return MidiBufferIterator (data.end()); }
+
+    /** Returns an iterator to the first event whose sample position is greater than or
+        equal to the given position.
+    */
+    MidiBufferIterator findNextSamplePosition (int samplePosition) const noexcept;
+
     //==============================================================================
     /**
         Used to iterate through the events in a MidiBuffer.
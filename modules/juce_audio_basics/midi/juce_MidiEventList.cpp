@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+MidiEventList::MidiEventList() noexcept {}
+MidiEventList::~MidiEventList() {}
+
+MidiEventList::MidiEventList (const MidiBuffer& buffer)
+{
+    MidiBuffer::Iterator i (buffer);
+
+    const uint8* eventData;
+    int eventSize, position;
+
+    while (i.getNextEvent (eventData, eventSize, position))
+        addEvent (eventData, eventSize, position);
+}
+
+void MidiEventList::clear() noexcept
+{
+    events.clearQuick();
+    longEventData.clearQuick();
+}
+
+void MidiEventList::clear (const int startSample, const int numSamples)
+{
+    auto start = findIndexAfter (startSample - 1);
+    auto end   = findIndexAfter (startSample + numSamples - 1);
+
+    events.removeRange (start, end - start);
+}
+
+int MidiEventList::findIndexAfter (const int samplePosition) const noexcept
+{
+    auto* slot = std::upper_bound (events.begin(), events.end(), samplePosition,
+                                   [] (int position, const Slot& s) { return position < s.samplePosition; });
+
+    return (int) (slot - events.begin());
+}
+
+MidiEventList::Slot MidiEventList::createSlot (const uint8* data, const int numBytes, const int samplePosition)
+{
+    Slot slot;
+    slot.samplePosition = samplePosition;
+    slot.numBytes = (uint32) numBytes;
+
+    if (numBytes <= maxBytesInSlot)
+    {
+        memcpy (slot.bytes, data, (size_t) numBytes);
+    }
+    else
+    {
+        slot.offset = (uint32) longEventData.size();
+        longEventData.addArray (data, numBytes);
+    }
+
+    return slot;
+}
+
+//==============================================================================
+void MidiEventList::addEvent (const MidiMessage& m, const int sampleNumber)
+{
+    addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+}
+
+void MidiEventList::addEvent (const void* const newData, const int maxBytes, const int sampleNumber)
+{
+    auto* data = static_cast<const uint8*> (newData);
+    auto numBytes = MidiBufferHelpers::findActualEventLength (data, maxBytes);
+
+    if (numBytes > 0)
+    {
+        auto slot = createSlot (data, numBytes, sampleNumber);
+
+        if (events.isEmpty() || sampleNumber >= (events.end() - 1)->samplePosition)
+            events.add (slot);
+        else
+            events.insert (findIndexAfter (sampleNumber), slot);
+    }
+}
+
+void MidiEventList::addEvents (const MidiBuffer& otherBuffer,
+                               const int startSample,
+                               const int numSamples,
+                               const int sampleDeltaToAdd)
+{
+    MidiBuffer::Iterator i (otherBuffer);
+    i.setNextSamplePosition (startSample);
+
+    const uint8* eventData;
+    int eventSize, position;
+
+    while (i.getNextEvent (eventData, eventSize, position)
+            && (position < startSample + numSamples || numSamples < 0))
+    {
+        addEvent (eventData, eventSize, position + sampleDeltaToAdd);
+    }
+}
+
+void MidiEventList::addEvents (const MidiEventList& otherList,
+                               const int startSample,
+                               const int numSamples,
+                               const int sampleDeltaToAdd)
+{
+    // can't add a list to itself!
+    jassert (&otherList != this);
+
+    auto first = otherList.findIndexAfter (startSample - 1);
+    auto last  = numSamples < 0 ? otherList.events.size()
+                                : otherList.findIndexAfter (startSample + numSamples - 1);
+
+    if (last <= first)
+        return;
+
+    auto numExisting = events.size();
+    auto numToAdd = last - first;
+    events.resize (numExisting + numToAdd);
+
+    auto* slots = events.begin();
+    auto* newSlots = otherList.events.begin() + first;
+
+    // the lists are merged from their ends, the new events being placed after
+    // the existing ones which have the same position
+    for (int i = numExisting - 1, j = numToAdd - 1, k = numExisting + numToAdd - 1; j >= 0; --k)
+    {
+        auto position = newSlots[j].samplePosition + sampleDeltaToAdd;
+
+        if (i >= 0 && slots[i].samplePosition > position)
+        {
+            slots[k] = slots[i--];
+        }
+        else
+        {
+            auto event = *Iterator (newSlots + j--, otherList.longEventData.begin());
+            slots[k] = createSlot (event.data, event.numBytes, position);
+        }
+    }
+}
+
+void MidiEventList::copyTo (MidiBuffer& destination) const
+{
+    const int headerSize = sizeof (int32) + sizeof (uint16);
+    int totalSize = 0;
+
+    for (auto& slot : events)
+        totalSize += headerSize + (int) slot.numBytes;
+
+    destination.data.clearQuick();
+    destination.data.resize (totalSize);
+
+    auto* d = destination.data.begin();
+
+    for (auto event : *this)
+    {
+        writeUnaligned<int32>  (d, event.samplePosition);
+        writeUnaligned<uint16> (d + 4, static_cast<uint16> (event.numBytes));
+        memcpy (d + headerSize, event.data, (size_t) event.numBytes);
+        d += headerSize + event.numBytes;
+    }
+}
+
+int MidiEventList::getFirstEventTime() const noexcept
+{
+    return events.isEmpty() ? 0 : events.begin()->samplePosition;
+}
+
+int MidiEventList::getLastEventTime() const noexcept
+{
+    return events.isEmpty() ? 0 : (events.end() - 1)->samplePosition;
+}
+
+//==============================================================================
+void MidiEventList::swapWith (MidiEventList& other) noexcept
+{
+    events.swapWith (other.events);
+    longEventData.swapWith (other.longEventData);
+}
+
+void MidiEventList::ensureSize (const int numEvents, const int numBytesOfLongEvents)
+{
+    events.ensureStorageAllocated (numEvents);
+    longEventData.ensureStorageAllocated (numBytesOfLongEvents);
+}
+
+//==============================================================================
+MidiMessageView MidiEventList::Iterator::operator*() const noexcept
+{
+    return { slot->numBytes <= maxBytesInSlot ? slot->bytes : longEventData + slot->offset,
+             (int) slot->numBytes, slot->samplePosition };
+}
+
+MidiEventList::Iterator MidiEventList::begin() const noexcept
+{
+    return { events.begin(), longEventData.begin() };
+}
+
+MidiEventList::Iterator MidiEventList::end() const noexcept
+{
+    return { events.end(), longEventData.begin() };
+}
+
+MidiEventList::Iterator MidiEventList::findNextSamplePosition (const int samplePosition) const noexcept
+{
+    return { events.begin() + findIndexAfter (samplePosition - 1), longEventData.begin() };
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiEventListTests  : public UnitTest
+{
+    MidiEventListTests() : UnitTest ("MidiEventList", "Audio") {}
+
+    static bool isSameAsBuffer (const MidiEventList& list, const MidiBuffer& buffer)
+    {
+        MidiBuffer::Iterator i (buffer);
+        const uint8* data;
+        int numBytes, position;
+
+        for (auto event : list)
+            if (! i.getNextEvent (data, numBytes, position)
+                 || position != event.samplePosition
+                 || numBytes != event.numBytes
+                 || memcmp (data, event.data, (size_t) numBytes) != 0)
+                return false;
+
+        return ! i.getNextEvent (data, numBytes, position);
+    }
+
+    static MidiMessage createRandomMessage (Random& r)
+    {
+        if (r.nextInt (8) == 0)
+        {
+            uint8 data[40];
+
+            for (auto& d : data)
+                d = (uint8) r.nextInt (128);
+
+            return MidiMessage::createSysExMessage (data, 1 + r.nextInt (40));
+        }
+
+        return MidiMessage::pitchWheel (1 + r.nextInt (16), r.nextInt (16384));
+    }
+
+    void runTest() override
+    {
+        Random r (getRandom());
+
+        beginTest ("Adding events");
+        {
+            MidiEventList list;
+            MidiBuffer buffer;
+
+            for (int i = 0; i < 500; ++i)
+            {
+                // mostly in time order, sometimes before the last event
+                auto position = i + (r.nextInt (4) == 0 ? -r.nextInt (20) : 0);
+                auto message = createRandomMessage (r);
+
+                list.addEvent (message, position);
+                buffer.addEvent (message, position);
+            }
+
+            expectEquals (list.getNumEvents(), buffer.getNumEvents());
+            expectEquals (list.getFirstEventTime(), buffer.getFirstEventTime());
+            expectEquals (list.getLastEventTime(), buffer.getLastEventTime());
+            expect (isSameAsBuffer (list, buffer));
+
+            MidiBuffer copy;
+            list.copyTo (copy);
+            expect (copy.data == buffer.data);
+
+            expect (isSameAsBuffer (MidiEventList (buffer), buffer));
+
+            auto event = *list.findNextSamplePosition (100);
+            expect (event.samplePosition >= 100);
+            expect (event.getMessage().getTimeStamp() == event.samplePosition);
+
+            list.clear (100, 200);
+            buffer.clear (100, 200);
+            expect (isSameAsBuffer (list, buffer));
+        }
+
+        beginTest ("Merging lists");
+        {
+            for (int test = 0; test < 20; ++test)
+            {
+                MidiEventList list, other;
+                MidiBuffer buffer, otherBuffer;
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    auto message = createRandomMessage (r);
+                    auto position = r.nextInt (300);
+                    list.addEvent (message, position);
+                    buffer.addEvent (message, position);
+
+                    message = createRandomMessage (r);
+                    position = r.nextInt (300);
+                    other.addEvent (message, position);
+                    otherBuffer.addEvent (message, position);
+                }
+
+                auto start = r.nextInt (200), numSamples = r.nextInt (200) - 20, delta = r.nextInt (100) - 50;
+                list.addEvents (other, start, numSamples, delta);
+                buffer.addEvents (otherBuffer, start, numSamples, delta);
+
+                expect (isSameAsBuffer (list, buffer));
+            }
+        }
+    }
+};
+
+static MidiEventListTests midiEventListTests;
+
+#endif
+
+} // namespace juce
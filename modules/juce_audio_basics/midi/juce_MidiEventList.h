@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a sequence of time-stamped midi events, like a MidiBuffer, in a layout
+    which is faster to fill and to read for buffers containing many events.
+
+    Each event is stored in a fixed-size slot holding its sample position and, for
+    the short messages which make up nearly all midi streams, its data. The data of
+    the longer events, such as SysEx messages, is stored in a separate block which is
+    only emptied by clear().
+
+    Adding an event whose sample position isn't before the position of the last one
+    just appends it, so filling the list in time order takes constant time per event,
+    and finding the events at a given position uses a binary search. The events can
+    be read with a range-based for loop, which gives a MidiMessageView of each one:
+
+    @code
+    for (auto event : eventList)
+        if (event.isPitchWheel())
+            handlePitchWheel (event.samplePosition, event.getPitchWheelValue());
+    @endcode
+
+    @see MidiBuffer, MidiMessageView
+
+    @tags{Audio}
+*/
+class JUCE_API  MidiEventList
+{
+    struct Slot;
+
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    MidiEventList() noexcept;
+
+    /** Creates a list containing the events of a MidiBuffer. */
+    explicit MidiEventList (const MidiBuffer&);
+
+    /** Destructor. */
+    ~MidiEventList();
+
+    //==============================================================================
+    /** Removes all the events from the list, keeping the allocated memory. */
+    void clear() noexcept;
+
+    /** Removes all events between two times from the list.
+
+        All events for which (start <= event position < start + numSamples) will be
+        removed. The data of the long events removed is only freed by clear().
+    */
+    void clear (int start, int numSamples);
+
+    /** Returns true if the list is empty. */
+    bool isEmpty() const noexcept                                   { return events.isEmpty(); }
+
+    /** Returns the number of events in the list. */
+    int getNumEvents() const noexcept                               { return events.size(); }
+
+    /** Adds an event to the list.
+
+        If an event is added whose sample position is the same as one or more events
+        already in the list, the new event will be placed after the existing ones. The
+        MidiMessage's timestamp is ignored.
+    */
+    void addEvent (const MidiMessage& midiMessage, int sampleNumber);
+
+    /** Adds an event to the list from raw midi data.
+
+        As with MidiBuffer::addEvent(), the data is inspected to find the number of bytes
+        that the event really takes up, and invalid data isn't added.
+    */
+    void addEvent (const void* rawMidiData, int maxBytesOfMidiData, int sampleNumber);
+
+    /** Adds the events of a MidiBuffer between two sample positions to the list.
+        @see MidiBuffer::addEvents
+    */
+    void addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd);
+
+    /** Adds the events of another list between two sample positions to this one.
+
+        The two lists are merged in a single pass, so this takes a time proportional to
+        the number of events of both lists rather than inserting the events one by one.
+        @see MidiBuffer::addEvents
+    */
+    void addEvents (const MidiEventList& otherList, int startSample, int numSamples, int sampleDeltaToAdd);
+
+    /** Replaces the content of a MidiBuffer with the events of the list.
+        If the MidiBuffer has enough memory allocated, this doesn't allocate anything.
+    */
+    void copyTo (MidiBuffer& destination) const;
+
+    /** Returns the sample number of the first event in the list.
+        If the list's empty, this will just return 0.
+    */
+    int getFirstEventTime() const noexcept;
+
+    /** Returns the sample number of the last event in the list.
+        If the list's empty, this will just return 0.
+    */
+    int getLastEventTime() const noexcept;
+
+    //==============================================================================
+    /** Exchanges the contents of this list with another one, without allocating. */
+    void swapWith (MidiEventList&) noexcept;
+
+    /** Preallocates the memory for a number of events, and for the data of the events
+        which don't fit in the slots.
+    */
+    void ensureSize (int numEvents, int numBytesOfLongEvents = 0);
+
+    //==============================================================================
+    /** Iterates through the events of a MidiEventList, giving a MidiMessageView of each
+        event which is only valid until the list is altered.
+    */
+    class Iterator
+    {
+    public:
+        MidiMessageView operator*() const noexcept;
+        Iterator& operator++() noexcept                             { ++slot; return *this; }
+        bool operator== (const Iterator& other) const noexcept      { return slot == other.slot; }
+        bool operator!= (const Iterator& other) const noexcept      { return slot != other.slot; }
+
+    private:
+        friend class MidiEventList;
+        Iterator (const Slot* s, const uint8* d) noexcept  : slot (s), longEventData (d) {}
+
+        const Slot* slot;
+        const uint8* longEventData;
+    };
+
+    /** Returns an iterator to the first event. */
+    Iterator begin() const noexcept;
+
+    /** Returns an iterator to the end of the list. */
+    Iterator end() const noexcept;
+
+    /** Returns an iterator to the first event whose sample position is greater than or
+        equal to the given position.
+    */
+    Iterator findNextSamplePosition (int samplePosition) const noexcept;
+
+private:
+    //==============================================================================
+    // the events whose data doesn't fit in a slot store the offset of their data
+    // in the longEventData block instead
+    enum { maxBytesInSlot = 8 };
+
+    struct Slot
+    {
+        int32 samplePosition;
+        uint32 numBytes;
+
+        union
+        {
+            uint8 bytes[maxBytesInSlot];
+            uint32 offset;
+        };
+    };
+
+    int findIndexAfter (int samplePosition) const noexcept;
+    Slot createSlot (const uint8* data, int numBytes, int samplePosition);
+
+    Array<Slot> events;
+    Array<uint8> longEventData;
+
+    JUCE_LEAK_DETECTOR (MidiEventList)
+};
+
+} // namespace juce
@@ -34,6 +34,103 @@ namespace MidiHelpers
     {
         return (uint8) jlimit (0, 127, v);
     }
+
+    //==============================================================================
+    // A pool of fixed-size blocks for the data of the messages which doesn't fit inside
+    // them. The free blocks are kept in a linked list whose head holds the index of the
+    // first block plus one in its low 32 bits, and a counter incremented by each change
+    // in its high bits, so that a thread can't swap in a stale head. Its memory is never
+    // freed, because static messages may outlive it.
+    struct DataPool
+    {
+        bool initialise (int newNumBlocks, int newBlockSize)
+        {
+            jassert (newNumBlocks > 0 && newBlockSize > (int) sizeof (uint8*));
+
+            if (isInitialised.exchange (true))
+                return false;
+
+            numBlocks = newNumBlocks;
+            blockSize = newBlockSize;
+            nextFreeBlocks = new std::atomic<uint32>[(size_t) numBlocks];
+
+            for (int i = 0; i < numBlocks; ++i)
+                nextFreeBlocks[i] = (uint32) (i + 1 < numBlocks ? i + 2 : 0);
+
+            freeList = 1;
+            blocks.store (static_cast<uint8*> (std::malloc ((size_t) numBlocks * (size_t) blockSize)));
+            return true;
+        }
+
+        uint8* allocate (int numBytes) noexcept
+        {
+            auto* data = blocks.load();
+
+            if (data == nullptr || numBytes > blockSize)
+                return nullptr;
+
+            auto head = freeList.load();
+
+            for (;;)
+            {
+                auto index = (uint32) head;
+
+                if (index == 0)
+                    return nullptr;
+
+                auto newHead = (((head >> 32) + 1) << 32) | nextFreeBlocks[index - 1].load();
+
+                if (freeList.compare_exchange_weak (head, newHead))
+                    return data + (size_t) (index - 1) * (size_t) blockSize;
+            }
+        }
+
+        bool release (uint8* block) noexcept
+        {
+            auto* data = blocks.load();
+
+            if (data == nullptr || block < data || block >= data + (size_t) numBlocks * (size_t) blockSize)
+                return false;
+
+            auto index = (uint32) ((size_t) (block - data) / (size_t) blockSize) + 1;
+            auto head = freeList.load();
+
+            for (;;)
+            {
+                nextFreeBlocks[index - 1] = (uint32) head;
+
+                if (freeList.compare_exchange_weak (head, (((head >> 32) + 1) << 32) | index))
+                    return true;
+            }
+        }
+
+        std::atomic<uint8*> blocks;
+        std::atomic<uint64> freeList;
+        std::atomic<uint32>* nextFreeBlocks;
+        std::atomic<bool> isInitialised;
+        int numBlocks, blockSize;
+    };
+
+    static DataPool dataPool;
+
+    static uint8* allocateData (int numBytes)
+    {
+        if (auto* d = dataPool.allocate (numBytes))
+            return d;
+
+        return static_cast<uint8*> (std::malloc ((size_t) numBytes));
+    }
+
+    static void freeData (uint8* data) noexcept
+    {
+        if (! dataPool.release (data))
+            std::free (data);
+    }
+}
+
+bool MidiMessage::preallocateDataPool (int numBlocks, int blockSize)
+{
+    return MidiHelpers::dataPool.initialise (numBlocks, blockSize);
 }
 
 //==============================================================================
@@ -263,17 +360,23 @@ MidiMessage& MidiMessage::operator= (const MidiMessage& other)
     {
         if (other.isHeapAllocated())
         {
-            if (isHeapAllocated())
-                packedData.allocatedData = static_cast<uint8*> (std::realloc (packedData.allocatedData, (size_t) other.size));
-            else
-                packedData.allocatedData = static_cast<uint8*> (std::malloc ((size_t) other.size));
+            // the current block is kept if the new data fits in it
+            if (isHeapAllocated() && size < other.size)
+            {
+                MidiHelpers::freeData (packedData.allocatedData);
+                packedData.allocatedData = MidiHelpers::allocateData (other.size);
+            }
+            else if (! isHeapAllocated())
+            {
+                packedData.allocatedData = MidiHelpers::allocateData (other.size);
+            }
 
             memcpy (packedData.allocatedData, other.packedData.allocatedData, (size_t) other.size);
         }
         else
         {
             if (isHeapAllocated())
-                std::free (packedData.allocatedData);
+                MidiHelpers::freeData (packedData.allocatedData);
 
             packedData.allocatedData = other.packedData.allocatedData;
         }
@@ -294,24 +397,31 @@ MidiMessage::MidiMessage (MidiMessage&& other) noexcept
 
 MidiMessage& MidiMessage::operator= (MidiMessage&& other) noexcept
 {
-    packedData.allocatedData = other.packedData.allocatedData;
-    timeStamp = other.timeStamp;
-    size = other.size;
-    other.size = 0;
+    if (this != &other)
+    {
+        if (isHeapAllocated())
+            MidiHelpers::freeData (packedData.allocatedData);
+
+        packedData.allocatedData = other.packedData.allocatedData;
+        timeStamp = other.timeStamp;
+        size = other.size;
+        other.size = 0;
+    }
+
     return *this;
 }
 
 MidiMessage::~MidiMessage() noexcept
 {
     if (isHeapAllocated())
-        std::free (packedData.allocatedData);
+        MidiHelpers::freeData (packedData.allocatedData);
 }
 
 uint8* MidiMessage::allocateSpace (int bytes)
 {
     if (bytes > (int) sizeof (packedData))
     {
-        auto d = static_cast<uint8*> (std::malloc ((size_t) bytes));
+        auto d = MidiHelpers::allocateData (bytes);
         packedData.allocatedData = d;
         return d;
     }
@@ -649,13 +759,16 @@ bool MidiMessage::isSysEx() const noexcept
 
 MidiMessage MidiMessage::createSysExMessage (const void* sysexData, const int dataSize)
 {
-    HeapBlock<uint8> m (dataSize + 2);
+    MidiMessage result;
+
+    auto dest = result.allocateSpace (dataSize + 2);
+    result.size = dataSize + 2;
 
-    m[0] = 0xf0;
-    memcpy (m + 1, sysexData, (size_t) dataSize);
-    m[dataSize + 1] = 0xf7;
+    dest[0] = 0xf0;
+    memcpy (dest + 1, sysexData, (size_t) dataSize);
+    dest[dataSize + 1] = 0xf7;
 
-    return MidiMessage (m, dataSize + 2);
+    return result;
 }
 
 const uint8* MidiMessage::getSysExData() const noexcept
@@ -1134,4 +1247,230 @@ const char* MidiMessage::getControllerName (const int n)
     return isPositiveAndBelow (n, numElementsInArray (names)) ? names[n] : nullptr;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiMessageDataPoolTests  : public UnitTest
+{
+    MidiMessageDataPoolTests() : UnitTest ("MidiMessage data pool", "Audio") {}
+
+    using DataPool = MidiHelpers::DataPool;
+
+    static int countFreeBlocks (const DataPool& pool)
+    {
+        int numFree = 0;
+
+        for (auto index = (uint32) pool.freeList.load(); index != 0; index = pool.nextFreeBlocks[index - 1].load())
+            ++numFree;
+
+        return numFree;
+    }
+
+    static bool isInPool (const DataPool& pool, const uint8* data)
+    {
+        auto* blocks = pool.blocks.load();
+        return blocks != nullptr && data >= blocks && data < blocks + (size_t) pool.numBlocks * (size_t) pool.blockSize;
+    }
+
+    static void freePool (DataPool& pool)
+    {
+        std::free (pool.blocks.load());
+        delete[] pool.nextFreeBlocks;
+    }
+
+    static MidiMessage createSysEx (int numBytes, uint8 value)
+    {
+        HeapBlock<uint8> data ((size_t) numBytes);
+        memset (data, value, (size_t) numBytes);
+        return MidiMessage::createSysExMessage (data, numBytes);
+    }
+
+    static bool hasSysExData (const MidiMessage& m, int numBytes, uint8 value)
+    {
+        if (m.getSysExDataSize() != numBytes)
+            return false;
+
+        for (int i = 0; i < numBytes; ++i)
+            if (m.getSysExData()[i] != value)
+                return false;
+
+        return true;
+    }
+
+    struct AllocatingThread  : public Thread
+    {
+        AllocatingThread (DataPool& p, uint8 v)  : Thread ("DataPool test"), pool (p), value (v) {}
+
+        void run() override
+        {
+            uint8* owned[4] = {};
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                auto& block = owned[i % 4];
+
+                if (block != nullptr)
+                {
+                    for (int j = 0; j < pool.blockSize; ++j)
+                        if (block[j] != value)
+                            ++numCorruptedBlocks;
+
+                    pool.release (block);
+                    block = nullptr;
+                }
+                else if ((block = pool.allocate (pool.blockSize)) != nullptr)
+                {
+                    memset (block, value, (size_t) pool.blockSize);
+                }
+            }
+
+            for (auto* block : owned)
+                if (block != nullptr)
+                    pool.release (block);
+        }
+
+        DataPool& pool;
+        const uint8 value;
+        int numCorruptedBlocks = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Allocating and releasing blocks");
+        {
+            DataPool pool {};
+            expect (pool.allocate (16) == nullptr);
+            expect (pool.initialise (4, 32));
+            expect (! pool.initialise (8, 32));
+            expectEquals (countFreeBlocks (pool), 4);
+
+            Array<uint8*> blocks;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                auto* block = pool.allocate (32);
+                expect (isInPool (pool, block));
+                expect (! blocks.contains (block));
+                blocks.add (block);
+            }
+
+            expectEquals (countFreeBlocks (pool), 0);
+            expect (pool.allocate (1) == nullptr);
+
+            uint8 notInPool[32];
+            expect (! pool.release (notInPool));
+
+            for (auto* block : blocks)
+                expect (pool.release (block));
+
+            expectEquals (countFreeBlocks (pool), 4);
+            expect (pool.allocate (33) == nullptr);
+
+            freePool (pool);
+        }
+
+        beginTest ("Concurrent allocation");
+        {
+            DataPool pool {};
+            pool.initialise (8, 64);
+
+            OwnedArray<AllocatingThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new AllocatingThread (pool, (uint8) (i + 1)))->startThread();
+
+            for (auto* thread : threads)
+            {
+                thread->stopThread (-1);
+                expectEquals (thread->numCorruptedBlocks, 0);
+            }
+
+            expectEquals (countFreeBlocks (pool), 8);
+            freePool (pool);
+        }
+
+        // the shared pool can only be created once, so these tests work with whichever
+        // size it has if something else has already created it
+        MidiMessage::preallocateDataPool (16, 64);
+        auto& pool = MidiHelpers::dataPool;
+        auto blockSize = pool.blockSize;
+
+        beginTest ("Falling back to malloc");
+        {
+            auto numFree = countFreeBlocks (pool);
+
+            {
+                OwnedArray<MidiMessage> messages;
+
+                for (int i = 0; i <= numFree; ++i)
+                    messages.add (new MidiMessage (createSysEx (blockSize - 2, (uint8) (i & 0x7f))));
+
+                expectEquals (countFreeBlocks (pool), 0);
+                expect (! isInPool (pool, messages.getLast()->getRawData()));
+
+                auto big = createSysEx (blockSize * 2, 1);
+                expect (! isInPool (pool, big.getRawData()));
+                expect (hasSysExData (big, blockSize * 2, 1));
+
+                for (int i = 0; i <= numFree; ++i)
+                    expect (hasSysExData (*messages[i], blockSize - 2, (uint8) (i & 0x7f)));
+            }
+
+            expectEquals (countFreeBlocks (pool), numFree);
+        }
+
+        beginTest ("Copy assignment");
+        {
+            auto numFree = countFreeBlocks (pool);
+
+            auto a = createSysEx (blockSize - 2, 1);
+            auto b = createSysEx (blockSize / 2, 2);
+            expect (isInPool (pool, a.getRawData()));
+            expectEquals (countFreeBlocks (pool), numFree - 2);
+
+            // a smaller message is copied into the current block
+            auto* block = a.getRawData();
+            a = b;
+            expect (a.getRawData() == block);
+            expect (hasSysExData (a, blockSize / 2, 2));
+            expectEquals (countFreeBlocks (pool), numFree - 2);
+
+            // a bigger one needs a new block, and the old one is released
+            auto big = createSysEx (blockSize * 2, 3);
+            a = big;
+            expect (! isInPool (pool, a.getRawData()));
+            expect (hasSysExData (a, blockSize * 2, 3));
+            expectEquals (countFreeBlocks (pool), numFree - 1);
+
+            // and so is the block of a message replaced by a short one
+            b = MidiMessage::noteOn (1, 60, (uint8) 100);
+            expect (b.isNoteOn());
+            expectEquals (countFreeBlocks (pool), numFree);
+        }
+
+        beginTest ("Move assignment");
+        {
+            auto numFree = countFreeBlocks (pool);
+
+            auto a = createSysEx (blockSize - 2, 1);
+            auto b = createSysEx (blockSize - 2, 2);
+            auto* block = b.getRawData();
+            expectEquals (countFreeBlocks (pool), numFree - 2);
+
+            a = std::move (b);
+            expect (a.getRawData() == block);
+            expect (hasSysExData (a, blockSize - 2, 2));
+            expectEquals (countFreeBlocks (pool), numFree - 1);
+
+            a = MidiMessage::controllerEvent (1, 7, 100);
+            expectEquals (countFreeBlocks (pool), numFree);
+        }
+    }
+};
+
+static MidiMessageDataPoolTests midiMessageDataPoolTests;
+
+#endif
+
 } // namespace juce
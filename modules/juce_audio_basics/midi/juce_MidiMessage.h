@@ -854,6 +854,21 @@ public:
     static MidiMessage createSysExMessage (const void* sysexData,
                                            int dataSize);
 
+    /** Preallocates a pool of memory blocks, which the messages then use to store the
+        data that doesn't fit inside the MidiMessage object, e.g. for SysEx messages,
+        instead of allocating it on the heap.
+
+        The blocks are taken from the pool and returned to it without locking, so once
+        the pool exists, messages which fit in a block can be created, copied and deleted
+        on the audio thread. Bigger messages, or messages created while all the blocks are
+        in use, still allocate their data on the heap.
+
+        The pool can only be created once, and is then kept until the application exits,
+        so this should be called at startup.
+
+        @returns false if the pool had already been created
+    */
+    static bool preallocateDataPool (int numBlocks, int blockSize);
 
     //==============================================================================
     /** Reads a midi variable-length integer.
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A reference to the data of a midi message stored in a MidiBuffer or a
+    MidiEventList, which can be inspected without copying it into a MidiMessage.
+
+    The view is only valid until the buffer holding the data is altered. Its methods
+    behave like the MidiMessage methods with the same names.
+
+    @code
+    for (auto event : midiBuffer)
+    {
+        if (event.isNoteOn())
+            startNote (event.samplePosition, event.getChannel(), event.getNoteNumber());
+        else if (event.isSysEx())
+            forwardSysEx (event.samplePosition, event.getSysExData(), event.getSysExDataSize());
+    }
+    @endcode
+
+    @see MidiMessage, MidiBuffer, MidiEventList
+
+    @tags{Audio}
+*/
+struct MidiMessageView
+{
+    //==============================================================================
+    /** Returns a copy of the message as a MidiMessage, timestamped with its sample position. */
+    MidiMessage getMessage() const                          { return MidiMessage (data, numBytes, samplePosition); }
+
+    /** Returns the raw midi data. */
+    const uint8* getRawData() const noexcept                { return data; }
+
+    /** Returns the number of bytes of the midi data. */
+    int getRawDataSize() const noexcept                     { return numBytes; }
+
+    //==============================================================================
+    /** Returns the midi channel of the message, between 1 and 16, or 0 if it isn't a
+        channel message.
+    */
+    int getChannel() const noexcept                         { return (data[0] & 0xf0) != 0xf0 ? (data[0] & 0xf) + 1 : 0; }
+
+    /** Returns true if the message applies to the given midi channel, between 1 and 16. */
+    bool isForChannel (int channel) const noexcept          { return (data[0] & 0xf) == channel - 1 && (data[0] & 0xf0) != 0xf0; }
+
+    /** Returns true if the message is a note-on event. @see MidiMessage::isNoteOn */
+    bool isNoteOn (bool returnTrueForVelocity0 = false) const noexcept
+    {
+        return numBytes == 3 && (data[0] & 0xf0) == 0x90 && (returnTrueForVelocity0 || data[2] != 0);
+    }
+
+    /** Returns true if the message is a note-off event. @see MidiMessage::isNoteOff */
+    bool isNoteOff (bool returnTrueForNoteOnVelocity0 = true) const noexcept
+    {
+        return numBytes == 3
+                && ((data[0] & 0xf0) == 0x80
+                     || (returnTrueForNoteOnVelocity0 && (data[0] & 0xf0) == 0x90 && data[2] == 0));
+    }
+
+    /** Returns true if the message is a note-on or note-off event. */
+    bool isNoteOnOrOff() const noexcept                     { return numBytes == 3 && ((data[0] & 0xf0) == 0x90 || (data[0] & 0xf0) == 0x80); }
+
+    /** Returns the note number of a note-on, note-off or aftertouch event. */
+    int getNoteNumber() const noexcept                      { return data[1]; }
+
+    /** Returns the velocity of a note-on or note-off event, or 0 for other messages. */
+    uint8 getVelocity() const noexcept                      { return isNoteOnOrOff() ? data[2] : 0; }
+
+    /** Returns true if the message is an aftertouch event. */
+    bool isAftertouch() const noexcept                      { return (data[0] & 0xf0) == 0xa0; }
+
+    /** Returns the value of an aftertouch event. */
+    int getAfterTouchValue() const noexcept                 { jassert (isAftertouch()); return data[2]; }
+
+    /** Returns true if the message is a channel pressure event. */
+    bool isChannelPressure() const noexcept                 { return (data[0] & 0xf0) == 0xd0; }
+
+    /** Returns the value of a channel pressure event. */
+    int getChannelPressureValue() const noexcept            { jassert (isChannelPressure()); return data[1]; }
+
+    /** Returns true if the message is a pitch-wheel event. */
+    bool isPitchWheel() const noexcept                      { return (data[0] & 0xf0) == 0xe0; }
+
+    /** Returns the position of a pitch-wheel event, between 0 and 0x3fff. */
+    int getPitchWheelValue() const noexcept                 { jassert (isPitchWheel()); return data[1] | (data[2] << 7); }
+
+    /** Returns true if the message is a controller event. */
+    bool isController() const noexcept                      { return (data[0] & 0xf0) == 0xb0; }
+
+    /** Returns the controller number of a controller event. */
+    int getControllerNumber() const noexcept                { jassert (isController()); return data[1]; }
+
+    /** Returns the value of a controller event. */
+    int getControllerValue() const noexcept                 { jassert (isController()); return data[2]; }
+
+    /** Returns true if the message is a program change event. */
+    bool isProgramChange() const noexcept                   { return (data[0] & 0xf0) == 0xc0; }
+
+    /** Returns the program number of a program change event. */
+    int getProgramChangeNumber() const noexcept             { jassert (isProgramChange()); return data[1]; }
+
+    /** Returns true if the message is a SysEx message. */
+    bool isSysEx() const noexcept                           { return data[0] == 0xf0; }
+
+    /** Returns the data of a SysEx message, without its leading 0xf0 byte, or nullptr
+        if the message isn't a SysEx message.
+    */
+    const uint8* getSysExData() const noexcept              { return isSysEx() ? data + 1 : nullptr; }
+
+    /** Returns the size of the data returned by getSysExData(), without the 0xf0 and 0xf7 bytes. */
+    int getSysExDataSize() const noexcept                   { return isSysEx() ? numBytes - 2 : 0; }
+
+    /** Returns true if the message is a meta-event, as found in midi files. */
+    bool isMetaEvent() const noexcept                       { return data[0] == 0xff; }
+
+    //==============================================================================
+    const uint8* data;      /**< The bytes of the midi message. */
+    int numBytes;           /**< The number of bytes of the midi message. */
+    int samplePosition;     /**< The position of the message in its buffer. */
+};
+
+} // namespace juce
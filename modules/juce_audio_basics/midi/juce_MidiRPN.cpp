@@ -133,6 +133,19 @@ MidiBuffer MidiRPNGenerator::generate (int midiChannel,
                                        bool isNRPN,
                                        bool use14BitValue)
 {
+    MidiBuffer buffer;
+    generate (buffer, 0, { midiChannel, parameterNumber, value, isNRPN, use14BitValue });
+    return buffer;
+}
+
+void MidiRPNGenerator::generate (MidiBuffer& buffer, int sampleNumber, MidiRPNMessage message)
+{
+    auto midiChannel = message.channel;
+    auto parameterNumber = message.parameterNumber;
+    auto value = message.value;
+    auto isNRPN = message.isNRPN;
+    auto use14BitValue = message.is14BitValue;
+
     jassert (midiChannel > 0 && midiChannel <= 16);
     jassert (parameterNumber >= 0 && parameterNumber < 16384);
     jassert (value >= 0 && value < (use14BitValue ? 16384 : 128));
@@ -145,18 +158,14 @@ MidiBuffer MidiRPNGenerator::generate (int midiChannel,
 
     uint8 channelByte = uint8 (0xb0 + midiChannel - 1);
 
-    MidiBuffer buffer;
-
-    buffer.addEvent (MidiMessage (channelByte, isNRPN ? 0x62 : 0x64, parameterLSB),  0);
-    buffer.addEvent (MidiMessage (channelByte, isNRPN ? 0x63 : 0x65, parameterMSB),  0);
+    buffer.addEvent (MidiMessage (channelByte, isNRPN ? 0x62 : 0x64, parameterLSB), sampleNumber);
+    buffer.addEvent (MidiMessage (channelByte, isNRPN ? 0x63 : 0x65, parameterMSB), sampleNumber);
 
     // sending the value LSB is optional, but must come before sending the value MSB:
     if (use14BitValue)
-        buffer.addEvent (MidiMessage (channelByte, 0x26, valueLSB), 0);
-
-    buffer.addEvent (MidiMessage (channelByte, 0x06, valueMSB), 0);
+        buffer.addEvent (MidiMessage (channelByte, 0x26, valueLSB), sampleNumber);
 
-    return buffer;
+    buffer.addEvent (MidiMessage (channelByte, 0x06, valueMSB), sampleNumber);
 }
 
 //==============================================================================
@@ -327,6 +336,14 @@ public:
                 MidiBuffer buffer = MidiRPNGenerator::generate (message);
                 expectContainsRPN (buffer, message);
             }
+            {
+                MidiRPNMessage message = { 3, 1000, 5000, true, true };
+                MidiBuffer buffer;
+                MidiRPNGenerator::generate (buffer, 10, message);
+                expectContainsRPN (buffer, message);
+                expectEquals (buffer.getFirstEventTime(), 10);
+                expectEquals (buffer.getNumEvents(), 4);
+            }
         }
     }
 
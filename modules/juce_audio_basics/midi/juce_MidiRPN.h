@@ -149,6 +149,15 @@ public:
                                 int value,
                                 bool isNRPN = false,
                                 bool use14BitValue = true);
+
+    /** Adds the MIDI messages representing the given RPN or NRPN message to a buffer,
+        at the given sample position.
+
+        Unlike the other methods, this doesn't create a new MidiBuffer, so it doesn't
+        allocate any memory if the destination buffer has enough space preallocated,
+        and can be used on the audio thread.
+    */
+    static void generate (MidiBuffer& destination, int sampleNumber, MidiRPNMessage message);
 };
 
 } // namespace juce
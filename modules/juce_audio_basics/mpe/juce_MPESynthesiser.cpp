@@ -23,6 +23,22 @@
 namespace juce
 {
 
+struct MPESynthesiser::VoiceBuffer
+{
+    template <typename floatType>
+    AudioBuffer<floatType>& getBuffer() noexcept;
+
+    AudioBuffer<float> floatBuffer;
+    AudioBuffer<double> doubleBuffer;
+};
+
+template <>
+AudioBuffer<float>& MPESynthesiser::VoiceBuffer::getBuffer<float>() noexcept     { return floatBuffer; }
+
+template <>
+AudioBuffer<double>& MPESynthesiser::VoiceBuffer::getBuffer<double>() noexcept   { return doubleBuffer; }
+
+//==============================================================================
 MPESynthesiser::MPESynthesiser()
 {
     MPEZoneLayout zoneLayout;
@@ -258,6 +274,7 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
     const ScopedLock sl (voicesLock);
     newVoice->setCurrentSampleRate (getSampleRate());
     voices.add (newVoice);
+    allocateVoiceBuffers();
 }
 
 void MPESynthesiser::clearVoices()
@@ -294,6 +311,43 @@ void MPESynthesiser::reduceNumVoices (const int newNumVoices)
     }
 }
 
+//==============================================================================
+void MPESynthesiser::setParallelVoiceRendering (int numWorkerThreads, int maximumBlockSize, int numChannels)
+{
+    jassert (numWorkerThreads >= 0 && maximumBlockSize > 0 && numChannels > 0);
+
+    std::unique_ptr<RenderingThreadPool> newPool;
+
+    if (numWorkerThreads > 0)
+        newPool.reset (new RenderingThreadPool (numWorkerThreads));
+
+    OwnedArray<VoiceBuffer> newVoiceBuffers;
+
+    {
+        const ScopedLock sl (voicesLock);
+        std::swap (renderingPool, newPool);
+        voiceBuffers.swapWith (newVoiceBuffers);
+        voiceBufferSize = maximumBlockSize;
+        voiceBufferNumChannels = numChannels;
+        allocateVoiceBuffers();
+    }
+}
+
+void MPESynthesiser::allocateVoiceBuffers()
+{
+    if (renderingPool == nullptr)
+        return;
+
+    while (voiceBuffers.size() < voices.size())
+    {
+        auto* voiceBuffer = voiceBuffers.add (new VoiceBuffer());
+        voiceBuffer->floatBuffer.setSize (voiceBufferNumChannels, voiceBufferSize);
+        voiceBuffer->doubleBuffer.setSize (voiceBufferNumChannels, voiceBufferSize);
+    }
+
+    activeVoices.realloc ((size_t) jmax (1, voiceBuffers.size()));
+}
+
 void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 {
     // first turn off all voices (it's more efficient to do this immediately
@@ -308,6 +362,9 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 //==============================================================================
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInParallel (buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -317,6 +374,9 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
 
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (renderVoicesInParallel (buffer, startSample, numSamples))
+        return;
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -324,4 +384,223 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
     }
 }
 
+template <typename floatType>
+bool MPESynthesiser::renderVoicesInParallel (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    const ScopedLock sl (voicesLock);
+
+    auto numChannels = buffer.getNumChannels();
+
+    if (renderingPool == nullptr || numSamples > voiceBufferSize || numChannels > voiceBufferNumChannels)
+        return false;
+
+    int numActiveVoices = 0;
+
+    for (auto* voice : voices)
+        if (voice->isActive())
+            activeVoices[numActiveVoices++] = voice;
+
+    if (numActiveVoices < 2)
+        return false;
+
+    auto renderVoice = [this, numChannels, numSamples] (int voiceIndex, int /*threadIndex*/)
+    {
+        auto& data = voiceBuffers.getUnchecked (voiceIndex)->template getBuffer<floatType>();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            data.clear (channel, 0, numSamples);
+
+        // the voice sees a buffer with the same number of channels as the output
+        AudioBuffer<floatType> output (data.getArrayOfWritePointers(), numChannels, numSamples);
+        activeVoices[voiceIndex]->renderNextBlock (output, 0, numSamples);
+    };
+
+    renderingPool->run (numActiveVoices, renderVoice);
+
+    // the voices are always added in the same order, whichever threads rendered them
+    for (int i = 0; i < numActiveVoices; ++i)
+    {
+        auto& data = voiceBuffers.getUnchecked (i)->template getBuffer<floatType>();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.addFrom (channel, startSample, data, channel, 0, numSamples);
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MPESynthesiserTests  : public UnitTest
+{
+    MPESynthesiserTests() : UnitTest ("MPESynthesiser", "Audio") {}
+
+    // a sine wave which follows the pitchbend and pressure of its note and
+    // fades out over a fixed number of samples when released
+    struct TestVoice  : public MPESynthesiserVoice
+    {
+        void noteStarted() override
+        {
+            phase = 0;
+            tailLeft = -1;
+        }
+
+        void noteStopped (bool allowTailOff) override
+        {
+            if (allowTailOff)
+            {
+                tailLeft = tailLength;
+            }
+            else
+            {
+                clearCurrentNote();
+                tailLeft = -1;
+            }
+        }
+
+        void notePressureChanged() override {}
+        void notePitchbendChanged() override {}
+        void noteTimbreChanged() override {}
+        void noteKeyStateChanged() override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            auto increment = MathConstants<double>::twoPi * currentlyPlayingNote.getFrequencyInHertz() / getSampleRate();
+            auto level = 0.1f + currentlyPlayingNote.pressure.asUnsignedFloat();
+
+            for (int i = startSample; i < startSample + numSamples && isActive(); ++i)
+            {
+                auto gain = tailLeft >= 0 ? level * (float) tailLeft / (float) tailLength : level;
+                auto sample = gain * (float) std::sin (phase);
+                phase += increment;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, sample * (float) (channel + 1));
+
+                if (tailLeft >= 0 && --tailLeft == 0)
+                {
+                    clearCurrentNote();
+                    tailLeft = -1;
+                }
+            }
+        }
+
+        void renderNextBlock (AudioBuffer<double>&, int, int) override {}
+
+        static constexpr int tailLength = 100;
+        double phase = 0;
+        int tailLeft = -1;
+    };
+
+    static void prepare (MPESynthesiser& synth, int numVoices)
+    {
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setVoiceStealingEnabled (true);
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new TestVoice());
+    }
+
+    static int getNumActiveVoices (MPESynthesiser& synth)
+    {
+        int numActive = 0;
+
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->isActive())
+                ++numActive;
+
+        return numActive;
+    }
+
+    void runTest() override
+    {
+        const int blockSize = 256;
+
+        beginTest ("Parallel rendering");
+        {
+            MPESynthesiser serial, parallel;
+            prepare (serial, 8);
+            prepare (parallel, 8);
+            parallel.setParallelVoiceRendering (3, blockSize, 2);
+
+            MidiBuffer midi;
+
+            // one note per member channel of the lower zone, each of them bent and pressed
+            // while it's playing, and a ninth note which steals one of the voices
+            for (int i = 0; i < 9; ++i)
+            {
+                auto channel = 2 + i;
+                auto start = i * 300;
+
+                midi.addEvent (MidiMessage::noteOn (channel, 48 + i * 3, 0.1f + 0.1f * (float) i), start);
+                midi.addEvent (MidiMessage::pitchWheel (channel, 8192 + 500 * (i - 4)), start + 150);
+                midi.addEvent (MidiMessage::channelPressureChange (channel, 20 + i * 10), start + 400);
+                midi.addEvent (MidiMessage::noteOff (channel, 48 + i * 3), 3000 + i * 200);
+            }
+
+            AudioBuffer<float> serialOutput (2, blockSize), parallelOutput (2, blockSize);
+            float maxDifference = 0;
+            int maxNumActiveVoices = 0;
+
+            for (int block = 0; block < 24; ++block)
+            {
+                MidiBuffer blockMidi;
+                blockMidi.addEvents (midi, block * blockSize, blockSize, -block * blockSize);
+
+                serialOutput.clear();
+                parallelOutput.clear();
+                serial.renderNextBlock (serialOutput, blockMidi, 0, blockSize);
+                parallel.renderNextBlock (parallelOutput, blockMidi, 0, blockSize);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        maxDifference = jmax (maxDifference, std::abs (serialOutput.getSample (channel, i)
+                                                                         - parallelOutput.getSample (channel, i)));
+
+                expectEquals (getNumActiveVoices (parallel), getNumActiveVoices (serial));
+                maxNumActiveVoices = jmax (maxNumActiveVoices, getNumActiveVoices (parallel));
+            }
+
+            expect (maxDifference < 1.0e-5f);
+            expectEquals (maxNumActiveVoices, 8);
+            expectEquals (getNumActiveVoices (parallel), 0);
+        }
+
+        beginTest ("Blocks longer than the maximum block size");
+        {
+            MPESynthesiser serial, parallel;
+            prepare (serial, 4);
+            prepare (parallel, 4);
+            parallel.setParallelVoiceRendering (2, 64, 2);
+
+            MidiBuffer midi;
+
+            for (int i = 0; i < 4; ++i)
+                midi.addEvent (MidiMessage::noteOn (2 + i, 60 + i * 4, 0.5f), i * 10);
+
+            AudioBuffer<float> serialOutput (2, 512), parallelOutput (2, 512);
+            serialOutput.clear();
+            parallelOutput.clear();
+            serial.renderNextBlock (serialOutput, midi, 0, 512);
+            parallel.renderNextBlock (parallelOutput, midi, 0, 512);
+
+            float maxDifference = 0;
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < 512; ++i)
+                    maxDifference = jmax (maxDifference, std::abs (serialOutput.getSample (channel, i)
+                                                                     - parallelOutput.getSample (channel, i)));
+
+            expect (maxDifference < 1.0e-5f);
+            expect (parallelOutput.getMagnitude (0, 512) > 0.1f);
+        }
+    }
+};
+
+static MPESynthesiserTests mpeSynthesiserTests;
+
+#endif // JUCE_UNIT_TESTS
+
 } // namespace juce
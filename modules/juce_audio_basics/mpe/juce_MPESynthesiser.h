@@ -91,6 +91,9 @@ public:
         The object passed in will be managed by the synthesiser, which will delete
         it later on when no longer needed. The caller should not retain a pointer to the
         voice.
+
+        When parallel rendering is enabled, this also allocates the buffer that the voice
+        is rendered into, so it mustn't be called while the synthesiser is rendering.
     */
     void addVoice (MPESynthesiserVoice* newVoice);
 
@@ -127,6 +130,29 @@ public:
     /** Returns true if note-stealing is enabled. */
     bool isVoiceStealingEnabled() const noexcept                { return shouldStealVoices; }
 
+    //==============================================================================
+    /** Renders the playing voices in parallel on a pool of worker threads.
+
+        Each voice is rendered into a buffer of its own, and these buffers are then added
+        to the output in the order of the voices, so the result doesn't depend on which
+        thread rendered which voice. The voices mustn't modify any data that they share
+        while rendering. The notes are still started, stopped and stolen on the audio
+        thread between the sub-blocks, so voice stealing behaves as when the voices are
+        rendered one after the other.
+
+        This creates the threads and allocates a buffer for each voice, so it should be
+        called before rendering starts, for instance in prepareToPlay(). The voices added
+        afterwards allocate their buffers in addVoice(), so they should also be added
+        while the synthesiser isn't rendering. Blocks longer than the
+        maximum block size or with more channels are rendered on the audio thread.
+
+        @param numWorkerThreads     the number of threads used in addition to the audio
+                                    thread, or 0 to render all the voices on the audio thread
+        @param maximumBlockSize     the maximum number of samples rendered at once
+        @param numChannels          the number of channels of the output buffer
+    */
+    void setParallelVoiceRendering (int numWorkerThreads, int maximumBlockSize, int numChannels);
+
     //==============================================================================
     /** Tells the synthesiser what the sample rate is for the audio it's being used to render.
 
@@ -305,6 +331,19 @@ private:
     //==============================================================================
     bool shouldStealVoices = false;
 
+    template <typename floatType>
+    bool renderVoicesInParallel (AudioBuffer<floatType>&, int startSample, int numSamples);
+    void allocateVoiceBuffers();
+
+    // one buffer per voice for the parallel rendering, and the list of the voices
+    // playing in the current sub-block, which are rendered into the buffers with
+    // the same indexes
+    struct VoiceBuffer;
+    std::unique_ptr<RenderingThreadPool> renderingPool;
+    OwnedArray<VoiceBuffer> voiceBuffers;
+    HeapBlock<MPESynthesiserVoice*> activeVoices;
+    int voiceBufferSize = 0, voiceBufferNumChannels = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
 
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+struct SincResamplingAudioSource::ResamplerState
+{
+    explicit ResamplerState (int numZeroCrossings)  : resampler (numZeroCrossings) {}
+
+    SincResampler resampler;
+    AudioBuffer<float> buffer;
+
+    JUCE_DECLARE_NON_COPYABLE (ResamplerState)
+};
+
+//==============================================================================
+SincResamplingAudioSource::SincResamplingAudioSource (AudioSource* const inputSource,
+                                                      const bool deleteInputWhenDeleted,
+                                                      const int channels,
+                                                      const int zeroCrossings)
+    : input (inputSource, deleteInputWhenDeleted),
+      numChannels (channels),
+      numZeroCrossings (zeroCrossings)
+{
+    jassert (input != nullptr);
+
+    for (auto& retired : retiredStates)
+        retired = nullptr;
+
+    state.reset (createState (1.0));
+}
+
+SincResamplingAudioSource::~SincResamplingAudioSource()
+{
+    delete pendingState.exchange (nullptr);
+    deleteUnusedStates();
+}
+
+SincResamplingAudioSource::ResamplerState* SincResamplingAudioSource::createState (double newRatio) const
+{
+    std::unique_ptr<ResamplerState> newState (new ResamplerState (numZeroCrossings));
+    newState->resampler.setResamplingRatio (newRatio);
+    newState->resampler.prepare (numChannels);
+
+    // enough input for a block, wherever the resampler is in its stream
+    auto numInputSamples = (int) std::ceil ((blockSize + 1) * newRatio) + newState->resampler.getFilterLength() + 32;
+    newState->buffer.setSize (numChannels, numInputSamples);
+
+    return newState.release();
+}
+
+void SincResamplingAudioSource::deleteUnusedStates()
+{
+    for (auto& retired : retiredStates)
+        delete retired.exchange (nullptr);
+}
+
+void SincResamplingAudioSource::retireState (ResamplerState* oldState) noexcept
+{
+    for (auto& retired : retiredStates)
+    {
+        ResamplerState* empty = nullptr;
+
+        if (retired.compare_exchange_strong (empty, oldState))
+            return;
+    }
+
+    // there's always a free slot, see the comment in the header
+    jassertfalse;
+}
+
+void SincResamplingAudioSource::setResamplingRatio (const double samplesInPerOutputSample)
+{
+    jassert (samplesInPerOutputSample > 0);
+
+    const ScopedLock sl (stateCreationLock);
+
+    if (ratio.get() == samplesInPerOutputSample)
+        return;
+
+    ratio = samplesInPerOutputSample;
+    deleteUnusedStates();
+
+    // a state which hasn't been picked up yet is replaced
+    delete pendingState.exchange (createState (samplesInPerOutputSample));
+}
+
+void SincResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const ScopedLock sl (stateCreationLock);
+
+    auto localRatio = ratio.get();
+    blockSize = samplesPerBlockExpected;
+
+    delete pendingState.exchange (nullptr);
+    deleteUnusedStates();
+    state.reset (createState (localRatio));
+
+    auto scaledBlockSize = roundToInt (samplesPerBlockExpected * localRatio);
+    input->prepareToPlay (scaledBlockSize, sampleRate * localRatio);
+
+    destBuffers.calloc (numChannels);
+}
+
+void SincResamplingAudioSource::flushBuffers()
+{
+    state->resampler.reset();
+}
+
+void SincResamplingAudioSource::releaseResources()
+{
+    input->releaseResources();
+
+    const ScopedLock sl (stateCreationLock);
+    deleteUnusedStates();
+    state->buffer.setSize (numChannels, 0);
+}
+
+void SincResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    if (auto* newState = pendingState.exchange (nullptr))
+    {
+        newState->resampler.continueFrom (state->resampler);
+        retireState (state.release());
+        state.reset (newState);
+    }
+
+    auto& resampler = state->resampler;
+    auto& buffer = state->buffer;
+    auto sampsNeeded = resampler.getNumInputSamplesNeeded (info.numSamples);
+
+    // this only happens if the blocks are bigger than the size given to prepareToPlay()
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (numChannels, sampsNeeded + 32, false, false, true);
+
+    if (sampsNeeded > 0)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, 0, sampsNeeded);
+        input->getNextAudioBlock (readInfo);
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        destBuffers[channel] = channel < channelsToProcess ? info.buffer->getWritePointer (channel, info.startSample)
+                                                           : nullptr;
+
+    // when upsampling, the input can be enough for a few more samples, which are kept for the next block
+    auto numProduced = resampler.process (buffer.getArrayOfReadPointers(), sampsNeeded, destBuffers, info.numSamples);
+    ignoreUnused (numProduced);
+    jassert (numProduced == info.numSamples);
+
+    for (int channel = numChannels; channel < info.buffer->getNumChannels(); ++channel)
+        info.buffer->clear (channel, info.startSample, info.numSamples);
+}
+
+} // namespace juce
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A type of AudioSource that takes an input source and changes its sample rate
+    with a SincResampler.
+
+    This gives a much better quality than ResamplingAudioSource, but changing the
+    ratio designs a new filter, so it should be used for conversions between fixed
+    sample rates rather than for continuously varying speeds. The filter is designed
+    on the thread which changes the ratio, and handed over to the audio thread.
+
+    @see SincResampler, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  SincResamplingAudioSource  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a SincResamplingAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param numChannels              the number of channels to process
+        @param numZeroCrossings         the quality of the filter, see SincResampler
+    */
+    SincResamplingAudioSource (AudioSource* inputSource,
+                               bool deleteInputWhenDeleted,
+                               int numChannels = 2,
+                               int numZeroCrossings = 32);
+
+    /** Destructor. */
+    ~SincResamplingAudioSource();
+
+    /** Changes the resampling ratio.
+
+        This can be called from any thread but the audio thread, as it designs the new
+        filter and allocates its buffers. The audio thread picks it up at the start of
+        the next block, without taking any lock or allocating memory.
+
+        @param samplesInPerOutputSample     if set to 1.0, the input is passed through; higher
+                                            values will speed it up; lower values will slow it
+                                            down. The ratio must be greater than 0
+    */
+    void setResamplingRatio (double samplesInPerOutputSample);
+
+    /** Returns the current resampling ratio.
+
+        This is the value that was set by setResamplingRatio().
+    */
+    double getResamplingRatio() const noexcept                  { return ratio.get(); }
+
+    /** Clears any buffers that the resampler is using. */
+    void flushBuffers();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    struct ResamplerState;
+
+    ResamplerState* createState (double newRatio) const;
+    void deleteUnusedStates();
+    void retireState (ResamplerState*) noexcept;
+
+    OptionalScopedPointer<AudioSource> input;
+    Atomic<double> ratio { 1.0 };
+    const int numChannels, numZeroCrossings;
+    int blockSize = 0;
+    HeapBlock<float*> destBuffers;
+
+    // the state used by the audio thread, the next one to use, and the previous ones
+    // to be deleted by another thread. Between two calls to deleteUnusedStates(), the
+    // audio thread can only retire the state replaced by the pending state posted
+    // before the cleanup, and the one replaced by the state posted after it
+    std::unique_ptr<ResamplerState> state;
+    std::atomic<ResamplerState*> pendingState { nullptr };
+    std::atomic<ResamplerState*> retiredStates[2];
+    CriticalSection stateCreationLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SincResamplingAudioSource)
+};
+
+} // namespace juce
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+struct RenderingThreadPool::Worker  : public Thread
+{
+    Worker (RenderingThreadPool& p, int index)
+        : Thread ("Rendering worker " + String (index)), pool (p), threadIndex (index)
+    {
+        startThread (realtimeAudioPriority);
+    }
+
+    ~Worker()
+    {
+        signalThreadShouldExit();
+        start.signal();
+        stopThread (5000);
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            start.wait (-1);
+
+            if (threadShouldExit())
+                return;
+
+            pool.processJobs (threadIndex);
+
+            if (--pool.numWorkersRunning == 0)
+                pool.finished.signal();
+        }
+    }
+
+    RenderingThreadPool& pool;
+    const int threadIndex;
+    WaitableEvent start;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+RenderingThreadPool::RenderingThreadPool (int numWorkerThreads)
+{
+    jassert (numWorkerThreads >= 0);
+
+    for (int i = 0; i < numWorkerThreads; ++i)
+        workers.add (new Worker (*this, i + 1));
+}
+
+RenderingThreadPool::~RenderingThreadPool()
+{
+    workers.clear();
+}
+
+void RenderingThreadPool::runJobs (int numJobs, void* context, JobCallback callback) noexcept
+{
+    if (numJobs <= 0)
+        return;
+
+    jobContext = context;
+    jobCallback = callback;
+    numJobsToRun = numJobs;
+    nextJob = 0;
+
+    // only the workers which can get a job are woken up, the calling thread taking one
+    auto numWorkersToStart = jmin (workers.size(), numJobs - 1);
+    numWorkersRunning = numWorkersToStart;
+
+    // a signal left over from the previous run could only have come after its end
+    finished.reset();
+
+    for (int i = 0; i < numWorkersToStart; ++i)
+        workers.getUnchecked (i)->start.signal();
+
+    processJobs (0);
+
+    // the workers are still finishing their last job, which usually takes less time
+    // than sleeping and being woken up
+    for (int i = 0; i < 1000 && numWorkersRunning.load() > 0; ++i)
+    {}
+
+    while (numWorkersRunning.load() > 0)
+        finished.wait (-1);
+}
+
+void RenderingThreadPool::processJobs (int threadIndex) noexcept
+{
+    for (;;)
+    {
+        auto jobIndex = nextJob++;
+
+        if (jobIndex >= numJobsToRun)
+            return;
+
+        jobCallback (jobContext, jobIndex, threadIndex);
+    }
+}
+
+} // namespace juce
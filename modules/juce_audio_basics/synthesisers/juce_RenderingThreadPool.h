@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of real-time threads which runs a number of jobs in parallel, used by
+    the synthesisers to render their voices on several cores.
+
+    The thread calling run() takes part in the jobs, and waits until the worker
+    threads have finished them all. The jobs are handed out one at a time with an
+    atomic counter, so a slow job doesn't hold back the others, and running them
+    doesn't allocate any memory.
+
+    @code
+    RenderingThreadPool pool (3);
+
+    auto renderVoice = [&] (int voiceIndex, int threadIndex)
+    {
+        voices[voiceIndex]->renderNextBlock (mixBuffers[threadIndex], 0, numSamples);
+    };
+
+    pool.run (voices.size(), renderVoice);
+    @endcode
+
+    @see Synthesiser::setParallelVoiceRendering
+
+    @tags{Audio}
+*/
+class JUCE_API  RenderingThreadPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool and starts its worker threads, which run in addition to the
+        thread calling run(). The worker threads use the real-time audio priority.
+    */
+    explicit RenderingThreadPool (int numWorkerThreads);
+
+    /** Destructor, which stops the worker threads. */
+    ~RenderingThreadPool();
+
+    //==============================================================================
+    /** Returns the number of threads running the jobs, including the thread
+        calling run(). The thread indexes given to the jobs are lower than this.
+    */
+    int getNumThreads() const noexcept                  { return workers.size() + 1; }
+
+    /** Calls a function for every job index from 0 to numJobs - 1 on the threads of
+        the pool, and returns when they have all been run.
+
+        The function is called as function (jobIndex, threadIndex), where the thread
+        index is 0 for the calling thread, so that each thread can use its own data.
+        It mustn't be called by more than one thread at a time.
+    */
+    template <typename JobFunction>
+    void run (int numJobs, JobFunction& function) noexcept
+    {
+        runJobs (numJobs, &function, [] (void* context, int jobIndex, int threadIndex)
+                                     {
+                                         (*static_cast<JobFunction*> (context)) (jobIndex, threadIndex);
+                                     });
+    }
+
+private:
+    //==============================================================================
+    using JobCallback = void (*) (void*, int, int);
+
+    struct Worker;
+    friend struct Worker;
+
+    void runJobs (int numJobs, void* context, JobCallback) noexcept;
+    void processJobs (int threadIndex) noexcept;
+
+    OwnedArray<Worker> workers;
+    WaitableEvent finished;
+
+    std::atomic<int> nextJob { 0 }, numWorkersRunning { 0 };
+    int numJobsToRun = 0;
+    void* jobContext = nullptr;
+    JobCallback jobCallback = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderingThreadPool)
+};
+
+} // namespace juce
@@ -72,6 +72,23 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+struct Synthesiser::MixBuffer
+{
+    template <typename floatType>
+    AudioBuffer<floatType>& getBuffer() noexcept;
+
+    AudioBuffer<float> floatBuffer;
+    AudioBuffer<double> doubleBuffer;
+    bool isUsed = false;
+};
+
+template <>
+AudioBuffer<float>& Synthesiser::MixBuffer::getBuffer<float>() noexcept     { return floatBuffer; }
+
+template <>
+AudioBuffer<double>& Synthesiser::MixBuffer::getBuffer<double>() noexcept   { return doubleBuffer; }
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -94,18 +111,27 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    numActiveVoices = 0;
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
+    activeVoices.realloc ((size_t) voices.size() + 1);
     return voices.add (newVoice);
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
+
+    if (auto* voice = voices[index])
+    {
+        auto* end = std::remove (activeVoices.get(), activeVoices + numActiveVoices, voice);
+        numActiveVoices = (int) (end - activeVoices.get());
+    }
+
     voices.remove (index);
 }
 
@@ -139,6 +165,78 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setLockFreeRendering (bool shouldRenderWithoutLocking) noexcept
+{
+    const ScopedLock sl (lock);
+    lockFreeRendering = shouldRenderWithoutLocking;
+}
+
+void Synthesiser::setParallelVoiceRendering (int numWorkerThreads, int maximumBlockSize, int numChannels)
+{
+    jassert (numWorkerThreads >= 0 && maximumBlockSize > 0 && numChannels > 0);
+
+    std::unique_ptr<RenderingThreadPool> newPool;
+    OwnedArray<MixBuffer> newMixBuffers;
+
+    if (numWorkerThreads > 0)
+    {
+        newPool.reset (new RenderingThreadPool (numWorkerThreads));
+
+        for (int i = 0; i < newPool->getNumThreads(); ++i)
+        {
+            auto* mixBuffer = newMixBuffers.add (new MixBuffer());
+            mixBuffer->floatBuffer.setSize (numChannels, maximumBlockSize);
+            mixBuffer->doubleBuffer.setSize (numChannels, maximumBlockSize);
+        }
+    }
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (renderingPool, newPool);
+        mixBuffers.swapWith (newMixBuffers);
+    }
+}
+
+bool Synthesiser::postMidiMessage (const MidiMessage& message)
+{
+    auto size = message.getRawDataSize();
+
+    // only short messages can be queued
+    jassert (size > 0 && size <= 3);
+
+    if (size <= 0 || size > 3)
+        return false;
+
+    const SpinLock::ScopedLockType sl (messageQueueWriteLock);
+
+    int start1, size1, start2, size2;
+    messageQueueFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+        return false;
+
+    auto& queued = messageQueue[start1];
+    memcpy (queued.data, message.getRawData(), (size_t) size);
+    queued.size = (uint8) size;
+
+    messageQueueFifo.finishedWrite (1);
+    return true;
+}
+
+void Synthesiser::handleQueuedMessages()
+{
+    int start1, size1, start2, size2;
+    messageQueueFifo.prepareToRead (messageQueueFifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        auto& queued = messageQueue[i < size1 ? start1 + i : start2 + i - size1];
+        handleMidiEvent (MidiMessage (queued.data, queued.size));
+    }
+
+    messageQueueFifo.finishedRead (size1 + size2);
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -161,6 +259,24 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
 {
     // must set the sample rate before using this!
     jassert (sampleRate != 0);
+
+    if (lockFreeRendering)
+    {
+        renderBlock (outputAudio, midiData, startSample, numSamples);
+    }
+    else
+    {
+        const ScopedLock sl (lock);
+        renderBlock (outputAudio, midiData, startSample, numSamples);
+    }
+}
+
+template <typename floatType>
+void Synthesiser::renderBlock (AudioBuffer<floatType>& outputAudio,
+                               const MidiBuffer& midiData,
+                               int startSample,
+                               int numSamples)
+{
     const int targetChannels = outputAudio.getNumChannels();
 
     MidiBuffer::Iterator midiIterator (midiData);
@@ -170,7 +286,7 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
     int midiEventPos;
     MidiMessage m;
 
-    const ScopedLock sl (lock);
+    handleQueuedMessages();
 
     while (numSamples > 0)
     {
@@ -219,16 +335,88 @@ template void Synthesiser::processNextBlock<double> (AudioBuffer<double>&, const
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (lockFreeRendering)
+    {
+        renderActiveVoices (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (lockFreeRendering)
+    {
+        renderActiveVoices (buffer, startSample, numSamples);
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
+template <typename floatType>
+void Synthesiser::renderActiveVoices (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    auto numChannels = buffer.getNumChannels();
+
+    if (renderingPool == nullptr || numActiveVoices < 2
+         || numSamples > mixBuffers.getFirst()->template getBuffer<floatType>().getNumSamples()
+         || numChannels > mixBuffers.getFirst()->template getBuffer<floatType>().getNumChannels())
+    {
+        for (int i = 0; i < numActiveVoices; ++i)
+            activeVoices[i]->renderNextBlock (buffer, startSample, numSamples);
+    }
+    else
+    {
+        auto renderVoice = [this, numChannels, numSamples] (int voiceIndex, int threadIndex)
+        {
+            auto* mixBuffer = mixBuffers.getUnchecked (threadIndex);
+            auto& data = mixBuffer->template getBuffer<floatType>();
+
+            if (! mixBuffer->isUsed)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                    data.clear (channel, 0, numSamples);
+
+                mixBuffer->isUsed = true;
+            }
+
+            // the voice sees a buffer with the same number of channels as the output
+            AudioBuffer<floatType> output (data.getArrayOfWritePointers(), numChannels, numSamples);
+            activeVoices[voiceIndex]->renderNextBlock (output, 0, numSamples);
+        };
+
+        renderingPool->run (numActiveVoices, renderVoice);
+
+        // the mix buffers are always added in the same order
+        for (auto* mixBuffer : mixBuffers)
+        {
+            if (mixBuffer->isUsed)
+            {
+                auto& data = mixBuffer->template getBuffer<floatType>();
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    buffer.addFrom (channel, startSample, data, channel, 0, numSamples);
+
+                mixBuffer->isUsed = false;
+            }
+        }
+    }
+
+    removeInactiveVoices();
+}
+
+void Synthesiser::removeInactiveVoices() noexcept
+{
+    auto* end = std::remove_if (activeVoices.get(), activeVoices + numActiveVoices,
+                                [] (SynthesiserVoice* voice) { return ! voice->isVoiceActive(); });
+
+    numActiveVoices = (int) (end - activeVoices.get());
+}
+
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
 {
     const int channel = m.getChannel();
@@ -313,6 +501,12 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
 
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
+
+        if (std::find (activeVoices.get(), activeVoices + numActiveVoices, voice) == activeVoices + numActiveVoices)
+        {
+            jassert (numActiveVoices < voices.size());
+            activeVoices[numActiveVoices++] = voice;
+        }
     }
 }
 
@@ -571,4 +765,206 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SynthesiserTests  : public UnitTest
+{
+    SynthesiserTests() : UnitTest ("Synthesiser", "Audio") {}
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // a sine wave which fades out over a fixed number of samples when released
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override    { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0;
+            increment = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+            level = velocity;
+            tailLeft = -1;
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+                tailLeft = tailLength;
+            else
+                clearCurrentNote();
+        }
+
+        void pitchWheelMoved (int) override {}
+        void controllerMoved (int, int) override {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            ++numRenderCalls;
+
+            for (int i = startSample; i < startSample + numSamples && isVoiceActive(); ++i)
+            {
+                auto gain = tailLeft >= 0 ? level * (float) tailLeft / (float) tailLength : level;
+                auto sample = gain * (float) std::sin (phase);
+                phase += increment;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, sample * (float) (channel + 1));
+
+                if (tailLeft >= 0 && --tailLeft == 0)
+                    clearCurrentNote();
+            }
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        static constexpr int tailLength = 100;
+        double phase = 0, increment = 0;
+        float level = 0;
+        int tailLeft = -1, numRenderCalls = 0;
+    };
+
+    static void prepare (Synthesiser& synth, int numVoices)
+    {
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setLockFreeRendering (true);
+    }
+
+    static TestVoice& getTestVoice (Synthesiser& synth, int index)
+    {
+        return *static_cast<TestVoice*> (synth.getVoice (index));
+    }
+
+    static int getNumActiveVoices (Synthesiser& synth)
+    {
+        int numActive = 0;
+
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->isVoiceActive())
+                ++numActive;
+
+        return numActive;
+    }
+
+    void runTest() override
+    {
+        const int blockSize = 256;
+
+        beginTest ("Parallel rendering");
+        {
+            Synthesiser serial, parallel;
+            prepare (serial, 8);
+            prepare (parallel, 8);
+            parallel.setParallelVoiceRendering (3, blockSize, 2);
+
+            MidiBuffer midi;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                midi.addEvent (MidiMessage::noteOn (1, 48 + i * 3, 0.1f + 0.1f * (float) i), i * 300);
+                midi.addEvent (MidiMessage::noteOff (1, 48 + i * 3), 2500 + i * 200);
+            }
+
+            AudioBuffer<float> serialOutput (2, blockSize), parallelOutput (2, blockSize);
+            float maxDifference = 0;
+
+            for (int block = 0; block < 20; ++block)
+            {
+                MidiBuffer blockMidi;
+                blockMidi.addEvents (midi, block * blockSize, blockSize, -block * blockSize);
+
+                serialOutput.clear();
+                parallelOutput.clear();
+                serial.renderNextBlock (serialOutput, blockMidi, 0, blockSize);
+                parallel.renderNextBlock (parallelOutput, blockMidi, 0, blockSize);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        maxDifference = jmax (maxDifference, std::abs (serialOutput.getSample (channel, i)
+                                                                         - parallelOutput.getSample (channel, i)));
+            }
+
+            expect (maxDifference < 1.0e-5f);
+            expectEquals (getNumActiveVoices (parallel), getNumActiveVoices (serial));
+        }
+
+        beginTest ("Posted messages");
+        {
+            Synthesiser synth;
+            prepare (synth, 4);
+
+            AudioBuffer<float> output (2, blockSize);
+            MidiBuffer noMidi;
+
+            expect (synth.postMidiMessage (MidiMessage::noteOn (1, 60, 0.5f)));
+            expect (synth.postMidiMessage (MidiMessage::noteOn (1, 64, 0.5f)));
+            expectEquals (getNumActiveVoices (synth), 0);
+
+            output.clear();
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+            expectEquals (getNumActiveVoices (synth), 2);
+            expect (output.getMagnitude (0, blockSize) > 0.1f);
+
+            expect (synth.postMidiMessage (MidiMessage::noteOff (1, 60)));
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+            expectEquals (getNumActiveVoices (synth), 1);
+        }
+
+        beginTest ("Finished voices aren't rendered");
+        {
+            Synthesiser synth;
+            prepare (synth, 4);
+
+            AudioBuffer<float> output (2, blockSize);
+            MidiBuffer noMidi;
+
+            synth.postMidiMessage (MidiMessage::noteOn (1, 60, 0.5f));
+            synth.postMidiMessage (MidiMessage::noteOn (1, 67, 0.5f));
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+
+            int stopped = -1, playing = -1;
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+            {
+                if (synth.getVoice (i)->getCurrentlyPlayingNote() == 60)  stopped = i;
+                if (synth.getVoice (i)->getCurrentlyPlayingNote() == 67)  playing = i;
+            }
+
+            expect (stopped >= 0 && playing >= 0);
+
+            // the tail ends during the next block, after which the voice is no longer rendered
+            synth.postMidiMessage (MidiMessage::noteOff (1, 60));
+            synth.renderNextBlock (output, noMidi, 0, blockSize);
+            expect (! synth.getVoice (stopped)->isVoiceActive());
+
+            auto numStoppedCalls = getTestVoice (synth, stopped).numRenderCalls;
+            auto numPlayingCalls = getTestVoice (synth, playing).numRenderCalls;
+
+            for (int block = 0; block < 4; ++block)
+                synth.renderNextBlock (output, noMidi, 0, blockSize);
+
+            expectEquals (getTestVoice (synth, stopped).numRenderCalls, numStoppedCalls);
+            expectEquals (getTestVoice (synth, playing).numRenderCalls, numPlayingCalls + 4);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                if (i != stopped && i != playing)
+                    expectEquals (getTestVoice (synth, i).numRenderCalls, 0);
+        }
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
+
 } // namespace juce
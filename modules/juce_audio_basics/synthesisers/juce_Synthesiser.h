@@ -568,6 +568,60 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Enables a rendering mode which doesn't lock the synthesiser.
+
+        In this mode, renderNextBlock() doesn't take the lock, and the default renderVoices()
+        only renders the voices which are playing, so that a synthesiser with many voices
+        doesn't spend any time on the idle ones. The note and controller methods mustn't
+        be called by other threads while the synthesiser is rendering: use postMidiMessage()
+        instead, and only add or remove voices and sounds when it isn't rendering.
+
+        The voices must be started by startVoice(), as noteOn() does, so that they are added
+        to the list of playing voices.
+
+        @see setParallelVoiceRendering, postMidiMessage
+    */
+    void setLockFreeRendering (bool shouldRenderWithoutLocking) noexcept;
+
+    /** Returns true if the lock-free rendering mode is enabled.
+        @see setLockFreeRendering
+    */
+    bool isLockFreeRenderingEnabled() const noexcept                { return lockFreeRendering.load(); }
+
+    /** Renders the playing voices in parallel on a pool of worker threads, when the
+        lock-free rendering mode is enabled.
+
+        Each thread adds the voices it renders to its own mix buffer, and these buffers
+        are then added to the output, so the voices mustn't modify any data that they
+        share while rendering.
+
+        This creates the threads and allocates the mix buffers, so it should be called
+        before rendering starts, for instance in prepareToPlay(). Blocks longer than the
+        maximum block size or with more channels are rendered on the audio thread.
+
+        The new pool replaces the previous one under the synthesiser's lock, which the
+        lock-free rendering mode doesn't take, so in that mode this mustn't be called
+        while the synthesiser is rendering.
+
+        @param numWorkerThreads     the number of threads used in addition to the audio
+                                    thread, or 0 to render all the voices on the audio thread
+        @param maximumBlockSize     the maximum number of samples rendered at once
+        @param numChannels          the number of channels of the output buffer
+    */
+    void setParallelVoiceRendering (int numWorkerThreads, int maximumBlockSize, int numChannels);
+
+    /** Adds a MIDI message to a queue of messages which are handled at the start of the
+        next rendered block, before the ones of the block's MIDI buffer.
+
+        This doesn't take the synthesiser's lock, so a user interface thread can use it to
+        play notes or move controllers without blocking the audio thread. Only short
+        messages of up to 3 bytes can be queued.
+
+        @returns false if the message couldn't be queued because the queue is full
+    */
+    bool postMidiMessage (const MidiMessage& message);
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -637,6 +691,19 @@ private:
                            const MidiBuffer& inputMidi,
                            int startSample,
                            int numSamples);
+
+    template <typename floatType>
+    void renderBlock (AudioBuffer<floatType>& outputAudio,
+                      const MidiBuffer& inputMidi,
+                      int startSample,
+                      int numSamples);
+
+    template <typename floatType>
+    void renderActiveVoices (AudioBuffer<floatType>& outputAudio,
+                             int startSample, int numSamples);
+
+    void handleQueuedMessages();
+    void removeInactiveVoices() noexcept;
     //==============================================================================
     double sampleRate = 0;
     uint32 lastNoteOnCounter = 0;
@@ -645,6 +712,29 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    // the voices started by startVoice(), in the order in which they were started, which
+    // are removed from the list when they stop playing in the lock-free rendering mode
+    HeapBlock<SynthesiserVoice*> activeVoices;
+    int numActiveVoices = 0;
+    std::atomic<bool> lockFreeRendering { false };
+
+    struct MixBuffer;
+    std::unique_ptr<RenderingThreadPool> renderingPool;
+    OwnedArray<MixBuffer> mixBuffers;
+
+    // the messages posted by other threads, which take the spin lock between themselves
+    // so that the audio thread never has to
+    struct QueuedMessage
+    {
+        uint8 data[3];
+        uint8 size;
+    };
+
+    enum { messageQueueSize = 1024 };
+    QueuedMessage messageQueue[messageQueueSize];
+    AbstractFifo messageQueueFifo { messageQueueSize };
+    SpinLock messageQueueWriteLock;
+
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for these methods.
     virtual int findFreeVoice (const bool) const { return 0; }
@@ -153,6 +153,16 @@ void CPUInformation::initialise() noexcept
     hasAVX   = flags.contains ("avx");
     hasAVX2  = flags.contains ("avx2");
 
+    // these names are prefixes of other flags, so they must match a whole token
+    auto flagTokens = StringArray::fromTokens (flags, false);
+    hasFMA3    = flagTokens.contains ("fma");
+    hasAVX512F = flagTokens.contains ("avx512f");
+
+   #if JUCE_INTEL && ! JUCE_NO_INLINE_ASM
+    // the kernel doesn't list osxsave, but it enables XSAVE whenever it lists it
+    checkOSSupportForAVX (flagTokens.contains ("xsave"));
+   #endif
+
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
     // Assume CPUs in all sockets have the same number of cores
@@ -54,9 +54,9 @@ namespace SystemStatsHelpers
         asm ("mov %%ebx, %%esi \n\t"
              "cpuid \n\t"
              "xchg %%esi, %%ebx"
-               : "=a" (la), "=S" (lb), "=c" (lc), "=d" (ld) : "a" (type)
+               : "=a" (la), "=S" (lb), "=c" (lc), "=d" (ld) : "a" (type), "c" (lc)
            #if JUCE_64BIT
-                  , "b" (lb), "c" (lc), "d" (ld)
+                  , "b" (lb), "d" (ld)
            #endif
         );
 
@@ -81,9 +81,16 @@ void CPUInformation::initialise() noexcept
     hasSSE41 = (c & (1u << 19)) != 0;
     hasSSE42 = (c & (1u << 20)) != 0;
     hasAVX   = (c & (1u << 28)) != 0;
+    hasFMA3  = (c & (1u << 12)) != 0;
 
+    const bool hasOSXSAVE = (c & (1u << 27)) != 0;
+
+    c = 0; // sub-leaf
     SystemStatsHelpers::doCPUID (a, b, c, d, 7);
-    hasAVX2  = (b & (1u <<  5)) != 0;
+    hasAVX2    = (b & (1u <<  5)) != 0;
+    hasAVX512F = (b & (1u << 16)) != 0;
+
+    checkOSSupportForAVX (hasOSXSAVE);
    #endif
 
     numLogicalCPUs = (int) [[NSProcessInfo processInfo] activeProcessorCount];
@@ -25,6 +25,7 @@ namespace juce
 
 #if ! JUCE_MINGW
  #pragma intrinsic (__cpuid)
+ #pragma intrinsic (__cpuidex)
  #pragma intrinsic (__rdtsc)
 #endif
 
@@ -42,28 +43,29 @@ void Logger::outputDebugString (const String& text)
 //==============================================================================
 
 #if JUCE_MINGW
-static void callCPUID (int result[4], uint32 type)
+static void callCPUID (int result[4], uint32 type, uint32 subLeaf = 0)
 {
   uint32 la = result[0], lb = result[1], lc = result[2], ld = result[3];
 
   asm ("mov %%ebx, %%esi \n\t"
        "cpuid \n\t"
        "xchg %%esi, %%ebx"
-       : "=a" (la), "=S" (lb), "=c" (lc), "=d" (ld) : "a" (type)
+       : "=a" (la), "=S" (lb), "=c" (lc), "=d" (ld) : "a" (type), "c" (subLeaf)
         #if JUCE_64BIT
-     , "b" (lb), "c" (lc), "d" (ld)
+     , "b" (lb), "d" (ld)
         #endif
        );
 
   result[0] = la; result[1] = lb; result[2] = lc; result[3] = ld;
 }
 #else
-static void callCPUID (int result[4], int infoType)
+static void callCPUID (int result[4], int infoType, int subLeaf = 0)
 {
    #if JUCE_PROJUCER_LIVE_BUILD
+    ignoreUnused (infoType, subLeaf);
     std::fill (result, result + 4, 0);
    #else
-    __cpuid (result, infoType);
+    __cpuidex (result, infoType, subLeaf);
    #endif
 }
 #endif
@@ -148,10 +150,16 @@ void CPUInformation::initialise() noexcept
     hasSSE41 = (info[2] & (1 << 19)) != 0;
     hasSSE42 = (info[2] & (1 << 20)) != 0;
     has3DNow = (info[1] & (1 << 31)) != 0;
+    hasFMA3  = (info[2] & (1 << 12)) != 0;
 
-    callCPUID (info, 7);
+    const bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
 
-    hasAVX2 = (info[1] & (1 << 5)) != 0;
+    callCPUID (info, 7, 0);
+
+    hasAVX2    = (info[1] & (1 <<  5)) != 0;
+    hasAVX512F = (info[1] & (1 << 16)) != 0;
+
+    checkOSSupportForAVX (hasOSXSAVE);
 
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
@@ -90,11 +90,47 @@ struct CPUInformation
 
     void initialise() noexcept;
 
+   #if JUCE_INTEL
+    /** Reads the XCR0 register, which tells which register states the OS saves.
+        This must only be called if the CPU reports the OSXSAVE feature.
+    */
+    static uint64 readXCR0() noexcept
+    {
+       #if JUCE_MSVC && ! JUCE_PROJUCER_LIVE_BUILD
+        return (uint64) _xgetbv (0);
+       #elif (JUCE_GCC || JUCE_CLANG) && ! JUCE_NO_INLINE_ASM
+        uint32 lo = 0, hi = 0;
+        asm volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        return (((uint64) hi) << 32) | lo;
+       #else
+        return 0;
+       #endif
+    }
+
+    /** The AVX instructions can only be used if the OS saves their registers on
+        context switches: the YMM state for AVX, AVX2 and FMA3, and also the opmask
+        and ZMM states for AVX-512. This clears the flags of the unusable ones.
+    */
+    void checkOSSupportForAVX (bool hasOSXSAVE) noexcept
+    {
+        auto xcr0 = hasOSXSAVE ? readXCR0() : 0;
+
+        const bool hasYMMState = (xcr0 & 0x06) == 0x06;   // SSE and AVX
+        const bool hasZMMState = (xcr0 & 0xe6) == 0xe6;   // SSE, AVX, opmask, ZMM0-15 and ZMM16-31
+
+        hasAVX     = hasAVX     && hasYMMState;
+        hasAVX2    = hasAVX2    && hasYMMState;
+        hasFMA3    = hasFMA3    && hasYMMState;
+        hasAVX512F = hasAVX512F && hasZMMState;
+    }
+   #endif
+
     int numLogicalCPUs = 0, numPhysicalCPUs = 0;
 
     bool hasMMX = false, hasSSE = false, hasSSE2 = false, hasSSE3 = false,
          has3DNow = false, hasSSSE3 = false, hasSSE41 = false,
-         hasSSE42 = false, hasAVX = false, hasAVX2 = false, hasNeon = false;
+         hasSSE42 = false, hasAVX = false, hasAVX2 = false, hasFMA3 = false,
+         hasAVX512F = false, hasNeon = false;
 };
 
 static const CPUInformation& getCPUInformation() noexcept
@@ -115,6 +151,8 @@ bool SystemStats::hasSSE41() noexcept           { return getCPUInformation().has
 bool SystemStats::hasSSE42() noexcept           { return getCPUInformation().hasSSE42; }
 bool SystemStats::hasAVX() noexcept             { return getCPUInformation().hasAVX; }
 bool SystemStats::hasAVX2() noexcept            { return getCPUInformation().hasAVX2; }
+bool SystemStats::hasFMA3() noexcept            { return getCPUInformation().hasFMA3; }
+bool SystemStats::hasAVX512F() noexcept         { return getCPUInformation().hasAVX512F; }
 bool SystemStats::hasNeon() noexcept            { return getCPUInformation().hasNeon; }
 
 
@@ -176,8 +176,10 @@ public:
     static bool hasSSSE3() noexcept;  /**< Returns true if Intel SSSE3 instructions are available. */
     static bool hasSSE41() noexcept;  /**< Returns true if Intel SSE4.1 instructions are available. */
     static bool hasSSE42() noexcept;  /**< Returns true if Intel SSE4.2 instructions are available. */
-    static bool hasAVX() noexcept;    /**< Returns true if Intel AVX instructions are available. */
-    static bool hasAVX2() noexcept;   /**< Returns true if Intel AVX2 instructions are available. */
+    static bool hasAVX() noexcept;    /**< Returns true if Intel AVX instructions are available and enabled by the OS. */
+    static bool hasAVX2() noexcept;   /**< Returns true if Intel AVX2 instructions are available and enabled by the OS. */
+    static bool hasFMA3() noexcept;   /**< Returns true if Intel FMA3 instructions are available and enabled by the OS. */
+    static bool hasAVX512F() noexcept; /**< Returns true if Intel AVX-512 Foundation instructions are available and enabled by the OS. */
     static bool hasNeon() noexcept;   /**< Returns true if ARM NEON instructions are available. */
 
     //==============================================================================
@@ -239,6 +239,21 @@ public:
         }
     };
 
+    struct Division
+    {
+        template <typename typeOne, typename typeTwo>
+        static void inplace (typeOne& a, const typeTwo& b)
+        {
+            a /= b;
+        }
+
+        template <typename typeOne, typename typeTwo>
+        static typeOne outofplace (const typeOne& a, const typeTwo& b)
+        {
+            return a / b;
+        }
+    };
+
     struct BitAND
     {
         template <typename typeOne, typename typeTwo>
@@ -713,6 +728,32 @@ public:
         }
     };
 
+    struct CheckTruncate
+    {
+        template <typename type>
+        static void run (UnitTest& u, Random& random)
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                type array_a [SIMDRegister<type>::SIMDNumElements];
+                type array_t [SIMDRegister<type>::SIMDNumElements];
+
+                SIMDRegister_test_internal::VecFiller<type>::fill (array_a, SIMDRegister<type>::SIMDNumElements, random);
+
+                // some values which don't fit in a 32-bit integer
+                array_a[0] = static_cast<type> (1.0e10 * (random.nextFloat() - 0.5));
+
+                for (size_t j = 0; j < SIMDRegister<type>::SIMDNumElements; ++j)
+                    array_t[j] = std::trunc (array_a[j]);
+
+                SIMDRegister<type> a;
+                copy (a, array_a);
+
+                u.expect (vecEqualToArray (SIMDRegister<type>::truncate (a), array_t));
+            }
+        }
+    };
+
     struct CheckSum
     {
         template <typename type>
@@ -813,6 +854,17 @@ public:
         TheTest::template run<uint64_t>(*this, random);
     }
 
+    template <class TheTest>
+    void runTestFloatingPoint (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        Random random = getRandom();
+
+        TheTest::template run<float>   (*this, random);
+        TheTest::template run<double>  (*this, random);
+    }
+
     void runTest()
     {
         runTestForAllTypes<InitializationTest> ("InitializationTest");
@@ -822,6 +874,7 @@ public:
         runTestForAllTypes<OperatorTests<Addition>> ("AdditionOperators");
         runTestForAllTypes<OperatorTests<Subtraction>> ("SubtractionOperators");
         runTestForAllTypes<OperatorTests<Multiplication>> ("MultiplicationOperators");
+        runTestFloatingPoint<OperatorTests<Division>> ("DivisionOperators");
 
         runTestForAllTypes<BitOperatorTests<BitAND>> ("BitANDOperators");
         runTestForAllTypes<BitOperatorTests<BitOR>>  ("BitOROperators");
@@ -830,6 +883,7 @@ public:
         runTestNonComplex<CheckComparisonOps> ("CheckComparisons");
         runTestNonComplex<CheckBoolEquals> ("CheckBoolEquals");
         runTestNonComplex<CheckMinMax> ("CheckMinMax");
+        runTestFloatingPoint<CheckTruncate> ("CheckTruncate");
 
         runTestForAllTypes<CheckMultiplyAdd> ("CheckMultiplyAdd");
         runTestForAllTypes<CheckSum> ("CheckSum");
@@ -31,6 +31,11 @@ namespace dsp
 
 /** This class is the convolution engine itself, processing only one channel at
     a time of input signal.
+
+    When non-uniform partitioning is requested, the engine only convolves the
+    head of the impulse response with its uniform zero-latency algorithm, and
+    the rest of it is handled by a series of tail stages using progressively
+    larger partitions, whose FFTs can be computed on a background thread.
 */
 struct ConvolutionEngine
 {
@@ -67,6 +72,286 @@ struct ConvolutionEngine
 
         double sampleRate = 0;
         size_t maximumBufferSize = 0;
+
+        bool isNonUniform = false;
+        size_t headSizeInSamples = 0;
+    };
+
+    //==============================================================================
+    /** Convolves the input signal with a section of the impulse response starting
+        at least 2 * blockSize samples after its beginning, using uniform partitions
+        of blockSize samples and overlap-save.
+
+        The spectral processing of each input block is a job which only needs to be
+        done by the time the next block has been received, so it can be picked up
+        by a background thread. If that thread hasn't started it yet, the audio
+        thread performs the job itself. If it is still running it, the audio thread
+        doesn't wait: the stage outputs silence for this block, and the job is done
+        by the background thread along with the next one, which is queued in a
+        second slot. If the background thread is even later, the stage is reset
+        once it has finished, so that the following blocks stay aligned.
+    */
+    struct TailStage
+    {
+        TailStage (const float* impulse, size_t impulseSize, size_t stageBlockSize)
+            : blockSize (stageBlockSize), FFTSize (2 * stageBlockSize),
+              numPartitions ((impulseSize + stageBlockSize - 1) / stageBlockSize)
+        {
+            FFTobject.reset (new FFT (roundToInt (std::log2 (FFTSize))));
+
+            impulseSegments = AudioBlock<float> (impulseSegmentsData, numPartitions, FFTSize + 1);
+            inputSegments   = AudioBlock<float> (inputSegmentsData,   numPartitions, FFTSize + 1);
+            bufferFFT       = AudioBlock<float> (bufferFFTData,       1,             FFTSize * 2);
+
+            bufferWindow.setSize (1, static_cast<int> (FFTSize));
+            bufferInput.setSize  (1, static_cast<int> (blockSize));
+            bufferOutput.setSize (1, static_cast<int> (blockSize));
+
+            for (auto& job : jobs)
+            {
+                job.input.setSize  (1, static_cast<int> (FFTSize));
+                job.output.setSize (1, static_cast<int> (blockSize));
+            }
+
+            auto* fftData = bufferFFT.getChannelPointer (0);
+
+            for (size_t n = 0; n < numPartitions; ++n)
+            {
+                FloatVectorOperations::clear (fftData, static_cast<int> (FFTSize * 2));
+
+                auto numToCopy = jmin (blockSize, impulseSize - n * blockSize);
+                FloatVectorOperations::copy (fftData, impulse + n * blockSize, static_cast<int> (numToCopy));
+
+                FFTobject->performRealOnlyForwardTransform (fftData, true);
+                prepareForConvolution (fftData, FFTSize);
+
+                FloatVectorOperations::copy (impulseSegments.getChannelPointer (n), fftData, static_cast<int> (FFTSize + 1));
+            }
+
+            reset();
+        }
+
+        /** Clears the processing state. The state used by the jobs is only cleared
+            once none of them is running anymore, at the end of a later block.
+        */
+        void reset()
+        {
+            bufferWindow.clear();
+            bufferInput.clear();
+            bufferOutput.clear();
+
+            inputDataPos = 0;
+            needsReset = true;
+
+            resetJobsIfIdle();
+        }
+
+        /** Adds the contribution of this stage to the output buffer. */
+        void processSamples (const float* input, float* output, size_t numSamples, Thread* backgroundThread)
+        {
+            size_t numSamplesProcessed = 0;
+
+            auto* inputData  = bufferInput.getWritePointer (0);
+            auto* outputData = bufferOutput.getReadPointer (0);
+
+            while (numSamplesProcessed < numSamples)
+            {
+                auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
+
+                FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+                FloatVectorOperations::add (output + numSamplesProcessed, outputData + inputDataPos, static_cast<int> (numSamplesToProcess));
+
+                inputDataPos += numSamplesToProcess;
+                numSamplesProcessed += numSamplesToProcess;
+
+                if (inputDataPos == blockSize)
+                {
+                    // Slide the overlap-save window
+                    auto* window = bufferWindow.getWritePointer (0);
+                    FloatVectorOperations::copy (window, window + blockSize, static_cast<int> (blockSize));
+                    FloatVectorOperations::copy (window + blockSize, inputData, static_cast<int> (blockSize));
+
+                    // The result of the previous job is played during the next block
+                    collectLastJob();
+                    scheduleJob (backgroundThread);
+
+                    inputDataPos = 0;
+                }
+            }
+        }
+
+        /** Called by the background thread to run the pending jobs, in the order
+            in which they have been scheduled.
+        */
+        void performPendingJob()
+        {
+            for (;;)
+            {
+                auto index = nextJobToRun.load();
+                auto& job = jobs[index];
+                auto expected = (int) jobPending;
+
+                if (! job.state.compare_exchange_strong (expected, jobRunning))
+                    return;
+
+                performJob (job);
+
+                nextJobToRun = 1 - index;
+                job.state = jobDone;
+            }
+        }
+
+        /** Returns the number of blocks for which the result of a job wasn't ready. */
+        int getNumLateJobs() const noexcept         { return numLateJobs; }
+
+    private:
+        // the unit tests simulate a late background thread
+        friend class ConvolutionEngineTest;
+
+        //==============================================================================
+        struct Job
+        {
+            AudioBuffer<float> input, output;
+            std::atomic<int> state { jobIdle };
+        };
+
+        enum JobState
+        {
+            jobIdle = 0,
+            jobPending,
+            jobRunning,
+            jobDone
+        };
+
+        bool isJobBusy (const Job& job) const noexcept
+        {
+            auto state = job.state.load();
+            return state == jobPending || state == jobRunning;
+        }
+
+        void resetJobsIfIdle()
+        {
+            for (auto& job : jobs)
+            {
+                auto expected = (int) jobPending;
+                job.state.compare_exchange_strong (expected, jobIdle);
+            }
+
+            if (isJobBusy (jobs[0]) || isJobBusy (jobs[1]))
+                return;
+
+            inputSegments.clear();
+            currentSegment = 0;
+
+            for (auto& job : jobs)
+                job.state = jobIdle;
+
+            nextJobToRun = 0;
+            lastJob = -1;
+            needsReset = false;
+        }
+
+        void collectLastJob()
+        {
+            if (lastJob < 0 || needsReset)
+            {
+                bufferOutput.clear();
+                return;
+            }
+
+            // the audio thread does the job itself if the background thread hasn't started it
+            performPendingJob();
+
+            auto& job = jobs[lastJob];
+
+            if (job.state == jobDone)
+            {
+                bufferOutput.copyFrom (0, 0, job.output, 0, 0, static_cast<int> (blockSize));
+                job.state = jobIdle;
+            }
+            else
+            {
+                bufferOutput.clear();
+                ++numLateJobs;
+            }
+        }
+
+        void scheduleJob (Thread* backgroundThread)
+        {
+            if (needsReset)
+                resetJobsIfIdle();
+
+            auto index = lastJob < 0 ? nextJobToRun.load() : 1 - lastJob;
+            auto& job = jobs[index];
+
+            // the background thread is more than a block late, so the segment of this
+            // block can't be processed: the stage restarts from a cleared state instead
+            if (needsReset || isJobBusy (job))
+            {
+                needsReset = true;
+                return;
+            }
+
+            job.input.copyFrom (0, 0, bufferWindow, 0, 0, static_cast<int> (FFTSize));
+            job.state = jobPending;
+            lastJob = index;
+
+            if (backgroundThread != nullptr)
+                backgroundThread->notify();
+        }
+
+        void performJob (Job& job)
+        {
+            auto* fftData = bufferFFT.getChannelPointer (0);
+
+            // Forward FFT of the current window
+            FloatVectorOperations::copy (fftData, job.input.getReadPointer (0), static_cast<int> (FFTSize));
+            FFTobject->performRealOnlyForwardTransform (fftData, true);
+            prepareForConvolution (fftData, FFTSize);
+
+            FloatVectorOperations::copy (inputSegments.getChannelPointer (currentSegment), fftData, static_cast<int> (FFTSize + 1));
+
+            // Complex multiplication with all the partitions
+            FloatVectorOperations::fill (fftData, 0.0f, static_cast<int> (FFTSize + 1));
+
+            auto index = currentSegment;
+
+            for (size_t i = 0; i < numPartitions; ++i)
+            {
+                convolutionProcessingAndAccumulate (inputSegments.getChannelPointer (index),
+                                                    impulseSegments.getChannelPointer (i),
+                                                    fftData, FFTSize);
+
+                if (++index == numPartitions)
+                    index = 0;
+            }
+
+            // Inverse FFT, the second half of the result is the linear convolution
+            updateSymmetricFrequencyDomainData (fftData, FFTSize);
+            FFTobject->performRealOnlyInverseTransform (fftData);
+
+            job.output.copyFrom (0, 0, fftData + blockSize, static_cast<int> (blockSize));
+
+            currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numPartitions - 1);
+        }
+
+        //==============================================================================
+        std::unique_ptr<FFT> FFTobject;
+
+        const size_t blockSize, FFTSize, numPartitions;
+        size_t currentSegment = 0, inputDataPos = 0;
+
+        HeapBlock<char> impulseSegmentsData, inputSegmentsData, bufferFFTData;
+        AudioBlock<float> impulseSegments, inputSegments, bufferFFT;
+        AudioBuffer<float> bufferWindow, bufferInput, bufferOutput;
+
+        Job jobs[2];
+        std::atomic<int> nextJobToRun { 0 };
+        int lastJob = -1, numLateJobs = 0;
+        bool needsReset = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TailStage)
     };
 
     //==============================================================================
@@ -74,15 +359,29 @@ struct ConvolutionEngine
     {
         bufferInput.clear();
         bufferOverlap.clear();
-        bufferTempOutput.clear();
+        outputSpectra.clear();
+        inputSegments.clear();
 
-        for (auto i = 0; i < buffersInputSegments.size(); ++i)
-            buffersInputSegments.getReference (i).clear();
+        for (auto* stage : tailStages)
+            stage->reset();
 
         currentSegment = 0;
         inputDataPos = 0;
     }
 
+    /** Returns the number of tail blocks which have been replaced by silence
+        because the background thread was late.
+    */
+    int getNumLateTailJobs() const noexcept
+    {
+        int numLateJobs = 0;
+
+        for (auto* stage : tailStages)
+            numLateJobs += stage->getNumLateJobs();
+
+        return numLateJobs;
+    }
+
     /** Initalize all the states and objects to perform the convolution. */
     void initializeConvolutionEngine (ProcessingInformation& info, int channel)
     {
@@ -91,101 +390,137 @@ struct ConvolutionEngine
         FFTSize = blockSize > 128 ? 2 * blockSize
                                   : 4 * blockSize;
 
-        numSegments = ((size_t) info.finalSize) / (FFTSize - blockSize) + 1u;
+        auto impulseSize = (size_t) info.finalSize;
+        size_t headSize = 0;
+
+        if (info.isNonUniform)
+        {
+            auto wantedHeadSize = info.headSizeInSamples > 0 ? info.headSizeInSamples : 16 * blockSize;
+
+            headSize = jmax (4 * blockSize, jmin (2 * maximumTailBlockSize, (size_t) nextPowerOfTwo ((int) wantedHeadSize)));
+            impulseSize = jmin (impulseSize, headSize);
+        }
+
+        numSegments = impulseSize / (FFTSize - blockSize) + 1u;
 
         numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
 
         FFTobject.reset (new FFT (roundToInt (std::log2 (FFTSize))));
 
         bufferInput.setSize      (1, static_cast<int> (FFTSize));
-        bufferOutput.setSize     (1, static_cast<int> (FFTSize * 2));
-        bufferTempOutput.setSize (1, static_cast<int> (FFTSize * 2));
         bufferOverlap.setSize    (1, static_cast<int> (FFTSize));
 
-        buffersInputSegments.clear();
-        buffersImpulseSegments.clear();
-        bufferOutput.clear();
+        // the segments are stored in SIMD aligned channels of FFTSize * 2 samples
+        outputSpectra  = AudioBlock<float> (outputSpectraData,  2,                FFTSize * 2);
+        inputSegments  = AudioBlock<float> (inputSegmentsData,  numInputSegments, FFTSize * 2);
+        impulseSegments = AudioBlock<float> (impulseSegmentsData, numSegments,    FFTSize * 2);
 
-        for (size_t i = 0; i < numInputSegments; ++i)
-        {
-            AudioBuffer<float> newInputSegment;
-            newInputSegment.setSize (1, static_cast<int> (FFTSize * 2));
-            buffersInputSegments.add (newInputSegment);
-        }
+        auto* channelData = info.buffer->getWritePointer (channel);
+
+        updateImpulseSegments (channelData, impulseSize);
 
-        for (auto i = 0u; i < numSegments; ++i)
         {
-            AudioBuffer<float> newImpulseSegment;
-            newImpulseSegment.setSize (1, static_cast<int> (FFTSize * 2));
-            buffersImpulseSegments.add (newImpulseSegment);
+            const ScopedLock sl (tailStagesLock);
+
+            tailStages.clear();
+            bufferTail.setSize (1, static_cast<int> (blockSize));
+
+            // Each stage starts at twice its block size, so that the background
+            // thread has the duration of a whole block to process it
+            auto maxStageBlockSize = jmax (maximumTailBlockSize, headSize / 2);
+            auto stageBlockSize = headSize / 2;
+            auto stageStart = headSize;
+
+            while (info.isNonUniform && stageStart < (size_t) info.finalSize)
+            {
+                auto nextStageBlockSize = jmin (4 * stageBlockSize, maxStageBlockSize);
+                auto stageEnd = (nextStageBlockSize == stageBlockSize) ? (size_t) info.finalSize
+                                                                       : jmin ((size_t) info.finalSize, 2 * nextStageBlockSize);
+
+                tailStages.add (new TailStage (channelData + stageStart, stageEnd - stageStart, stageBlockSize));
+
+                stageStart = stageEnd;
+                stageBlockSize = nextStageBlockSize;
+            }
         }
 
-        std::unique_ptr<FFT> FFTTempObject (new FFT (roundToInt (std::log2 (FFTSize))));
+        reset();
 
-        auto* channelData = info.buffer->getWritePointer (channel);
+        isReady = true;
+    }
+
+    /** Computes the spectra of the segments of the uniformly partitioned part of
+        the impulse response. This can also be called after the initialisation to
+        change the impulse response without resetting the processing, provided that
+        the new one has the same size as the previous one.
+    */
+    void updateImpulseSegments (const float* impulse, size_t impulseSize)
+    {
+        jassert (numSegments == impulseSize / (FFTSize - blockSize) + 1u);
+
+        impulseSegments.clear();
 
         for (size_t n = 0; n < numSegments; ++n)
         {
-            buffersImpulseSegments.getReference (static_cast<int> (n)).clear();
-
-            auto* impulseResponse = buffersImpulseSegments.getReference (static_cast<int> (n)).getWritePointer (0);
+            auto* impulseResponse = impulseSegments.getChannelPointer (n);
 
             if (n == 0)
                 impulseResponse[0] = 1.0f;
 
             for (size_t i = 0; i < FFTSize - blockSize; ++i)
-                if (i + n * (FFTSize - blockSize) < (size_t) info.finalSize)
-                    impulseResponse[i] = channelData[i + n * (FFTSize - blockSize)];
+                if (i + n * (FFTSize - blockSize) < impulseSize)
+                    impulseResponse[i] = impulse[i + n * (FFTSize - blockSize)];
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+            FFTobject->performRealOnlyForwardTransform (impulseResponse, true);
+            prepareForConvolution (impulseResponse, FFTSize);
         }
-
-        reset();
-
-        isReady = true;
     }
 
-    /** Copy the states of another engine. */
-    void copyStateFromOtherEngine (const ConvolutionEngine& other)
+    /** Performs the convolution, adding the contribution of the tail stages if
+        non-uniform partitioning is used.
+    */
+    void processSamples (const float* input, float* output, size_t numSamples)
     {
-        if (FFTSize != other.FFTSize)
+        if (! isReady)
+            return;
+
+        if (tailStages.isEmpty())
         {
-            FFTobject.reset (new FFT (roundToInt (std::log2 (other.FFTSize))));
-            FFTSize = other.FFTSize;
+            processUniformSamples (input, output, numSamples);
+            return;
         }
 
-        currentSegment      = other.currentSegment;
-        numInputSegments    = other.numInputSegments;
-        numSegments         = other.numSegments;
-        blockSize           = other.blockSize;
-        inputDataPos        = other.inputDataPos;
+        auto* tailData = bufferTail.getWritePointer (0);
+        size_t numSamplesProcessed = 0;
 
-        bufferInput         = other.bufferInput;
-        bufferTempOutput    = other.bufferTempOutput;
-        bufferOutput        = other.bufferOutput;
+        while (numSamplesProcessed < numSamples)
+        {
+            auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize);
 
-        buffersInputSegments    = other.buffersInputSegments;
-        buffersImpulseSegments  = other.buffersImpulseSegments;
-        bufferOverlap           = other.bufferOverlap;
+            // the tail stages must read the input before the head overwrites it in place
+            FloatVectorOperations::clear (tailData, static_cast<int> (numSamplesToProcess));
 
-        isReady = true;
+            for (auto* stage : tailStages)
+                stage->processSamples (input + numSamplesProcessed, tailData, numSamplesToProcess, backgroundThread);
+
+            processUniformSamples (input + numSamplesProcessed, output + numSamplesProcessed, numSamplesToProcess);
+            FloatVectorOperations::add (output + numSamplesProcessed, tailData, static_cast<int> (numSamplesToProcess));
+
+            numSamplesProcessed += numSamplesToProcess;
+        }
     }
 
     /** Performs the uniform partitioned convolution using FFT. */
-    void processSamples (const float* input, float* output, size_t numSamples)
+    void processUniformSamples (const float* input, float* output, size_t numSamples)
     {
-        if (! isReady)
-            return;
-
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
 
         auto indexStep = numInputSegments / numSegments;
 
         auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
+        auto* outputData     = outputSpectra.getChannelPointer (0);
+        auto* outputTempData = outputSpectra.getChannelPointer (1);
         auto* overlapData    = bufferOverlap.getWritePointer (0);
 
         while (numSamplesProcessed < numSamples)
@@ -196,12 +531,12 @@ struct ConvolutionEngine
             // copy the input samples
             FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
 
-            auto* inputSegmentData = buffersInputSegments.getReference (static_cast<int> (currentSegment)).getWritePointer (0);
+            auto* inputSegmentData = inputSegments.getChannelPointer (currentSegment);
             FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (FFTSize));
 
             // Forward FFT
-            FFTobject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+            FFTobject->performRealOnlyForwardTransform (inputSegmentData, true);
+            prepareForConvolution (inputSegmentData, FFTSize);
 
             // Complex multiplication
             if (inputDataWasEmpty)
@@ -217,20 +552,20 @@ struct ConvolutionEngine
                     if (index >= numInputSegments)
                         index -= numInputSegments;
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (index)).getWritePointer (0),
-                                                        buffersImpulseSegments.getReference (static_cast<int> (i)).getWritePointer (0),
-                                                        outputTempData);
+                    convolutionProcessingAndAccumulate (inputSegments.getChannelPointer (index),
+                                                        impulseSegments.getChannelPointer (i),
+                                                        outputTempData, FFTSize);
                 }
             }
 
             FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
 
-            convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (currentSegment)).getWritePointer (0),
-                                                buffersImpulseSegments.getReference (0).getWritePointer (0),
-                                                outputData);
+            convolutionProcessingAndAccumulate (inputSegments.getChannelPointer (currentSegment),
+                                                impulseSegments.getChannelPointer (0),
+                                                outputData, FFTSize);
 
             // Inverse FFT
-            updateSymmetricFrequencyDomainData (outputData);
+            updateSymmetricFrequencyDomainData (outputData, FFTSize);
             FFTobject->performRealOnlyInverseTransform (outputData);
 
             // Add overlap
@@ -261,55 +596,94 @@ struct ConvolutionEngine
         }
     }
 
-    /** After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls. */
-    void prepareForConvolution (float *samples) noexcept
+    /** After each FFT, this function is called to store the positive frequencies in a
+        split-complex layout: the real parts of the bins 0 to FFTSize / 2 - 1, followed by
+        their imaginary parts, and the real part of the Nyquist bin at index FFTSize.
+
+        Only the positive frequencies are read, and the rest of the buffer of
+        FFTSize * 2 samples is used as scratch space.
+    */
+    static void prepareForConvolution (float* samples, size_t FFTSize) noexcept
     {
         auto FFTSizeDiv2 = FFTSize / 2;
+        auto* imaginary = samples + FFTSize + 2;
 
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
+        for (size_t i = 0; i < FFTSizeDiv2; ++i)
+        {
+            imaginary[i] = samples[2 * i + 1];
             samples[i] = samples[2 * i];
+        }
 
-        samples[FFTSizeDiv2] = 0;
+        imaginary[0] = 0;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[2 * (FFTSize - i) + 1];
+        FloatVectorOperations::copy (samples + FFTSizeDiv2, imaginary, static_cast<int> (FFTSizeDiv2));
     }
 
-    /** Does the convolution operation itself only on half of the frequency domain samples. */
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
+    /** Does the convolution operation itself only on half of the frequency domain samples,
+        with a single pass over the split-complex data.
+    */
+    static void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output, size_t FFTSize) noexcept
     {
         auto FFTSizeDiv2 = FFTSize / 2;
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+        auto* inputImag   = input   + FFTSizeDiv2;
+        auto* impulseImag = impulse + FFTSizeDiv2;
+        auto* outputImag  = output  + FFTSizeDiv2;
+
+        size_t i = 0;
+
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<float>;
+
+        if (FFTSizeDiv2 % Vec::size() == 0
+             && Vec::isSIMDAligned (input) && Vec::isSIMDAligned (impulse) && Vec::isSIMDAligned (output))
+        {
+            for (; i < FFTSizeDiv2; i += Vec::size())
+            {
+                auto inRe  = Vec::fromRawArray (input + i),   inIm  = Vec::fromRawArray (inputImag + i);
+                auto irRe  = Vec::fromRawArray (impulse + i), irIm  = Vec::fromRawArray (impulseImag + i);
+
+                auto outRe = Vec::multiplyAdd (Vec::fromRawArray (output + i) - inIm * irIm, inRe, irRe);
+                auto outIm = Vec::multiplyAdd (Vec::multiplyAdd (Vec::fromRawArray (outputImag + i), inRe, irIm), inIm, irRe);
+
+                outRe.copyToRawArray (output + i);
+                outIm.copyToRawArray (outputImag + i);
+            }
+        }
+       #endif
+
+        for (; i < FFTSizeDiv2; ++i)
+        {
+            auto inRe = input[i], inIm = inputImag[i];
+            auto irRe = impulse[i], irIm = impulseImag[i];
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+            output[i]     += inRe * irRe - inIm * irIm;
+            outputImag[i] += inRe * irIm + inIm * irRe;
+        }
 
         output[FFTSize] += input[FFTSize] * impulse[FFTSize];
     }
 
-    /** Undo the re-organization of samples from the function prepareForConvolution.
-        Then, takes the conjugate of the frequency domain first half of samples, to fill the
-        second half, so that the inverse transform will return real samples in the time domain.
+    /** Undo the re-organization of samples from the function prepareForConvolution,
+        so that the inverse transform will return real samples in the time domain.
+        Only the positive frequencies are written, which is all the real-only inverse
+        transform needs.
     */
-    void updateSymmetricFrequencyDomainData (float* samples) noexcept
+    static void updateSymmetricFrequencyDomainData (float* samples, size_t FFTSize) noexcept
     {
         auto FFTSizeDiv2 = FFTSize / 2;
+        auto* imaginary = samples + FFTSize + 2;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-        {
-            samples[2 * (FFTSize - i)] = samples[i];
-            samples[2 * (FFTSize - i) + 1] = -samples[FFTSizeDiv2 + i];
-        }
-
-        samples[1] = 0.f;
+        FloatVectorOperations::copy (imaginary, samples + FFTSizeDiv2, static_cast<int> (FFTSizeDiv2));
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        for (size_t i = FFTSizeDiv2; --i > 0;)
         {
-            samples[2 * i] = samples[2 * (FFTSize - i)];
-            samples[2 * i + 1] = -samples[2 * (FFTSize - i) + 1];
+            samples[2 * i + 1] = imaginary[i];
+            samples[2 * i]     = samples[i];
         }
+
+        samples[1] = 0.0f;
+        samples[FFTSize + 1] = 0.0f;
     }
 
     //==============================================================================
@@ -318,8 +692,17 @@ struct ConvolutionEngine
     size_t FFTSize = 0;
     size_t currentSegment = 0, numInputSegments = 0, numSegments = 0, blockSize = 0, inputDataPos = 0;
 
-    AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
-    Array<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+    AudioBuffer<float> bufferInput, bufferOverlap;
+
+    HeapBlock<char> outputSpectraData, inputSegmentsData, impulseSegmentsData;
+    AudioBlock<float> outputSpectra, inputSegments, impulseSegments;
+
+    OwnedArray<TailStage> tailStages;
+    CriticalSection tailStagesLock;
+    AudioBuffer<float> bufferTail;
+    Thread* backgroundThread = nullptr;
+
+    static constexpr size_t maximumTailBlockSize = 16384;
 
     bool isReady = false;
 
@@ -329,6 +712,50 @@ struct ConvolutionEngine
 
 
 
+//==============================================================================
+/** Performs the jobs of the tail stages of some non-uniform convolution engines,
+    so that the audio thread doesn't have to compute the large FFTs itself.
+*/
+struct ConvolutionBackgroundThread  : public Thread
+{
+    ConvolutionBackgroundThread()  : Thread ("Convolution tail") {}
+
+    ~ConvolutionBackgroundThread()
+    {
+        stopThread (10000);
+    }
+
+    void addEngine (ConvolutionEngine* engine)
+    {
+        jassert (! isThreadRunning());
+
+        engines.add (engine);
+        engine->backgroundThread = this;
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            for (auto* engine : engines)
+            {
+                // an engine being initialised can't be processed, but its stages aren't running either
+                const ScopedTryLock sl (engine->tailStagesLock);
+
+                if (sl.isLocked())
+                    for (auto* stage : engine->tailStages)
+                        stage->performPendingJob();
+            }
+        }
+    }
+
+    Array<ConvolutionEngine*> engines;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionBackgroundThread)
+};
+
 //==============================================================================
 /** Manages all the changes requested by the main convolution engine, to minimize
     the number of calls of the convolution engine initialization, and the potential
@@ -353,7 +780,7 @@ struct Convolution::Pimpl  : private Thread
     using SourceType = ConvolutionEngine::ProcessingInformation::SourceType;
 
     //==============================================================================
-    Pimpl()  : Thread ("Convolution"), abstractFifo (fifoSize)
+    Pimpl (bool isNonUniform, int headSizeInSamples)  : Thread ("Convolution"), abstractFifo (fifoSize)
     {
         abstractFifo.reset();
         fifoRequestsType.resize (fifoSize);
@@ -367,6 +794,18 @@ struct Convolution::Pimpl  : private Thread
 
         currentInfo.maximumBufferSize = 0;
         currentInfo.buffer = &impulseResponse;
+        currentInfo.isNonUniform = isNonUniform;
+        currentInfo.headSizeInSamples = (size_t) jmax (0, headSizeInSamples);
+
+        if (isNonUniform)
+        {
+            backgroundThread.reset (new ConvolutionBackgroundThread());
+
+            for (auto* e : engines)
+                backgroundThread->addEngine (e);
+
+            backgroundThread->startThread (8);
+        }
 
         temporaryBuffer.setSize (2, static_cast<int> (maximumTimeInSamples), false, false, true);
         impulseResponseOriginal.setSize (2, static_cast<int> (maximumTimeInSamples), false, false, true);
@@ -743,7 +1182,7 @@ struct Convolution::Pimpl  : private Thread
                 mustInterpolate = false;
 
                 for (auto channel = 0; channel < 2; ++channel)
-                    engines[channel]->copyStateFromOtherEngine (*engines[channel + 2]);
+                    engines.swap (channel, channel + 2);
             }
         }
 
@@ -1024,6 +1463,7 @@ private:
 
     //==============================================================================
     OwnedArray<ConvolutionEngine> engines;          // the 4 convolution engines being used
+    std::unique_ptr<ConvolutionBackgroundThread> backgroundThread;  // the thread processing the tail stages, if non-uniform
 
     AudioBuffer<float> interpolationBuffer;         // a buffer to do the interpolation between the convolution engines 0-1 and 2-3
     LinearSmoothedValue<float> changeVolumes[4];    // the volumes for each convolution engine during interpolation
@@ -1038,7 +1478,13 @@ private:
 //==============================================================================
 Convolution::Convolution()
 {
-    pimpl.reset (new Pimpl());
+    pimpl.reset (new Pimpl (false, 0));
+    pimpl->addToFifo (Convolution::Pimpl::ChangeRequest::changeEngine, juce::var (0));
+}
+
+Convolution::Convolution (const NonUniform& nonUniform)
+{
+    pimpl.reset (new Pimpl (true, nonUniform.headSizeInSamples));
     pimpl->addToFifo (Convolution::Pimpl::ChangeRequest::changeEngine, juce::var (0));
 }
 
@@ -43,6 +43,23 @@ namespace dsp
     efficient in general to do frequency domain convolution when the size of
     the impulse response is higher than 64 samples.
 
+    For long impulse responses, a non-uniform partitioning scheme can be
+    requested with the Convolution (const NonUniform&) constructor. The
+    beginning of the impulse response is then processed with small partitions
+    for zero latency, and the rest of it with progressively larger ones, whose
+    FFTs are computed on a background thread. This reduces a lot the average
+    CPU load of reverberation impulse responses lasting several seconds.
+
+    The audio thread never waits for that background thread. If the FFT of a tail
+    partition is still being computed when its result is needed, because the
+    machine is overloaded or the background thread doesn't get enough CPU time,
+    the section of the impulse response processed with that partition size is
+    replaced by silence for one partition. Its result is dropped, and the tail is
+    back from the next partition on. If the background thread is even later, that
+    section is cleared and builds up again over its length, so that the later
+    partitions stay aligned. Only the tail is affected: the beginning of the
+    impulse response is always processed on the audio thread.
+
     @see FIRFilter, FIRFilter::Coefficients, FFT
 
     @tags{DSP}
@@ -54,6 +71,26 @@ public:
     /** Initialises an object for performing convolution in the frequency domain. */
     Convolution();
 
+    /** Contains configuration information for a convolution with non-uniform
+        partitioning.
+    */
+    struct NonUniform
+    {
+        /** The number of samples at the start of the impulse response which are
+            processed with the smallest partitions. Set it to 0 to let the
+            convolution choose a size depending on the maximum buffer size.
+        */
+        int headSizeInSamples = 0;
+    };
+
+    /** Initialises an object for performing convolution in the frequency domain,
+        using a non-uniform partitioning scheme. The processing remains without
+        any latency, but the tail of the impulse response is processed with larger
+        FFTs, on a background thread owned by this object. See the description of
+        the class for what happens to the tail when that thread is late.
+    */
+    explicit Convolution (const NonUniform&);
+
     /** Destructor. */
     ~Convolution();
 
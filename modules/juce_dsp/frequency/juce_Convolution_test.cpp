@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class ConvolutionEngineTest : public UnitTest
+{
+    static void fillImpulse (AudioBuffer<float>& impulse, Random& random)
+    {
+        auto* data = impulse.getWritePointer (0);
+        auto numSamples = impulse.getNumSamples();
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = (random.nextFloat() * 2.0f - 1.0f) * std::exp (-4.0f * (float) i / (float) numSamples) * 0.05f;
+    }
+
+    static void initialise (ConvolutionEngine& engine, AudioBuffer<float>& impulse, size_t maximumBufferSize,
+                            bool isNonUniform, size_t headSizeInSamples)
+    {
+        ConvolutionEngine::ProcessingInformation info;
+        info.buffer = &impulse;
+        info.finalSize = impulse.getNumSamples();
+        info.maximumBufferSize = maximumBufferSize;
+        info.isNonUniform = isNonUniform;
+        info.headSizeInSamples = headSizeInSamples;
+
+        engine.initializeConvolutionEngine (info, 0);
+    }
+
+    /** Processes the input in blocks of random sizes. */
+    static void process (ConvolutionEngine& engine, const HeapBlock<float>& input, HeapBlock<float>& output,
+                         int numSamples, int maximumBufferSize, Random& random)
+    {
+        for (int pos = 0; pos < numSamples;)
+        {
+            auto numToProcess = jmin (numSamples - pos, 1 + random.nextInt (maximumBufferSize));
+
+            FloatVectorOperations::clear (output + pos, numToProcess);
+            engine.processSamples (input + pos, output + pos, (size_t) numToProcess);
+
+            pos += numToProcess;
+        }
+    }
+
+    static float* getSIMDAlignedPtr (float* ptr) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return SIMDRegister<float>::getNextSIMDAlignedPtr (ptr);
+       #else
+        return ptr;
+       #endif
+    }
+
+    static double getMaxDifference (const HeapBlock<float>& a, const HeapBlock<float>& b, int n)
+    {
+        double maxDifference = 0;
+
+        for (int i = 0; i < n; ++i)
+            maxDifference = jmax (maxDifference, (double) std::abs (a[i] - b[i]));
+
+        return maxDifference;
+    }
+
+public:
+    ConvolutionEngineTest() : UnitTest ("Convolution Engine", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        constexpr int maximumBufferSize = 256;
+        constexpr int numSamples = 65536;
+        constexpr double tolerance = 1.0e-4;
+
+        AudioBuffer<float> impulse (1, 40000);
+        fillImpulse (impulse, random);
+
+        HeapBlock<float> input (numSamples), uniformOutput (numSamples), nonUniformOutput (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            input[i] = random.nextFloat() * 2.0f - 1.0f;
+
+        ConvolutionEngine uniform;
+        initialise (uniform, impulse, maximumBufferSize, false, 0);
+        process (uniform, input, uniformOutput, numSamples, maximumBufferSize, random);
+
+        for (size_t headSize : { (size_t) 0, (size_t) 1024, (size_t) 8192 })
+        {
+            beginTest ("Non-uniform partitioning, head size " + String (headSize));
+
+            ConvolutionEngine nonUniform;
+            initialise (nonUniform, impulse, maximumBufferSize, true, headSize);
+            process (nonUniform, input, nonUniformOutput, numSamples, maximumBufferSize, random);
+
+            expectEquals (nonUniform.getNumLateTailJobs(), 0);
+            expectLessThan (getMaxDifference (uniformOutput, nonUniformOutput, numSamples), tolerance);
+        }
+
+        beginTest ("Non-uniform partitioning after reset");
+        {
+            ConvolutionEngine nonUniform;
+            initialise (nonUniform, impulse, maximumBufferSize, true, 1024);
+            process (nonUniform, input, nonUniformOutput, numSamples / 4, maximumBufferSize, random);
+
+            nonUniform.reset();
+            process (nonUniform, input, nonUniformOutput, numSamples, maximumBufferSize, random);
+
+            expectLessThan (getMaxDifference (uniformOutput, nonUniformOutput, numSamples), tolerance);
+        }
+
+        beginTest ("Non-uniform partitioning with a background thread");
+        {
+            ConvolutionEngine nonUniform;
+            initialise (nonUniform, impulse, maximumBufferSize, true, 1024);
+
+            {
+                ConvolutionBackgroundThread backgroundThread;
+                backgroundThread.addEngine (&nonUniform);
+                backgroundThread.startThread();
+
+                process (nonUniform, input, nonUniformOutput, numSamples, maximumBufferSize, random);
+            }
+
+            // the audio thread never waits for the background thread, so the output
+            // can only be compared if none of the tail jobs has been late
+            if (nonUniform.getNumLateTailJobs() == 0)
+                expectLessThan (getMaxDifference (uniformOutput, nonUniformOutput, numSamples), tolerance);
+        }
+
+        beginTest ("Non-uniform partitioning with a late tail job");
+        {
+            ConvolutionEngine nonUniform;
+            initialise (nonUniform, impulse, maximumBufferSize, true, 1024);
+
+            auto processRange = [&] (int start, int end)
+            {
+                for (int pos = start; pos < end; pos += maximumBufferSize)
+                {
+                    auto numToProcess = jmin (end - pos, maximumBufferSize);
+
+                    FloatVectorOperations::clear (nonUniformOutput + pos, numToProcess);
+                    nonUniform.processSamples (input + pos, nonUniformOutput + pos, (size_t) numToProcess);
+                }
+            };
+
+            using Stage = ConvolutionEngine::TailStage;
+            auto* stage = nonUniform.tailStages.getFirst();
+            auto stageBlockSize = (int) stage->blockSize;
+            auto lateStart = 4 * stageBlockSize;
+
+            // the job scheduled at the end of a block is still running on a background
+            // thread when the audio thread needs its result at the end of the next block
+            processRange (0, lateStart);
+
+            auto& lateJob = stage->jobs[stage->lastJob];
+            expect (lateJob.state == (int) Stage::jobPending);
+            lateJob.state = (int) Stage::jobRunning;
+
+            processRange (lateStart, lateStart + stageBlockSize);
+
+            lateJob.state = (int) Stage::jobPending;
+            stage->performPendingJob();
+
+            processRange (lateStart + stageBlockSize, numSamples);
+            expectEquals (nonUniform.getNumLateTailJobs(), 1);
+
+            // only the result of the late job, played during the following block, is missing
+            auto lateEnd = lateStart + 2 * stageBlockSize;
+            HeapBlock<float> difference (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                difference[i] = std::abs (uniformOutput[i] - nonUniformOutput[i]);
+
+            expectLessThan (FloatVectorOperations::findMaximum (difference.get(), lateStart + stageBlockSize), (float) tolerance);
+            expectGreaterThan (FloatVectorOperations::findMaximum (difference + lateStart + stageBlockSize, stageBlockSize), (float) tolerance);
+            expectLessThan (FloatVectorOperations::findMaximum (difference + lateEnd, numSamples - lateEnd), (float) tolerance);
+        }
+
+        beginTest ("SIMD and scalar complex multiply-accumulate");
+        {
+            constexpr size_t FFTSize = 512;
+            constexpr size_t spectrumSize = FFTSize + 1;
+            constexpr int numProducts = 8;
+
+            // The SIMD loop is only used when all the buffers are aligned, so the products
+            // accumulated into a misaligned output are computed by the scalar loop
+            HeapBlock<float> inputData (spectrumSize + 16), impulseData (spectrumSize + 16),
+                             alignedData (spectrumSize + 16), misalignedData (spectrumSize + 16);
+
+            auto* spectrumInput    = getSIMDAlignedPtr (inputData.get());
+            auto* spectrumImpulse  = getSIMDAlignedPtr (impulseData.get());
+            auto* alignedOutput    = getSIMDAlignedPtr (alignedData.get());
+            auto* misalignedOutput = getSIMDAlignedPtr (misalignedData.get()) + 1;
+
+            FloatVectorOperations::clear (alignedOutput, (int) spectrumSize);
+            FloatVectorOperations::clear (misalignedOutput, (int) spectrumSize);
+
+            HeapBlock<double> expected (spectrumSize, true);
+            auto* expectedImag = expected + FFTSize / 2;
+
+            for (int product = 0; product < numProducts; ++product)
+            {
+                for (size_t i = 0; i < spectrumSize; ++i)
+                {
+                    spectrumInput[i]   = random.nextFloat() * 2.0f - 1.0f;
+                    spectrumImpulse[i] = random.nextFloat() * 2.0f - 1.0f;
+                }
+
+                ConvolutionEngine::convolutionProcessingAndAccumulate (spectrumInput, spectrumImpulse, alignedOutput, FFTSize);
+                ConvolutionEngine::convolutionProcessingAndAccumulate (spectrumInput, spectrumImpulse, misalignedOutput, FFTSize);
+
+                // the split-complex layout of prepareForConvolution
+                auto* inputImag   = spectrumInput   + FFTSize / 2;
+                auto* impulseImag = spectrumImpulse + FFTSize / 2;
+
+                for (size_t i = 0; i < FFTSize / 2; ++i)
+                {
+                    expected[i]     += (double) spectrumInput[i] * spectrumImpulse[i] - (double) inputImag[i] * impulseImag[i];
+                    expectedImag[i] += (double) spectrumInput[i] * impulseImag[i] + (double) inputImag[i] * spectrumImpulse[i];
+                }
+
+                expected[FFTSize] += (double) spectrumInput[FFTSize] * spectrumImpulse[FFTSize];
+            }
+
+            double maxDifference = 0, maxError = 0;
+
+            for (size_t i = 0; i < spectrumSize; ++i)
+            {
+                maxDifference = jmax (maxDifference, (double) std::abs (alignedOutput[i] - misalignedOutput[i]));
+                maxError = jmax (maxError, std::abs (alignedOutput[i] - expected[i]), std::abs (misalignedOutput[i] - expected[i]));
+            }
+
+            expectLessThan (maxDifference, tolerance);
+            expectLessThan (maxError, tolerance);
+        }
+    }
+};
+
+static ConvolutionEngineTest convolutionEngineUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -35,6 +35,27 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // the batched transforms simply process one channel after the other, unless
+    // the engine is able to do better
+    virtual void performBatch (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                               int numChannels, bool inverse) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            perform (inputs[i], outputs[i], inverse);
+    }
+
+    virtual void performRealOnlyForwardTransformBatch (float* const* data, int numChannels, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyForwardTransform (data[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransformBatch (float* const* data, int numChannels) const noexcept
+    {
+        for (int i = 0; i < numChannels; ++i)
+            performRealOnlyInverseTransform (data[i]);
+    }
 };
 
 struct FFT::Engine
@@ -422,6 +443,593 @@ struct FFTFallback  : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+/*  An iterative radix-4 Stockham FFT working on split-complex data, so that the
+    butterflies of the later passes are computed several at once with SIMDRegister.
+    The real-only transforms use a complex FFT of half the size, followed by a
+    post-processing step, instead of a full complex transform of the real data.
+
+    The batched transforms of small sizes put one channel in each lane of the
+    SIMD registers instead, so that all the passes are vectorised.
+*/
+struct FFTRadix4  : public FFT::Instance
+{
+    // faster than the fallback, but the platform libraries should be preferred
+    static constexpr int priority = 0;
+
+    static FFTRadix4* create (int order)
+    {
+        return new FFTRadix4 (order);
+    }
+
+    FFTRadix4 (int order)
+        : size (1 << order),
+          complexPlan (size),
+          realPlan (jmax (1, size / 2)),
+          realTwiddles ((size_t) (size / 2 + 1))
+    {
+        for (int k = 0; k <= size / 2; ++k)
+        {
+            auto phase = -MathConstants<double>::twoPi * k / (double) size;
+            realTwiddles[k] = { (float) std::cos (phase), (float) std::sin (phase) };
+        }
+
+        // the largest scratch buffer is used by the complex and batched transforms
+        auto maxNumScratchFloats = (size_t) size;
+
+       #if JUCE_USE_SIMD
+        if (getNumBatchedChannels (numLanes) > 0)
+            maxNumScratchFloats *= (size_t) numLanes;
+       #endif
+
+        auto maxScratchSize = getScratchSize (maxNumScratchFloats);
+
+        if (maxScratchSize >= maxFFTScratchSpaceToAlloca)
+        {
+            heapScratch.malloc (maxScratchSize);
+            heapScratchSize = maxScratchSize;
+        }
+    }
+
+    //==============================================================================
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        withScratch ((size_t) size, [&] (float* re, float* im, float* tempRe, float* tempIm)
+        {
+            // the inverse transform is the conjugate of the forward transform of the conjugate
+            auto sign = inverse ? -1.0f : 1.0f;
+
+            for (int i = 0; i < size; ++i)
+            {
+                re[i] = input[i].real();
+                im[i] = input[i].imag() * sign;
+            }
+
+            complexPlan.perform (re, im, tempRe, tempIm);
+
+            auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+            for (int i = 0; i < size; ++i)
+                output[i] = { re[i] * scale, im[i] * scale * sign };
+        });
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool dontCalculateNegativeFrequencies) const noexcept override
+    {
+        if (size == 1)
+        {
+            d[1] = 0.0f;
+            return;
+        }
+
+        auto halfSize = size / 2;
+
+        withScratch ((size_t) halfSize, [&] (float* re, float* im, float* tempRe, float* tempIm)
+        {
+            // the even and odd samples are the real and imaginary parts of a half size transform
+            for (int i = 0; i < halfSize; ++i)
+            {
+                re[i] = d[2 * i];
+                im[i] = d[2 * i + 1];
+            }
+
+            realPlan.perform (re, im, tempRe, tempIm);
+
+            for (int k = 0; k <= halfSize; ++k)
+                splitRealSpectrum (re, im, k, d[2 * k], d[2 * k + 1]);
+        });
+
+        if (! dontCalculateNegativeFrequencies)
+            fillNegativeFrequencies (d);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        auto halfSize = size / 2;
+
+        withScratch ((size_t) halfSize, [&] (float* re, float* im, float* tempRe, float* tempIm)
+        {
+            for (int k = 0; k < halfSize; ++k)
+                mergeRealSpectrum (d[2 * k], d[2 * k + 1], d[2 * (halfSize - k)], d[2 * (halfSize - k) + 1], k, re[k], im[k]);
+
+            realPlan.perform (re, im, tempRe, tempIm);
+
+            auto scale = 1.0f / (float) size;
+
+            for (int i = 0; i < halfSize; ++i)
+            {
+                d[2 * i]     = re[i] * scale;
+                d[2 * i + 1] = -im[i] * scale;
+            }
+        });
+    }
+
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    void performBatch (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                       int numChannels, bool inverse) const noexcept override
+    {
+        auto numBatched = getNumBatchedChannels (numChannels);
+
+        if (numBatched > 0)
+        {
+            withScratch ((size_t) (size * numLanes), [&] (float* re, float* im, float* tempRe, float* tempIm)
+            {
+                auto sign = inverse ? -1.0f : 1.0f;
+                auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+                for (int first = 0; first < numBatched; first += numLanes)
+                {
+                    auto numInGroup = jmin (numLanes, numBatched - first);
+
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        auto* input = inputs[first + jmin (lane, numInGroup - 1)];
+
+                        for (int i = 0; i < size; ++i)
+                        {
+                            re[i * numLanes + lane] = input[i].real();
+                            im[i * numLanes + lane] = input[i].imag() * sign;
+                        }
+                    }
+
+                    complexPlan.perform (toVec (re), toVec (im), toVec (tempRe), toVec (tempIm));
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        auto* output = outputs[first + lane];
+
+                        for (int i = 0; i < size; ++i)
+                            output[i] = { re[i * numLanes + lane] * scale, im[i * numLanes + lane] * scale * sign };
+                    }
+                }
+            });
+        }
+
+        if (numBatched < numChannels)
+            FFT::Instance::performBatch (inputs + numBatched, outputs + numBatched, numChannels - numBatched, inverse);
+    }
+
+    void performRealOnlyForwardTransformBatch (float* const* data, int numChannels,
+                                               bool dontCalculateNegativeFrequencies) const noexcept override
+    {
+        auto numBatched = getNumBatchedChannels (numChannels);
+
+        if (numBatched > 0)
+        {
+            auto halfSize = size / 2;
+
+            withScratch ((size_t) ((halfSize + 1) * numLanes), [&] (float* re, float* im, float* spectrumRe, float* spectrumIm)
+            {
+                for (int first = 0; first < numBatched; first += numLanes)
+                {
+                    auto numInGroup = jmin (numLanes, numBatched - first);
+
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        auto* d = data[first + jmin (lane, numInGroup - 1)];
+
+                        for (int i = 0; i < halfSize; ++i)
+                        {
+                            re[i * numLanes + lane] = d[2 * i];
+                            im[i * numLanes + lane] = d[2 * i + 1];
+                        }
+                    }
+
+                    realPlan.perform (toVec (re), toVec (im), toVec (spectrumRe), toVec (spectrumIm));
+
+                    for (int k = 0; k <= halfSize; ++k)
+                        splitRealSpectrum (toVec (re), toVec (im), k, toVec (spectrumRe)[k], toVec (spectrumIm)[k]);
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        auto* d = data[first + lane];
+
+                        for (int k = 0; k <= halfSize; ++k)
+                        {
+                            d[2 * k]     = spectrumRe[k * numLanes + lane];
+                            d[2 * k + 1] = spectrumIm[k * numLanes + lane];
+                        }
+
+                        if (! dontCalculateNegativeFrequencies)
+                            fillNegativeFrequencies (d);
+                    }
+                }
+            });
+        }
+
+        if (numBatched < numChannels)
+            FFT::Instance::performRealOnlyForwardTransformBatch (data + numBatched, numChannels - numBatched, dontCalculateNegativeFrequencies);
+    }
+
+    void performRealOnlyInverseTransformBatch (float* const* data, int numChannels) const noexcept override
+    {
+        auto numBatched = getNumBatchedChannels (numChannels);
+
+        if (numBatched > 0)
+        {
+            auto halfSize = size / 2;
+            auto scale = 1.0f / (float) size;
+
+            withScratch ((size_t) ((halfSize + 1) * numLanes), [&] (float* re, float* im, float* spectrumRe, float* spectrumIm)
+            {
+                for (int first = 0; first < numBatched; first += numLanes)
+                {
+                    auto numInGroup = jmin (numLanes, numBatched - first);
+
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        auto* d = data[first + jmin (lane, numInGroup - 1)];
+
+                        for (int k = 0; k <= halfSize; ++k)
+                        {
+                            spectrumRe[k * numLanes + lane] = d[2 * k];
+                            spectrumIm[k * numLanes + lane] = d[2 * k + 1];
+                        }
+                    }
+
+                    auto* vRe = toVec (re);
+                    auto* vIm = toVec (im);
+                    auto* vSpectrumRe = toVec (spectrumRe);
+                    auto* vSpectrumIm = toVec (spectrumIm);
+
+                    for (int k = 0; k < halfSize; ++k)
+                        mergeRealSpectrum (vSpectrumRe[k], vSpectrumIm[k], vSpectrumRe[halfSize - k], vSpectrumIm[halfSize - k], k, vRe[k], vIm[k]);
+
+                    realPlan.perform (vRe, vIm, vSpectrumRe, vSpectrumIm);
+
+                    for (int lane = 0; lane < numInGroup; ++lane)
+                    {
+                        auto* d = data[first + lane];
+
+                        for (int i = 0; i < halfSize; ++i)
+                        {
+                            d[2 * i]     = re[i * numLanes + lane] * scale;
+                            d[2 * i + 1] = -im[i * numLanes + lane] * scale;
+                        }
+                    }
+                }
+            });
+        }
+
+        if (numBatched < numChannels)
+            FFT::Instance::performRealOnlyInverseTransformBatch (data + numBatched, numChannels - numBatched);
+    }
+   #endif
+
+    //==============================================================================
+    /** Calls a function with four temporary buffers of the given number of floats,
+        aligned for SIMDRegister. The buffers are taken from the stack when they are
+        small enough, or else from the buffer allocated by the constructor. Several
+        threads can still use the same instance at the same time, as the ones which
+        don't get that buffer allocate their own.
+    */
+    template <typename Function>
+    void withScratch (size_t numFloats, Function&& function) const noexcept
+    {
+        auto channelSize = getScratchChannelSize (numFloats);
+        auto scratchSize = getScratchSize (numFloats);
+
+        if (scratchSize < maxFFTScratchSpaceToAlloca)
+        {
+            useScratch (alloca (scratchSize), channelSize, function);
+            return;
+        }
+
+        const GenericScopedTryLock<SpinLock> lock (heapScratchLock);
+
+        if (lock.isLocked() && scratchSize <= heapScratchSize)
+        {
+            useScratch (heapScratch.getData(), channelSize, function);
+        }
+        else
+        {
+            HeapBlock<char> heapSpace (scratchSize);
+            useScratch (heapSpace.getData(), channelSize, function);
+        }
+    }
+
+    static size_t getScratchChannelSize (size_t numFloats) noexcept
+    {
+        return (numFloats + scratchAlignment / sizeof (float) - 1) & ~(scratchAlignment / sizeof (float) - 1);
+    }
+
+    static size_t getScratchSize (size_t numFloats) noexcept
+    {
+        return scratchAlignment + 4 * getScratchChannelSize (numFloats) * sizeof (float);
+    }
+
+    template <typename Function>
+    static void useScratch (void* space, size_t channelSize, Function& function) noexcept
+    {
+        auto address = (reinterpret_cast<pointer_sized_uint> (space) + scratchAlignment - 1) & ~(pointer_sized_uint) (scratchAlignment - 1);
+        auto* data = reinterpret_cast<float*> (address);
+
+        function (data, data + channelSize, data + 2 * channelSize, data + 3 * channelSize);
+    }
+
+    //==============================================================================
+    /** Returns the bin k of the spectrum of a real signal, from the half size transform
+        of its even and odd samples taken as a complex signal.
+    */
+    template <typename Type>
+    void splitRealSpectrum (const Type* re, const Type* im, int k, Type& outRe, Type& outIm) const noexcept
+    {
+        auto halfSize = size / 2;
+        auto k1 = k < halfSize ? k : 0;
+        auto k2 = k > 0 ? halfSize - k : 0;
+
+        auto evenRe = (re[k1] + re[k2]) * 0.5f, evenIm = (im[k1] - im[k2]) * 0.5f;
+        auto oddRe  = (im[k1] + im[k2]) * 0.5f, oddIm  = (re[k2] - re[k1]) * 0.5f;
+
+        auto w = realTwiddles[k];
+
+        outRe = evenRe + oddRe * w.real() - oddIm * w.imag();
+        outIm = evenIm + oddIm * w.real() + oddRe * w.imag();
+    }
+
+    /** The reverse operation of splitRealSpectrum, which rebuilds the bin k of the half
+        size transform from the bins x = k and y = size / 2 - k of the spectrum of the real
+        signal. The result is conjugated, so that it can be inverted with a forward transform.
+    */
+    template <typename Type>
+    void mergeRealSpectrum (Type xRe, Type xIm, Type yRe, Type yIm, int k, Type& outRe, Type& outIm) const noexcept
+    {
+        auto sumRe  = xRe + yRe, sumIm  = xIm - yIm;
+        auto diffRe = xRe - yRe, diffIm = xIm + yIm;
+
+        auto w = realTwiddles[k];
+
+        auto oddRe = diffRe * w.real() + diffIm * w.imag();
+        auto oddIm = diffIm * w.real() - diffRe * w.imag();
+
+        outRe = sumRe - oddIm;
+        outIm = (sumIm + oddRe) * -1.0f;
+    }
+
+    void fillNegativeFrequencies (float* d) const noexcept
+    {
+        for (int k = size / 2 + 1; k < size; ++k)
+        {
+            d[2 * k]     =  d[2 * (size - k)];
+            d[2 * k + 1] = -d[2 * (size - k) + 1];
+        }
+    }
+
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<float>;
+    static constexpr int numLanes = (int) Vec::SIMDNumElements;
+
+    static Vec* toVec (float* data) noexcept
+    {
+        jassert (Vec::isSIMDAligned (data));
+        return reinterpret_cast<Vec*> (data);
+    }
+
+    static const Vec* toVec (const float* data) noexcept
+    {
+        jassert (Vec::isSIMDAligned (data));
+        return reinterpret_cast<const Vec*> (data);
+    }
+
+    /** Returns how many of the first channels are worth processing in the lanes of the
+        SIMD registers, the others being processed one after the other.
+    */
+    int getNumBatchedChannels (int numChannels) const noexcept
+    {
+        if (size > maxBatchedSize || size == 1)
+            return 0;
+
+        auto remainder = numChannels % numLanes;
+        return remainder > numLanes / 2 ? numChannels : numChannels - remainder;
+    }
+   #else
+    static constexpr int numLanes = 1;
+   #endif
+
+    // the batched transforms need a scratch buffer numLanes times bigger, and are only
+    // worth it for the small sizes, where most passes can't be vectorised otherwise
+    static constexpr int maxBatchedSize = 1024;
+
+    static constexpr size_t scratchAlignment = sizeof (float) * (size_t) (numLanes > 4 ? numLanes : 4);
+    static constexpr size_t maxFFTScratchSpaceToAlloca = 256 * 1024;
+
+    //==============================================================================
+    struct Plan
+    {
+        Plan (int n)  : fftSize (n)
+        {
+            for (auto length = n; length >= 4; length /= 4)
+                ++numRadix4Passes;
+
+            hasRadix2Pass = (n >> (2 * numRadix4Passes)) == 2;
+
+            // for each pass, the real and imaginary parts of the twiddle factors w^p, w^2p and w^3p
+            twiddles = AudioBlock<float> (twiddlesData, (size_t) jmax (1, 6 * numRadix4Passes), (size_t) jmax (1, n / 4));
+
+            for (int pass = 0; pass < numRadix4Passes; ++pass)
+            {
+                auto length = n >> (2 * pass);
+
+                for (int k = 1; k <= 3; ++k)
+                {
+                    auto* twiddleRe = twiddles.getChannelPointer ((size_t) (6 * pass + 2 * (k - 1)));
+                    auto* twiddleIm = twiddles.getChannelPointer ((size_t) (6 * pass + 2 * (k - 1) + 1));
+
+                    for (int p = 0; p < length / 4; ++p)
+                    {
+                        auto phase = -MathConstants<double>::twoPi * (k * p) / (double) length;
+
+                        twiddleRe[p] = (float) std::cos (phase);
+                        twiddleIm[p] = (float) std::sin (phase);
+                    }
+                }
+            }
+        }
+
+        /** Performs a forward transform of the split-complex data in place, using the
+            temporary buffers for the intermediate passes. The Type can be float, or a
+            SIMDRegister to perform one transform per lane.
+        */
+        template <typename Type>
+        void perform (Type* re, Type* im, Type* tempRe, Type* tempIm) const noexcept
+        {
+            auto* xRe = re;     auto* xIm = im;
+            auto* yRe = tempRe; auto* yIm = tempIm;
+
+            int stride = 1;
+
+            for (int pass = 0; pass < numRadix4Passes; ++pass)
+            {
+                radix4Pass (pass, fftSize >> (2 * pass + 2), stride, xRe, xIm, yRe, yIm);
+
+                std::swap (xRe, yRe);
+                std::swap (xIm, yIm);
+                stride *= 4;
+            }
+
+            if (hasRadix2Pass)
+            {
+                radix2Pass (stride, xRe, xIm, yRe, yIm);
+
+                std::swap (xRe, yRe);
+                std::swap (xIm, yIm);
+            }
+
+            if (xRe != re)
+            {
+                auto numFloats = fftSize * (int) (sizeof (Type) / sizeof (float));
+
+                FloatVectorOperations::copy (reinterpret_cast<float*> (re), reinterpret_cast<const float*> (xRe), numFloats);
+                FloatVectorOperations::copy (reinterpret_cast<float*> (im), reinterpret_cast<const float*> (xIm), numFloats);
+            }
+        }
+
+        void radix4Pass (int pass, int m, int stride, const float* xRe, const float* xIm, float* yRe, float* yIm) const noexcept
+        {
+           #if JUCE_USE_SIMD
+            // once the stride is big enough, consecutive butterflies fit in the lanes of a register
+            if (stride % numLanes == 0)
+            {
+                radix4Pass (pass, m, stride / numLanes, toVec (xRe), toVec (xIm), toVec (yRe), toVec (yIm));
+                return;
+            }
+           #endif
+
+            radix4Pass<float> (pass, m, stride, xRe, xIm, yRe, yIm);
+        }
+
+        template <typename Type>
+        void radix4Pass (int pass, int m, int stride, const Type* xRe, const Type* xIm, Type* yRe, Type* yIm) const noexcept
+        {
+            auto* w1Re = twiddles.getChannelPointer ((size_t) (6 * pass));
+            auto* w1Im = twiddles.getChannelPointer ((size_t) (6 * pass + 1));
+            auto* w2Re = twiddles.getChannelPointer ((size_t) (6 * pass + 2));
+            auto* w2Im = twiddles.getChannelPointer ((size_t) (6 * pass + 3));
+            auto* w3Re = twiddles.getChannelPointer ((size_t) (6 * pass + 4));
+            auto* w3Im = twiddles.getChannelPointer ((size_t) (6 * pass + 5));
+
+            auto s = (size_t) stride;
+            auto sm = s * (size_t) m;
+
+            for (size_t p = 0; p < (size_t) m; ++p)
+            {
+                auto* aRe = xRe + s * p;
+                auto* aIm = xIm + s * p;
+                auto* outRe = yRe + s * 4 * p;
+                auto* outIm = yIm + s * 4 * p;
+
+                for (size_t q = 0; q < s; ++q)
+                {
+                    auto apcRe = aRe[q] + aRe[q + 2 * sm],   apcIm = aIm[q] + aIm[q + 2 * sm];
+                    auto amcRe = aRe[q] - aRe[q + 2 * sm],   amcIm = aIm[q] - aIm[q + 2 * sm];
+                    auto bpdRe = aRe[q + sm] + aRe[q + 3 * sm], bpdIm = aIm[q + sm] + aIm[q + 3 * sm];
+
+                    // j * (b - d)
+                    auto jbmdRe = aIm[q + 3 * sm] - aIm[q + sm], jbmdIm = aRe[q + sm] - aRe[q + 3 * sm];
+
+                    outRe[q] = apcRe + bpdRe;
+                    outIm[q] = apcIm + bpdIm;
+
+                    auto t1Re = amcRe - jbmdRe, t1Im = amcIm - jbmdIm;
+                    outRe[q + s] = t1Re * w1Re[p] - t1Im * w1Im[p];
+                    outIm[q + s] = t1Re * w1Im[p] + t1Im * w1Re[p];
+
+                    auto t2Re = apcRe - bpdRe, t2Im = apcIm - bpdIm;
+                    outRe[q + 2 * s] = t2Re * w2Re[p] - t2Im * w2Im[p];
+                    outIm[q + 2 * s] = t2Re * w2Im[p] + t2Im * w2Re[p];
+
+                    auto t3Re = amcRe + jbmdRe, t3Im = amcIm + jbmdIm;
+                    outRe[q + 3 * s] = t3Re * w3Re[p] - t3Im * w3Im[p];
+                    outIm[q + 3 * s] = t3Re * w3Im[p] + t3Im * w3Re[p];
+                }
+            }
+        }
+
+        template <typename Type>
+        static void radix2Pass (int stride, const Type* xRe, const Type* xIm, Type* yRe, Type* yIm) noexcept
+        {
+            // the last pass has no twiddle factors, so it's a simple sum and difference
+            auto n = stride * (int) (sizeof (Type) / sizeof (float));
+
+            auto* inRe = reinterpret_cast<const float*> (xRe);
+            auto* inIm = reinterpret_cast<const float*> (xIm);
+            auto* outRe = reinterpret_cast<float*> (yRe);
+            auto* outIm = reinterpret_cast<float*> (yIm);
+
+            FloatVectorOperations::add (outRe, inRe, inRe + n, n);
+            FloatVectorOperations::add (outIm, inIm, inIm + n, n);
+            FloatVectorOperations::subtract (outRe + n, inRe, inRe + n, n);
+            FloatVectorOperations::subtract (outIm + n, inIm, inIm + n, n);
+        }
+
+        const int fftSize;
+        int numRadix4Passes = 0;
+        bool hasRadix2Pass = false;
+
+        HeapBlock<char> twiddlesData;
+        AudioBlock<float> twiddles;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Plan)
+    };
+
+    //==============================================================================
+    const int size;
+    Plan complexPlan, realPlan;
+    HeapBlock<Complex<float>> realTwiddles;
+
+    HeapBlock<char> heapScratch;
+    size_t heapScratchSize = 0;
+    SpinLock heapScratchLock;
+};
+
+FFT::EngineImpl<FFTRadix4> fftRadix4;
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -819,6 +1427,24 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+void FFT::perform (const Complex<float>* const* inputs, Complex<float>* const* outputs, int numChannels, bool inverse) const noexcept
+{
+    if (engine != nullptr)
+        engine->performBatch (inputs, outputs, numChannels, inverse);
+}
+
+void FFT::performRealOnlyForwardTransform (float* const* inputOutputData, int numChannels, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransformBatch (inputOutputData, numChannels, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransform (float* const* inputOutputData, int numChannels) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransformBatch (inputOutputData, numChannels);
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept
 {
     if (size == 1)
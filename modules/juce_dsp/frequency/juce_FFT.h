@@ -97,6 +97,35 @@ public:
     */
     void performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept;
 
+    //==============================================================================
+    /** Performs out-of-place FFTs on several channels of the same size, either forward
+        or inverse.
+
+        This gives the same results as calling perform() for each channel, but some
+        FFT engines can transform several channels at once, which is faster than
+        doing the transforms one after the other.
+
+        The arrays of channel pointers must contain numChannels elements, and each
+        channel must contain at least getSize() elements.
+    */
+    void perform (const Complex<float>* const* inputs, Complex<float>* const* outputs,
+                  int numChannels, bool inverse) const noexcept;
+
+    /** Performs in-place forward transforms on several channels of real data, such as
+        the channels of an AudioBuffer.
+
+        This gives the same results as calling performRealOnlyForwardTransform() for
+        each channel, but can be faster with some FFT engines. Each channel must
+        contain 2 * getSize() elements.
+    */
+    void performRealOnlyForwardTransform (float* const* inputOutputData, int numChannels,
+                                          bool dontCalculateNegativeFrequencies = false) const noexcept;
+
+    /** Performs the reverse operation of the batched performRealOnlyForwardTransform()
+        on several channels. Each channel must contain 2 * getSize() elements.
+    */
+    void performRealOnlyInverseTransform (float* const* inputOutputData, int numChannels) const noexcept;
+
     /** Returns the number of data points that this FFT was created to work with. */
     int getSize() const noexcept            { return size; }
 
@@ -191,6 +191,217 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct BatchedTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 0; order <= 7; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                for (auto numChannels : { 1, 3, 13 })
+                {
+                    AudioBuffer<float> input (numChannels, (int) n), inout (numChannels, (int) n * 2);
+                    HeapBlock<Complex<float>> reference (n);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        fillRandom (random, input.getWritePointer (channel), n);
+                        inout.copyFrom (channel, 0, input, channel, 0, (int) n);
+                    }
+
+                    fft.performRealOnlyForwardTransform (inout.getArrayOfWritePointers(), numChannels);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        performReferenceFourier (input.getReadPointer (channel), reference.getData(), n, false);
+                        u.expect (checkArrayIsSimilar (reference.getData(), (Complex<float>*) inout.getWritePointer (channel), n));
+                    }
+
+                    fft.performRealOnlyInverseTransform (inout.getArrayOfWritePointers(), numChannels);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        u.expect (checkArrayIsSimilar (inout.getReadPointer (channel), input.getReadPointer (channel), n));
+
+                    HeapBlock<Complex<float>> inputData (n * (size_t) numChannels), outputData (n * (size_t) numChannels);
+                    Array<const Complex<float>*> inputs;
+                    Array<Complex<float>*> outputs;
+
+                    fillRandom (random, inputData.getData(), n * (size_t) numChannels);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        inputs.add (inputData.getData() + n * (size_t) channel);
+                        outputs.add (outputData.getData() + n * (size_t) channel);
+                    }
+
+                    fft.perform (inputs.getRawDataPointer(), outputs.getRawDataPointer(), numChannels, true);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        performReferenceFourier (inputs[channel], reference.getData(), n, true);
+
+                        for (size_t i = 0; i < n; ++i)
+                            reference[i] /= (float) n;
+
+                        u.expect (checkArrayIsSimilar (reference.getData(), outputs[channel], n));
+                    }
+                }
+            }
+        }
+    };
+
+    struct Radix4Test
+    {
+        static float getMaxDifference (const float* a, const float* b, size_t n)
+        {
+            float maxDifference = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                maxDifference = jmax (maxDifference, std::abs (a[i] - b[i]));
+
+            return maxDifference;
+        }
+
+        static void run (FFTUnitTest& u)
+        {
+            Random random (87123);
+
+            // the last order is large enough for the preallocated scratch buffer
+            for (auto order : { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 15 })
+            {
+                auto n = (size_t) 1 << order;
+                auto tolerance = 1.0e-5f * (float) n + 1.0e-6f;
+
+                std::unique_ptr<FFTRadix4> radix4 (FFTRadix4::create (order));
+                std::unique_ptr<FFTFallback> fallback (FFTFallback::create (order));
+
+                HeapBlock<Complex<float>> input (n), output (n), expected (n);
+                fillRandom (random, input.getData(), n);
+
+                for (auto inverse : { false, true })
+                {
+                    radix4->perform (input.getData(), output.getData(), inverse);
+                    fallback->perform (input.getData(), expected.getData(), inverse);
+
+                    u.expectLessOrEqual (getMaxDifference ((float*) output.getData(), (float*) expected.getData(), n * 2), tolerance);
+                }
+
+                HeapBlock<float> real (n * 2, true), expectedReal (n * 2, true);
+
+                for (auto negativeFrequencies : { false, true })
+                {
+                    fillRandom (random, real.getData(), n);
+                    FloatVectorOperations::copy (expectedReal.getData(), real.getData(), (int) n);
+
+                    radix4->performRealOnlyForwardTransform (real.getData(), ! negativeFrequencies);
+                    fallback->performRealOnlyForwardTransform (expectedReal.getData(), ! negativeFrequencies);
+
+                    auto numValues = negativeFrequencies ? n * 2 : n + 2;
+                    u.expectLessOrEqual (getMaxDifference (real.getData(), expectedReal.getData(), jmin (numValues, n * 2)), tolerance);
+                }
+
+                radix4->performRealOnlyInverseTransform (real.getData());
+                fallback->performRealOnlyInverseTransform (expectedReal.getData());
+
+                u.expectLessOrEqual (getMaxDifference (real.getData(), expectedReal.getData(), n), tolerance);
+
+                // the batched transforms put several channels in the lanes of the SIMD registers
+                constexpr int numChannels = 7;
+                AudioBuffer<float> batch (numChannels, (int) n * 2), expectedBatch (numChannels, (int) n * 2);
+                batch.clear();
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    fillRandom (random, batch.getWritePointer (channel), n);
+
+                expectedBatch.makeCopyOf (batch);
+
+                radix4->performRealOnlyForwardTransformBatch (batch.getArrayOfWritePointers(), numChannels, false);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    fallback->performRealOnlyForwardTransform (expectedBatch.getWritePointer (channel), false);
+                    u.expectLessOrEqual (getMaxDifference (batch.getReadPointer (channel), expectedBatch.getReadPointer (channel), n * 2), tolerance);
+                }
+
+                radix4->performRealOnlyInverseTransformBatch (batch.getArrayOfWritePointers(), numChannels);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    fallback->performRealOnlyInverseTransform (expectedBatch.getWritePointer (channel));
+                    u.expectLessOrEqual (getMaxDifference (batch.getReadPointer (channel), expectedBatch.getReadPointer (channel), n), tolerance);
+                }
+            }
+        }
+    };
+
+    struct ConcurrentTest
+    {
+        // the same instance is used by several threads at the same time
+        struct TransformThread  : public Thread
+        {
+            TransformThread (const FFT& f, const HeapBlock<float>& in, const HeapBlock<float>& spectrum,
+                             size_t size, int iterations)
+                : Thread ("FFT test"), fft (f), input (in), expected (spectrum), n (size), numIterations (iterations)
+            {}
+
+            void run() override
+            {
+                HeapBlock<float> data (n * 2);
+
+                for (int i = 0; i < numIterations && ! failed; ++i)
+                {
+                    FloatVectorOperations::copy (data.getData(), input.getData(), (int) n);
+                    fft.performRealOnlyForwardTransform (data.getData(), true);
+
+                    for (size_t j = 0; j < n + 2; ++j)
+                        if (data[j] != expected[j])
+                            failed = true;
+                }
+            }
+
+            const FFT& fft;
+            const HeapBlock<float>& input;
+            const HeapBlock<float>& expected;
+            size_t n;
+            int numIterations;
+            bool failed = false;
+        };
+
+        static void run (FFTUnitTest& u)
+        {
+            Random random (4242);
+
+            // the large transforms share a scratch buffer, which the other threads can't use
+            for (auto order : { 9, 16 })
+            {
+                auto n = (size_t) 1 << order;
+
+                FFT fft (order);
+                HeapBlock<float> input (n), expected (n * 2);
+
+                fillRandom (random, input.getData(), n);
+                FloatVectorOperations::copy (expected.getData(), input.getData(), (int) n);
+                fft.performRealOnlyForwardTransform (expected.getData(), true);
+
+                OwnedArray<TransformThread> threads;
+
+                for (int i = 0; i < 4; ++i)
+                    threads.add (new TransformThread (fft, input, expected, n, order > 12 ? 50 : 2000))->startThread();
+
+                for (auto* thread : threads)
+                {
+                    thread->waitForThreadToExit (-1);
+                    u.expect (! thread->failed);
+                }
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -204,6 +415,9 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<BatchedTest> ("Batched transforms Test");
+        runTestForAllTypes<Radix4Test> ("Radix-4 against fallback Test");
+        runTestForAllTypes<ConcurrentTest> ("Concurrent transforms Test");
     }
 };
 
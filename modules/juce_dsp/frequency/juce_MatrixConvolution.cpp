@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/** The uniform-partitioned convolution engine of the MatrixConvolution class.
+
+    It works like the ConvolutionEngine, except that the spectra of the input
+    segments are shared between all the outputs, and that the products for all
+    the inputs are summed before doing the inverse FFT of each output.
+*/
+struct MatrixConvolution::Engine
+{
+    Engine (const AudioBuffer<float>& impulseResponses, int numIns, int numOuts, size_t maximumBufferSize)
+        : numInputs ((size_t) numIns), numOutputs ((size_t) numOuts)
+    {
+        blockSize = (size_t) nextPowerOfTwo ((int) maximumBufferSize);
+
+        FFTSize = blockSize > 128 ? 2 * blockSize
+                                  : 4 * blockSize;
+
+        auto impulseSize = (size_t) impulseResponses.getNumSamples();
+        auto segmentSize = FFTSize - blockSize;
+
+        numSegments = impulseSize / segmentSize + 1u;
+        numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
+
+        FFTobject.reset (new FFT (roundToInt (std::log2 (FFTSize))));
+
+        bufferInput.setSize      ((int) numInputs,  static_cast<int> (FFTSize));
+        bufferOverlap.setSize    ((int) numOutputs, static_cast<int> (FFTSize));
+
+        // the spectra are stored in SIMD aligned channels, one per segment and per input or input/output pair
+        bufferTempOutput = AudioBlock<float> (bufferTempOutputData, numOutputs, FFTSize + 1);
+        bufferOutput     = AudioBlock<float> (bufferOutputData, 1, FFTSize * 2);
+        inputSegments    = AudioBlock<float> (inputSegmentsData,   numInputs * numInputSegments,         FFTSize + 1);
+        impulseSegments  = AudioBlock<float> (impulseSegmentsData, numInputs * numOutputs * numSegments, FFTSize + 1);
+
+        auto* fftData = bufferOutput.getChannelPointer (0);
+
+        for (size_t pair = 0; pair < numInputs * numOutputs; ++pair)
+        {
+            auto* channelData = impulseResponses.getReadPointer ((int) pair);
+
+            for (size_t n = 0; n < numSegments; ++n)
+            {
+                FloatVectorOperations::clear (fftData, static_cast<int> (FFTSize * 2));
+
+                auto start = n * segmentSize;
+                auto numToCopy = jmin (segmentSize, impulseSize - start);
+                FloatVectorOperations::copy (fftData, channelData + start, static_cast<int> (numToCopy));
+
+                FFTobject->performRealOnlyForwardTransform (fftData, true);
+                ConvolutionEngine::prepareForConvolution (fftData, FFTSize);
+
+                FloatVectorOperations::copy (getImpulseSegment (pair, n), fftData, static_cast<int> (FFTSize + 1));
+            }
+        }
+
+        reset();
+    }
+
+    //==============================================================================
+    void reset()
+    {
+        bufferInput.clear();
+        bufferTempOutput.clear();
+        bufferOverlap.clear();
+        inputSegments.clear();
+
+        currentSegment = 0;
+        inputDataPos = 0;
+    }
+
+    /** Performs the uniform partitioned convolution of all the inputs. */
+    void processSamples (const AudioBlock<float>& input, AudioBlock<float>& output, size_t numSamples)
+    {
+        size_t numSamplesProcessed = 0;
+
+        auto indexStep = numInputSegments / numSegments;
+        auto* outputData = bufferOutput.getChannelPointer (0);
+
+        while (numSamplesProcessed < numSamples)
+        {
+            const bool inputDataWasEmpty = (inputDataPos == 0);
+            auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
+
+            // Forward FFT, done only once per input for all the outputs
+            for (size_t in = 0; in < numInputs; ++in)
+            {
+                auto* inputData = bufferInput.getWritePointer ((int) in);
+
+                FloatVectorOperations::copy (inputData + inputDataPos, input.getChannelPointer (in) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
+
+                FloatVectorOperations::copy (outputData, inputData, static_cast<int> (FFTSize));
+                FFTobject->performRealOnlyForwardTransform (outputData, true);
+                ConvolutionEngine::prepareForConvolution (outputData, FFTSize);
+
+                FloatVectorOperations::copy (getInputSegment (in, currentSegment), outputData, static_cast<int> (FFTSize + 1));
+            }
+
+            for (size_t out = 0; out < numOutputs; ++out)
+            {
+                auto* outputTempData = bufferTempOutput.getChannelPointer (out);
+                auto* overlapData    = bufferOverlap.getWritePointer ((int) out);
+
+                // Complex multiplication with the previous segments of every input
+                if (inputDataWasEmpty)
+                {
+                    FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (FFTSize + 1));
+
+                    for (size_t in = 0; in < numInputs; ++in)
+                    {
+                        auto index = currentSegment;
+
+                        for (size_t i = 1; i < numSegments; ++i)
+                        {
+                            index += indexStep;
+
+                            if (index >= numInputSegments)
+                                index -= numInputSegments;
+
+                            ConvolutionEngine::convolutionProcessingAndAccumulate (getInputSegment (in, index),
+                                                                                   getImpulseSegment (out * numInputs + in, i),
+                                                                                   outputTempData, FFTSize);
+                        }
+                    }
+                }
+
+                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
+
+                for (size_t in = 0; in < numInputs; ++in)
+                    ConvolutionEngine::convolutionProcessingAndAccumulate (getInputSegment (in, currentSegment),
+                                                                           getImpulseSegment (out * numInputs + in, 0),
+                                                                           outputData, FFTSize);
+
+                // Inverse FFT, done only once per output
+                ConvolutionEngine::updateSymmetricFrequencyDomainData (outputData, FFTSize);
+                FFTobject->performRealOnlyInverseTransform (outputData);
+
+                // Add overlap
+                FloatVectorOperations::add (output.getChannelPointer (out) + numSamplesProcessed,
+                                            outputData + inputDataPos, overlapData + inputDataPos,
+                                            static_cast<int> (numSamplesToProcess));
+
+                if (inputDataPos + numSamplesToProcess == blockSize)
+                {
+                    // Extra step for segSize > blockSize
+                    FloatVectorOperations::add (outputData + blockSize, overlapData + blockSize, static_cast<int> (FFTSize - 2 * blockSize));
+
+                    // Save the overlap
+                    FloatVectorOperations::copy (overlapData, outputData + blockSize, static_cast<int> (FFTSize - blockSize));
+                }
+            }
+
+            // Input buffer full => Next block
+            inputDataPos += numSamplesToProcess;
+
+            if (inputDataPos == blockSize)
+            {
+                // Input buffer is empty again now
+                for (size_t in = 0; in < numInputs; ++in)
+                    FloatVectorOperations::fill (bufferInput.getWritePointer ((int) in), 0.0f, static_cast<int> (FFTSize));
+
+                inputDataPos = 0;
+
+                // Update current segment
+                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+            }
+
+            numSamplesProcessed += numSamplesToProcess;
+        }
+    }
+
+    float* getInputSegment (size_t in, size_t segment) noexcept
+    {
+        return inputSegments.getChannelPointer (in * numInputSegments + segment);
+    }
+
+    float* getImpulseSegment (size_t pair, size_t segment) noexcept
+    {
+        return impulseSegments.getChannelPointer (pair * numSegments + segment);
+    }
+
+    //==============================================================================
+    std::unique_ptr<FFT> FFTobject;
+
+    const size_t numInputs, numOutputs;
+    size_t FFTSize = 0;
+    size_t currentSegment = 0, numInputSegments = 0, numSegments = 0, blockSize = 0, inputDataPos = 0;
+
+    AudioBuffer<float> bufferInput, bufferOverlap;
+
+    HeapBlock<char> bufferTempOutputData, bufferOutputData, inputSegmentsData, impulseSegmentsData;
+    AudioBlock<float> bufferTempOutput, bufferOutput, inputSegments, impulseSegments;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Engine)
+};
+
+//==============================================================================
+MatrixConvolution::MatrixConvolution()
+{
+}
+
+MatrixConvolution::~MatrixConvolution()
+{
+}
+
+void MatrixConvolution::prepare (const ProcessSpec& spec)
+{
+    maximumBufferSize = spec.maximumBlockSize;
+    createEngine();
+}
+
+void MatrixConvolution::reset() noexcept
+{
+    const SpinLock::ScopedLockType sl (engineLock);
+
+    if (engine != nullptr)
+        engine->reset();
+}
+
+void MatrixConvolution::loadImpulseResponses (const AudioBuffer<float>& buffer, int numInputs, int numOutputs, size_t size)
+{
+    jassert (numInputs > 0 && numOutputs > 0);
+    jassert (buffer.getNumChannels() >= numInputs * numOutputs);
+
+    auto numSamples = (size == 0 ? (size_t) buffer.getNumSamples()
+                                 : jmin (size, (size_t) buffer.getNumSamples()));
+
+    impulseResponses.setSize (numInputs * numOutputs, (int) numSamples);
+
+    for (auto channel = 0; channel < numInputs * numOutputs; ++channel)
+        impulseResponses.copyFrom (channel, 0, buffer, channel, 0, (int) numSamples);
+
+    numInputChannels = numInputs;
+    numOutputChannels = numOutputs;
+
+    createEngine();
+}
+
+void MatrixConvolution::createEngine()
+{
+    if (maximumBufferSize == 0 || numInputChannels == 0 || numOutputChannels == 0)
+        return;
+
+    std::unique_ptr<Engine> newEngine (new Engine (impulseResponses, numInputChannels, numOutputChannels, maximumBufferSize));
+
+    {
+        const SpinLock::ScopedLockType sl (engineLock);
+        std::swap (engine, newEngine);
+    }
+
+    // the previous engine is deleted here, out of the lock
+}
+
+void MatrixConvolution::processSamples (const AudioBlock<float>& input, AudioBlock<float>& output) noexcept
+{
+    const SpinLock::ScopedLockType sl (engineLock);
+
+    auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+    if (engine == nullptr
+         || input.getNumChannels() < engine->numInputs
+         || output.getNumChannels() < engine->numOutputs)
+    {
+        // if this is hit, the context doesn't have enough channels for the loaded impulse responses
+        jassert (engine == nullptr);
+
+        output.clear();
+        return;
+    }
+
+    engine->processSamples (input, output, numSamples);
+
+    for (auto channel = engine->numOutputs; channel < output.getNumChannels(); ++channel)
+        output.getSingleChannelBlock (channel).clear();
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Performs a multichannel convolution of N input channels with a matrix of
+    N x M impulse responses, producing M output channels, in the frequency
+    domain with a zero latency uniform-partitioned algorithm.
+
+    Each output channel is the sum of the convolutions of every input channel
+    with the impulse response associated to this input/output pair. This can
+    be used for true-stereo reverberation (2 inputs, 2 outputs and 4 impulse
+    responses), or for ambisonic decoding and binaural rendering.
+
+    Compared to using one Convolution object per impulse response, every input
+    segment is transformed only once with a forward FFT, and the products with
+    the impulse responses are accumulated in the frequency domain, so that only
+    one inverse FFT is needed per output channel.
+
+    Unlike the Convolution class, the impulse responses are not resampled,
+    trimmed or normalised, and are swapped without any crossfading when a new
+    set is loaded.
+
+    @see Convolution
+
+    @tags{DSP}
+*/
+class JUCE_API  MatrixConvolution
+{
+public:
+    //==============================================================================
+    /** Creates an empty MatrixConvolution, which outputs silence until some
+        impulse responses have been loaded.
+    */
+    MatrixConvolution();
+
+    /** Destructor. */
+    ~MatrixConvolution();
+
+    //==============================================================================
+    /** Must be called before processing, to provide the maximum buffer size which
+        determines the size of the partitions.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the processing pipeline, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Processes the given set of samples. The context must provide at least as
+        many input channels as the number of inputs of the loaded impulse responses,
+        and at least as many output channels as their number of outputs. The input
+        and output blocks can be the same.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, float>::value,
+                       "Convolution engine only supports single precision floating point data");
+
+        auto&& inBlock  = context.getInputBlock();
+        auto&& outBlock = context.getOutputBlock();
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outBlock.copy (inBlock);
+
+            return;
+        }
+
+        processSamples (inBlock, outBlock);
+    }
+
+    //==============================================================================
+    /** Loads a matrix of impulse responses, which is copied before doing anything
+        else. This is not real-time safe, and should be called on a background or
+        message thread. The new impulse responses are used from the next block on.
+
+        @param buffer           a buffer containing numInputs * numOutputs channels, the
+                                impulse response between the input i and the output o
+                                being stored in the channel o * numInputs + i
+        @param numInputs        the number of input channels to convolve
+        @param numOutputs       the number of output channels to produce
+        @param size             the number of samples of the impulse responses to use,
+                                0 meaning the whole buffer
+    */
+    void loadImpulseResponses (const AudioBuffer<float>& buffer, int numInputs, int numOutputs, size_t size = 0);
+
+    /** Returns the number of inputs of the loaded impulse responses. */
+    int getNumInputs() const noexcept               { return numInputChannels; }
+
+    /** Returns the number of outputs of the loaded impulse responses. */
+    int getNumOutputs() const noexcept              { return numOutputChannels; }
+
+private:
+    //==============================================================================
+    struct Engine;
+    std::unique_ptr<Engine> engine;
+    SpinLock engineLock;
+
+    //==============================================================================
+    void processSamples (const AudioBlock<float>&, AudioBlock<float>&) noexcept;
+    void createEngine();
+
+    //==============================================================================
+    AudioBuffer<float> impulseResponses;
+    int numInputChannels = 0, numOutputChannels = 0;
+    size_t maximumBufferSize = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatrixConvolution)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class MatrixConvolutionTest : public UnitTest
+{
+    static void fillRandom (AudioBuffer<float>& buffer, Random& random, bool decaying)
+    {
+        auto numSamples = buffer.getNumSamples();
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer (channel);
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = (random.nextFloat() * 2.0f - 1.0f)
+                            * (decaying ? std::exp (-4.0f * (float) i / (float) numSamples) * 0.05f : 1.0f);
+        }
+    }
+
+    // The reference output, made with a uniform ConvolutionEngine for every
+    // input/output pair, and the outputs of the pairs summed for every output
+    static AudioBuffer<float> convolveEveryPath (const AudioBuffer<float>& impulses, const AudioBuffer<float>& input,
+                                                 int numInputs, int numOutputs, size_t maximumBufferSize)
+    {
+        auto numSamples = input.getNumSamples();
+        AudioBuffer<float> output (numOutputs, numSamples), pathOutput (1, numSamples);
+        output.clear();
+
+        for (int out = 0; out < numOutputs; ++out)
+        {
+            for (int in = 0; in < numInputs; ++in)
+            {
+                AudioBuffer<float> impulse (1, impulses.getNumSamples());
+                impulse.copyFrom (0, 0, impulses, out * numInputs + in, 0, impulses.getNumSamples());
+
+                ConvolutionEngine::ProcessingInformation info;
+                info.buffer = &impulse;
+                info.finalSize = impulse.getNumSamples();
+                info.maximumBufferSize = maximumBufferSize;
+
+                ConvolutionEngine engine;
+                engine.initializeConvolutionEngine (info, 0);
+
+                pathOutput.clear();
+
+                for (int pos = 0; pos < numSamples; pos += (int) maximumBufferSize)
+                {
+                    auto numToProcess = jmin (numSamples - pos, (int) maximumBufferSize);
+                    engine.processSamples (input.getReadPointer (in, pos), pathOutput.getWritePointer (0, pos), (size_t) numToProcess);
+                }
+
+                output.addFrom (out, 0, pathOutput, 0, 0, numSamples);
+            }
+        }
+
+        return output;
+    }
+
+    // processes the input in blocks of random sizes
+    static void process (MatrixConvolution& convolution, const AudioBuffer<float>& input,
+                         AudioBuffer<float>& output, int maximumBufferSize, Random& random)
+    {
+        const AudioBlock<float> inputBlock (const_cast<AudioBuffer<float>&> (input));
+        AudioBlock<float> outputBlock (output);
+        auto numSamples = input.getNumSamples();
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            auto numToProcess = jmin (numSamples - pos, 1 + random.nextInt (maximumBufferSize));
+            auto inputSubBlock  = inputBlock.getSubBlock ((size_t) pos, (size_t) numToProcess);
+            auto outputSubBlock = outputBlock.getSubBlock ((size_t) pos, (size_t) numToProcess);
+
+            convolution.process (ProcessContextNonReplacing<float> (inputSubBlock, outputSubBlock));
+            pos += numToProcess;
+        }
+    }
+
+    static float getMaxDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b, int numChannels)
+    {
+        float maxDifference = 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = jmax (maxDifference, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maxDifference;
+    }
+
+public:
+    MatrixConvolutionTest() : UnitTest ("Matrix Convolution", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        constexpr int numSamples = 16384;
+        constexpr float tolerance = 1.0e-4f;
+
+        AudioBuffer<float> input (3, numSamples);
+        fillRandom (input, random, false);
+
+        for (auto maximumBufferSize : { 64, 512 })
+        {
+            beginTest ("Same output as a convolution of every path, block size " + String (maximumBufferSize));
+
+            // 3 inputs and 2 outputs, with impulse responses longer than several partitions
+            AudioBuffer<float> impulses (6, 5000);
+            fillRandom (impulses, random, true);
+
+            MatrixConvolution convolution;
+            convolution.prepare ({ 44100.0, (uint32) maximumBufferSize, 3 });
+            convolution.loadImpulseResponses (impulses, 3, 2);
+
+            expectEquals (convolution.getNumInputs(), 3);
+            expectEquals (convolution.getNumOutputs(), 2);
+
+            // the extra output channel must be cleared
+            AudioBuffer<float> output (3, numSamples);
+            fillRandom (output, random, false);
+            process (convolution, input, output, maximumBufferSize, random);
+
+            auto expected = convolveEveryPath (impulses, input, 3, 2, (size_t) maximumBufferSize);
+            expectLessThan (getMaxDifference (output, expected, 2), tolerance);
+            expectEquals (output.getMagnitude (2, 0, numSamples), 0.0f);
+        }
+
+        beginTest ("Processing in place and after a reset");
+        {
+            constexpr int maximumBufferSize = 256;
+
+            AudioBuffer<float> impulses (4, 3000);
+            fillRandom (impulses, random, true);
+
+            MatrixConvolution convolution;
+            convolution.prepare ({ 44100.0, (uint32) maximumBufferSize, 2 });
+            convolution.loadImpulseResponses (impulses, 2, 2);
+
+            // a first stream, which mustn't be heard after the reset
+            AudioBuffer<float> firstStream (2, 100);
+            fillRandom (firstStream, random, false);
+
+            AudioBlock<float> firstBlock (firstStream);
+            convolution.process (ProcessContextReplacing<float> (firstBlock));
+            convolution.reset();
+
+            AudioBuffer<float> output (input);
+            AudioBlock<float> block (output);
+
+            for (int pos = 0; pos < numSamples; pos += maximumBufferSize)
+            {
+                auto subBlock = block.getSubBlock ((size_t) pos, (size_t) maximumBufferSize);
+                convolution.process (ProcessContextReplacing<float> (subBlock));
+            }
+
+            auto expected = convolveEveryPath (impulses, input, 2, 2, (size_t) maximumBufferSize);
+            expectLessThan (getMaxDifference (output, expected, 2), tolerance);
+        }
+
+        beginTest ("Truncated impulse responses");
+        {
+            constexpr int maximumBufferSize = 128;
+
+            AudioBuffer<float> impulses (2, 4000);
+            fillRandom (impulses, random, true);
+
+            MatrixConvolution convolution;
+            convolution.prepare ({ 44100.0, (uint32) maximumBufferSize, 2 });
+            convolution.loadImpulseResponses (impulses, 2, 1, 1000);
+
+            AudioBuffer<float> output (1, numSamples);
+            process (convolution, input, output, maximumBufferSize, random);
+
+            impulses.setSize (2, 1000, true);
+            auto expected = convolveEveryPath (impulses, input, 2, 1, (size_t) maximumBufferSize);
+            expectLessThan (getMaxDifference (output, expected, 1), tolerance);
+        }
+    }
+};
+
+static MatrixConvolutionTest matrixConvolutionUnitTest;
+
+} // namespace dsp
+} // namespace juce
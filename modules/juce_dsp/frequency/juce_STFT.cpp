@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+STFT::STFT (int fftOrder, int hop, WindowingFunction<float>::WindowingMethod window)
+    : fft (fftOrder), fftSize (1 << fftOrder), hopSize (hop),
+      analysisWindow ((size_t) fftSize), synthesisWindow ((size_t) fftSize)
+{
+    jassert (hopSize > 0 && hopSize <= fftSize);
+
+    // the windows are periodic, so that overlapping them gives a constant sum
+    HeapBlock<float> windowTable ((size_t) fftSize + 1);
+    WindowingFunction<float>::fillWindowingTables (windowTable, (size_t) fftSize + 1, window, false);
+    FloatVectorOperations::copy (analysisWindow, windowTable, fftSize);
+
+    // the synthesis window is divided by the sum of the squares of the overlapping
+    // windows, which gives a perfect reconstruction with any window and hop size
+    for (int i = 0; i < fftSize; ++i)
+    {
+        auto sum = 0.0f;
+
+        for (auto j = i % hopSize; j < fftSize; j += hopSize)
+            sum += analysisWindow[j] * analysisWindow[j];
+
+        synthesisWindow[i] = sum > 0.0f ? analysisWindow[i] / sum : 0.0f;
+    }
+}
+
+STFT::~STFT()
+{
+}
+
+void STFT::setSpectrumCallback (SpectrumCallback newCallback)
+{
+    spectrumCallback = std::move (newCallback);
+}
+
+//==============================================================================
+void STFT::prepare (const ProcessSpec& spec)
+{
+    numChannels = (size_t) spec.numChannels;
+
+    inputBuffer  = AudioBlock<float> (inputData,  numChannels, (size_t) fftSize);
+    outputBuffer = AudioBlock<float> (outputData, numChannels, (size_t) fftSize);
+    frames       = AudioBlock<float> (framesData, numChannels, (size_t) fftSize * 2);
+
+    framePointers.malloc (numChannels);
+    spectra.malloc (numChannels);
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        framePointers[channel] = frames.getChannelPointer (channel);
+        spectra[channel] = reinterpret_cast<Complex<float>*> (framePointers[channel]);
+    }
+
+    reset();
+}
+
+void STFT::reset() noexcept
+{
+    inputBuffer.clear();
+    outputBuffer.clear();
+
+    position = 0;
+    samplesUntilNextFrame = hopSize;
+}
+
+//==============================================================================
+void STFT::processSamples (const AudioBlock<float>& input, AudioBlock<float>& output) noexcept
+{
+    // prepare must have been called with enough channels for the blocks to process
+    jassert (input.getNumChannels() <= numChannels && output.getNumChannels() <= numChannels);
+
+    auto numChannelsToProcess = jmin (input.getNumChannels(), output.getNumChannels(), numChannels);
+    auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+    // Both circular buffers use the same position: the input sample received at a
+    // given time is written where the output sample for the same time is read. Each
+    // frame is added to the output buffer from the position of its last input sample,
+    // which is read just after, so the latency is fftSize - 1 samples.
+    size_t numSamplesProcessed = 0;
+
+    auto readOutput = [&] (size_t offset, size_t num)
+    {
+        for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+        {
+            auto* data = outputBuffer.getChannelPointer (channel) + position + offset;
+
+            FloatVectorOperations::copy (output.getChannelPointer (channel) + numSamplesProcessed + offset, data, (int) num);
+            FloatVectorOperations::clear (data, (int) num);
+        }
+    };
+
+    while (numSamplesProcessed < numSamples)
+    {
+        auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed,
+                                         (size_t) samplesUntilNextFrame,
+                                         (size_t) fftSize - position);
+
+        for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+            FloatVectorOperations::copy (inputBuffer.getChannelPointer (channel) + position,
+                                         input.getChannelPointer (channel) + numSamplesProcessed,
+                                         (int) numSamplesToProcess);
+
+        samplesUntilNextFrame -= (int) numSamplesToProcess;
+
+        if (samplesUntilNextFrame == 0)
+        {
+            // the other output samples must be read before the frame is added, as
+            // their positions are reused for the following ones
+            readOutput (0, numSamplesToProcess - 1);
+            processFrame (position + numSamplesToProcess - 1);
+            readOutput (numSamplesToProcess - 1, 1);
+
+            samplesUntilNextFrame = hopSize;
+        }
+        else
+        {
+            readOutput (0, numSamplesToProcess);
+        }
+
+        position += numSamplesToProcess;
+
+        if (position == (size_t) fftSize)
+            position = 0;
+
+        numSamplesProcessed += numSamplesToProcess;
+    }
+}
+
+void STFT::processFrame (size_t lastSamplePosition) noexcept
+{
+    // the oldest input sample is the one after the last received
+    auto start = (lastSamplePosition + 1) % (size_t) fftSize;
+    auto numBeforeWrap = (size_t) fftSize - start;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.getChannelPointer (channel);
+        auto* data = inputBuffer.getChannelPointer (channel);
+
+        FloatVectorOperations::multiply (frame, data + start, analysisWindow, (int) numBeforeWrap);
+        FloatVectorOperations::multiply (frame + numBeforeWrap, data, analysisWindow + numBeforeWrap, (int) start);
+    }
+
+    fft.performRealOnlyForwardTransform (framePointers, (int) numChannels, true);
+
+    if (spectrumCallback != nullptr)
+        spectrumCallback (spectra, numChannels);
+
+    fft.performRealOnlyInverseTransform (framePointers, (int) numChannels);
+
+    // the frame is added from the position of its last input sample
+    numBeforeWrap = (size_t) fftSize - lastSamplePosition;
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.getChannelPointer (channel);
+        auto* data = outputBuffer.getChannelPointer (channel);
+
+        FloatVectorOperations::addWithMultiply (data + lastSamplePosition, frame, synthesisWindow, (int) numBeforeWrap);
+        FloatVectorOperations::addWithMultiply (data, frame + numBeforeWrap, synthesisWindow + numBeforeWrap, (int) lastSamplePosition);
+    }
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Performs a streaming short-time Fourier transform of a multichannel signal,
+    so that its spectrum can be processed in the frequency domain, and resynthesised
+    with a weighted overlap-add.
+
+    Each time hopSize new samples have been received, the last getFFTSize() samples
+    of every channel are multiplied by the analysis window and transformed, and the
+    spectrum callback is called so that the spectra can be modified in place. They
+    are then transformed back, multiplied by the synthesis window and added to the
+    output signal.
+
+    The synthesis window is normalised so that the signal is reconstructed exactly
+    when the spectra are not modified, with any window and hop size as long as
+    every sample is covered by a non-zero part of a window. For instance, a Hann
+    window needs a hop size smaller than the frame size. The output is delayed by
+    getLatencyInSamples() samples.
+
+    All the buffers are allocated in prepare(), so the processing itself doesn't
+    allocate any memory, whatever the size of the blocks is.
+
+    @see FFT, WindowingFunction
+
+    @tags{DSP}
+*/
+class JUCE_API  STFT
+{
+public:
+    //==============================================================================
+    /** The function called for every frame, which receives the spectra of all the
+        channels and can modify them in place. Each spectrum contains the
+        getNumBins() positive frequencies of the frame.
+    */
+    using SpectrumCallback = std::function<void (Complex<float>* const* spectra, size_t numChannels)>;
+
+    /** Creates an STFT processor.
+
+        @param fftOrder     the size of the frames will be 2 ^ fftOrder
+        @param hopSize      the number of samples between two frames, which must be
+                            between 1 and the size of the frames
+        @param window       the windowing method used for the analysis and the synthesis
+    */
+    STFT (int fftOrder, int hopSize,
+          WindowingFunction<float>::WindowingMethod window = WindowingFunction<float>::hann);
+
+    /** Destructor. */
+    ~STFT();
+
+    //==============================================================================
+    /** Sets the function called for each frame. This is not real-time safe, and
+        should be called before processing. Without any callback, the signal is
+        simply delayed.
+    */
+    void setSpectrumCallback (SpectrumCallback newCallback);
+
+    /** Returns the size of the frames. */
+    int getFFTSize() const noexcept                 { return fftSize; }
+
+    /** Returns the number of samples between two frames. */
+    int getHopSize() const noexcept                 { return hopSize; }
+
+    /** Returns the number of frequency bins passed to the spectrum callback. */
+    int getNumBins() const noexcept                 { return fftSize / 2 + 1; }
+
+    /** Returns the latency of the processing, which is the size of the frames
+        minus one sample.
+    */
+    int getLatencyInSamples() const noexcept        { return fftSize - 1; }
+
+    //==============================================================================
+    /** Must be called before processing, to allocate the buffers for the given
+        number of channels.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the processing pipeline, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Processes the given set of samples. The input and output blocks can be the same. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, float>::value,
+                       "The STFT class only supports single precision floating point data");
+
+        auto&& inBlock  = context.getInputBlock();
+        auto&& outBlock = context.getOutputBlock();
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outBlock.copy (inBlock);
+
+            return;
+        }
+
+        processSamples (inBlock, outBlock);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<float>&, AudioBlock<float>&) noexcept;
+    void processFrame (size_t lastSamplePosition) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    const int fftSize, hopSize;
+    SpectrumCallback spectrumCallback;
+
+    HeapBlock<float> analysisWindow, synthesisWindow;
+
+    HeapBlock<char> inputData, outputData, framesData;
+    AudioBlock<float> inputBuffer, outputBuffer, frames;
+    HeapBlock<float*> framePointers;
+    HeapBlock<Complex<float>*> spectra;
+
+    size_t numChannels = 0, position = 0;
+    int samplesUntilNextFrame = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFT)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct STFTUnitTest  : public UnitTest
+{
+    STFTUnitTest() : UnitTest ("STFT", "DSP") {}
+
+    // processes a random signal in blocks of random sizes, and returns the largest difference
+    // between the output and the input delayed by the latency and multiplied by the gain
+    static float getMaxReconstructionError (STFT& stft, Random& random, int numChannels, float gain)
+    {
+        constexpr int numSamples = 8192;
+        const auto latency = stft.getLatencyInSamples();
+
+        AudioBuffer<float> input (numChannels, numSamples), output (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+
+        output.makeCopyOf (input);
+        AudioBlock<float> block (output);
+
+        for (int start = 0; start < numSamples;)
+        {
+            auto numBlockSamples = jmin (1 + random.nextInt (600), numSamples - start);
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) numBlockSamples);
+            stft.process (ProcessContextReplacing<float> (subBlock));
+            start += numBlockSamples;
+        }
+
+        float maxError = 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto expected = i < latency ? 0.0f : gain * input.getSample (channel, i - latency);
+                maxError = jmax (maxError, std::abs (output.getSample (channel, i) - expected));
+            }
+        }
+
+        return maxError;
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Perfect reconstruction with COLA windows");
+        {
+            // Hann windows overlapping by 50% and 75%, Hamming overlapping by 50%,
+            // and rectangular windows which don't overlap
+            STFT hannHalf (10, 512, WindowingFunction<float>::hann);
+            STFT hannQuarter (10, 256, WindowingFunction<float>::hann);
+            STFT hamming (9, 256, WindowingFunction<float>::hamming);
+            STFT rectangular (8, 256, WindowingFunction<float>::rectangular);
+
+            for (auto* stft : { &hannHalf, &hannQuarter, &hamming, &rectangular })
+            {
+                stft->prepare ({ 44100.0, 512, 3 });
+                expectLessThan (getMaxReconstructionError (*stft, random, 3, 1.0f), 1.0e-4f);
+            }
+        }
+
+        beginTest ("Perfect reconstruction with other hop sizes");
+        {
+            STFT hann (10, 384, WindowingFunction<float>::hann);
+            STFT blackman (9, 100, WindowingFunction<float>::blackman);
+
+            for (auto* stft : { &hann, &blackman })
+            {
+                stft->prepare ({ 44100.0, 512, 2 });
+                expectLessThan (getMaxReconstructionError (*stft, random, 2, 1.0f), 1.0e-4f);
+            }
+        }
+
+        beginTest ("Processing the spectra");
+        {
+            STFT stft (10, 256, WindowingFunction<float>::hann);
+            size_t numFrames = 0;
+
+            stft.setSpectrumCallback ([&] (Complex<float>* const* spectra, size_t numChannels)
+            {
+                ++numFrames;
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    for (int bin = 0; bin < stft.getNumBins(); ++bin)
+                        spectra[channel][bin] *= 0.5f;
+            });
+
+            stft.prepare ({ 44100.0, 512, 2 });
+            expectLessThan (getMaxReconstructionError (stft, random, 2, 0.5f), 1.0e-4f);
+            expectEquals ((int) numFrames, 8192 / 256);
+        }
+
+        beginTest ("Reset");
+        {
+            STFT stft (9, 128, WindowingFunction<float>::hann);
+            stft.prepare ({ 44100.0, 512, 1 });
+
+            // an unfinished stream, which mustn't be heard in the next one
+            AudioBuffer<float> buffer (1, 300);
+
+            for (int i = 0; i < 300; ++i)
+                buffer.setSample (0, i, 1.0f);
+
+            AudioBlock<float> block (buffer);
+            stft.process (ProcessContextReplacing<float> (block));
+
+            stft.reset();
+            expectLessThan (getMaxReconstructionError (stft, random, 1, 1.0f), 1.0e-4f);
+        }
+    }
+};
+
+static STFTUnitTest stftUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -57,14 +57,21 @@
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_BiquadCascade.cpp"
+#include "processors/juce_DelayLine.cpp"
 #include "processors/juce_LadderFilter.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_FDNReverb.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
+#include "processors/juce_WavetableOscillatorBank.cpp"
 #include "frequency/juce_Convolution.cpp"
+#include "frequency/juce_MatrixConvolution.cpp"
+#include "processors/juce_FIRBlockFilter.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 
 #if JUCE_USE_SIMD
@@ -83,10 +90,24 @@
 
 #if JUCE_UNIT_TESTS
 #include "maths/juce_Matrix_test.cpp"
+#include "maths/juce_LookupTable_test.cpp"
+#include "maths/juce_FastMathApproximations_test.cpp"
 #if JUCE_USE_SIMD
 #include "containers/juce_SIMDRegister_test.cpp"
 #endif
 #include "frequency/juce_FFT_test.cpp"
+#include "frequency/juce_Convolution_test.cpp"
+#include "frequency/juce_MatrixConvolution_test.cpp"
+#include "frequency/juce_STFT_test.cpp"
 #include "processors/juce_FIRFilter_test.cpp"
+#include "processors/juce_IIRFilter_test.cpp"
+#include "processors/juce_BiquadCascade_test.cpp"
+#include "processors/juce_DelayLine_test.cpp"
+#include "processors/juce_StateVariableFilter_test.cpp"
+#include "processors/juce_Oversampling_test.cpp"
+#include "processors/juce_FDNReverb_test.cpp"
+#include "processors/juce_WavetableOscillatorBank_test.cpp"
+#include "processors/juce_ProcessorStateExchange_test.cpp"
+#include "processors/juce_ProcessorChain_test.cpp"
 #endif
 #endif
@@ -220,6 +220,24 @@ namespace juce
             inline void snapToZero (long double& x) noexcept            { ignoreUnused (x); }
            #endif
           #endif
+
+            /** Returns how many channels of a multichannel processor should be processed
+                in lock-step, in groups of numLanes channels each using one lane of a
+                SIMDRegister, the remaining channels being processed one by one.
+
+                A last incomplete group is only used if it fills at least half of the lanes,
+                as the work done on its unused lanes is wasted.
+            */
+            inline size_t getNumSIMDChannels (size_t numChannels, size_t numLanes) noexcept
+            {
+                if (numLanes <= 1)
+                    return 0;
+
+                auto remainder = numChannels % numLanes;
+                auto numGroups = numChannels / numLanes + (remainder > 1 && remainder * 2 >= numLanes ? 1 : 0);
+
+                return jmin (numGroups * numLanes, numChannels);
+            }
         }
     }
 }
@@ -254,20 +272,28 @@ namespace juce
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
+#include "processors/juce_ProcessorStateExchange.h"
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_Bias.h"
 #include "processors/juce_Gain.h"
 #include "processors/juce_WaveShaper.h"
 #include "processors/juce_IIRFilter.h"
+#include "processors/juce_BiquadCascade.h"
+#include "processors/juce_DelayLine.h"
 #include "processors/juce_FIRFilter.h"
+#include "processors/juce_FIRBlockFilter.h"
 #include "processors/juce_Oscillator.h"
+#include "processors/juce_WavetableOscillatorBank.h"
 #include "processors/juce_LadderFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_Oversampling.h"
 #include "processors/juce_Reverb.h"
+#include "processors/juce_FDNReverb.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
+#include "frequency/juce_MatrixConvolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
 
 #endif
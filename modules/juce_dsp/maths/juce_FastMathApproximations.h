@@ -259,6 +259,127 @@ struct FastMathApproximations
         for (size_t i = 0; i < numValues; ++i)
             values[i] = FastMathApproximations::logNPlusOne (values[i]);
     }
+
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Provides a fast approximation of the function cosh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cosh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = (x2 * (x2 * (x2 * 14615 + 1075032) + 18471600) + 39251520) * static_cast<FloatType> (-1);
+        auto denominator = x2 * (x2 * (x2 * 127 - 16632) + 1154160) - 39251520;
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function sinh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sinh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * static_cast<FloatType> (-1) * (x2 * (x2 * (x2 * 479249 + 52785432) + 1640635920) + static_cast<FloatType> (11511339840));
+        auto denominator = x2 * (x2 * (x2 * 18361 - 3177720) + 277920720) - static_cast<FloatType> (11511339840);
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function tanh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tanh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (x2 * (x2 * (x2 + 378) + 17325) + 135135);
+        auto denominator = x2 * (x2 * (x2 * 28 + 3150) + 62370) + 135135;
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function cos(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cos (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = (x2 * (x2 * (x2 * 14615 - 1075032) + 18471600) - 39251520) * static_cast<FloatType> (-1);
+        auto denominator = x2 * (x2 * (x2 * 127 + 16632) + 1154160) + 39251520;
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function sin(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sin (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * static_cast<FloatType> (-1) * (x2 * (x2 * (x2 * 479249 - 52785432) + 1640635920) - static_cast<FloatType> (11511339840));
+        auto denominator = x2 * (x2 * (x2 * 18361 + 3177720) + 277920720) + static_cast<FloatType> (11511339840);
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function tan(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tan (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (x2 * (x2 * (x2 - 378) + 17325) - 135135);
+        auto denominator = x2 * (x2 * (x2 * 28 - 3150) + 62370) - 135135;
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function exp(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -6 and +4 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> exp (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = x * (x * (x * (x + 20) + 180) + 840) + 1680;
+        auto denominator = x * (x * (x * (x - 20) + 180) - 840) + 1680;
+        return numerator / denominator;
+    }
+
+    /** Provides a fast approximation of the function log(x+1) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister.
+
+        Note : this is an approximation which works on a limited range. You are
+        advised to use input values only between -0.8 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> logNPlusOne (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = x * (x * (x * (x * (x * 137 + 2310) + 9870) + 15120) + 7560);
+        auto denominator = x * (x * (x * (x * (x * 30 + 900) + 6300) + 16800) + 18900) + 7560;
+        return numerator / denominator;
+    }
+   #endif
 };
 
 } // namespace dsp
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class FastMathApproximationsTest : public UnitTest
+{
+    // every approximation is called through a structure, so that the same test can
+    // use its scalar, buffer and SIMDRegister versions
+    struct Cosh         { template <typename T> static T get (T x) { return FastMathApproximations::cosh (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::cosh (v, n); } };
+    struct Sinh         { template <typename T> static T get (T x) { return FastMathApproximations::sinh (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::sinh (v, n); } };
+    struct Tanh         { template <typename T> static T get (T x) { return FastMathApproximations::tanh (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::tanh (v, n); } };
+    struct Cos          { template <typename T> static T get (T x) { return FastMathApproximations::cos (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::cos (v, n); } };
+    struct Sin          { template <typename T> static T get (T x) { return FastMathApproximations::sin (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::sin (v, n); } };
+    struct Tan          { template <typename T> static T get (T x) { return FastMathApproximations::tan (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::tan (v, n); } };
+    struct Exp          { template <typename T> static T get (T x) { return FastMathApproximations::exp (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::exp (v, n); } };
+    struct LogNPlusOne  { template <typename T> static T get (T x) { return FastMathApproximations::logNPlusOne (x); }
+                          template <typename T> static void get (T* v, size_t n) { FastMathApproximations::logNPlusOne (v, n); } };
+
+    template <typename FloatType>
+    static FloatType getMaxRelativeDifference (const FloatType* a, const FloatType* b, size_t numValues)
+    {
+        FloatType maxDifference = 0;
+
+        for (size_t i = 0; i < numValues; ++i)
+            maxDifference = jmax (maxDifference, std::abs (a[i] - b[i]) / jmax ((FloatType) 1, std::abs (b[i])));
+
+        return maxDifference;
+    }
+
+    template <typename FloatType, typename Function>
+    void runFunctionTest (Random& random, const String& name, double minInput, double maxInput)
+    {
+        auto tolerance = std::is_same<FloatType, float>::value ? (FloatType) 1.0e-5 : (FloatType) 1.0e-12;
+
+        // lengths which aren't all multiples of the size of the SIMD registers
+        for (size_t numValues : { 1, 3, 5, 8, 17, 100, 1001 })
+        {
+            HeapBlock<FloatType> input (numValues), expected (numValues), results (numValues);
+
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                input[i] = (FloatType) (minInput + random.nextDouble() * (maxInput - minInput));
+                expected[i] = Function::get (input[i]);
+            }
+
+            FloatVectorOperations::copy (results.get(), input.get(), (int) numValues);
+            Function::get (results.get(), numValues);
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), tolerance, name + " buffer");
+
+           #if JUCE_USE_SIMD
+            using Vec = SIMDRegister<FloatType>;
+            alignas (sizeof (Vec)) FloatType lanes[Vec::size()];
+
+            // the last register is padded with the last value
+            for (size_t start = 0; start < numValues; start += Vec::size())
+            {
+                auto num = jmin (Vec::size(), numValues - start);
+
+                for (size_t lane = 0; lane < Vec::size(); ++lane)
+                    lanes[lane] = input[start + jmin (lane, num - 1)];
+
+                Function::get (Vec::fromRawArray (lanes)).copyToRawArray (lanes);
+
+                for (size_t lane = 0; lane < num; ++lane)
+                    results[start + lane] = lanes[lane];
+            }
+
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), tolerance, name + " SIMDRegister");
+           #endif
+        }
+    }
+
+    template <typename FloatType>
+    void runAllFunctionsTest (Random& random)
+    {
+        // the recommended input range of every approximation, avoiding the poles of tan
+        runFunctionTest<FloatType, Cosh>        (random, "cosh", -5.0, 5.0);
+        runFunctionTest<FloatType, Sinh>        (random, "sinh", -5.0, 5.0);
+        runFunctionTest<FloatType, Tanh>        (random, "tanh", -5.0, 5.0);
+        runFunctionTest<FloatType, Cos>         (random, "cos", -MathConstants<double>::pi, MathConstants<double>::pi);
+        runFunctionTest<FloatType, Sin>         (random, "sin", -MathConstants<double>::pi, MathConstants<double>::pi);
+        runFunctionTest<FloatType, Tan>         (random, "tan", -1.5, 1.5);
+        runFunctionTest<FloatType, Exp>         (random, "exp", -6.0, 4.0);
+        runFunctionTest<FloatType, LogNPlusOne> (random, "logNPlusOne", -0.8, 5.0);
+    }
+
+public:
+    FastMathApproximationsTest() : UnitTest ("FastMathApproximations", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Buffers and SIMDRegisters match the scalar functions, float");
+        runAllFunctionsTest<float> (random);
+
+        beginTest ("Buffers and SIMDRegisters match the scalar functions, double");
+        runAllFunctionsTest<double> (random);
+    }
+};
+
+static FastMathApproximationsTest fastMathApproximationsUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -108,6 +108,68 @@ public:
         return jmap (f, x0, x1);
     }
 
+    /** Calculates the approximated values for an array of indices without range checking.
+
+        Use this if you can guarantee that the indices are non-negative and less than numPoints.
+
+        @see getUnchecked
+    */
+    void getUnchecked (const FloatType* indices, FloatType* results, size_t numIndices) const noexcept
+    {
+        jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+        auto* values = data.begin();
+
+        for (size_t i = 0; i < numIndices; ++i)
+        {
+            auto index = indices[i];
+            jassert (isPositiveAndBelow (index, FloatType (getNumPoints())));
+
+            auto j = truncatePositiveToUnsignedInt (index);
+            auto f = index - FloatType (j);
+            auto x0 = values[j];
+
+            results[i] = x0 + f * (values[j + 1] - x0);
+        }
+    }
+
+   #if JUCE_USE_SIMD
+    /** Calculates the approximated values for all the indices of a SIMDRegister without
+        range checking.
+
+        Use this if you can guarantee that the indices are non-negative and less than
+        numPoints.
+
+        @see getUnchecked
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE getUnchecked (SIMDRegister<FloatType> index) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+        auto i = Vec::truncate (index);
+        auto f = index - i;
+        auto* values = data.begin();
+
+        // there's no gather operation, so the table values are read lane by lane
+        alignas (sizeof (Vec)) FloatType indices[Vec::size()], x0[Vec::size()], x1[Vec::size()];
+        i.copyToRawArray (indices);
+
+        for (size_t lane = 0; lane < Vec::size(); ++lane)
+        {
+            jassert (isPositiveAndBelow (indices[lane], FloatType (getNumPoints())));
+
+            auto* p = values + static_cast<int> (indices[lane]);
+            x0[lane] = p[0];
+            x1[lane] = p[1];
+        }
+
+        auto v0 = Vec::fromRawArray (x0);
+        return v0 + f * (Vec::fromRawArray (x1) - v0);
+    }
+   #endif
+
     //==============================================================================
     /** Calculates the approximated value for the given index with range checking.
 
@@ -260,6 +322,38 @@ public:
         return lookupTable[index];
     }
 
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    /** Calculates the approximated values for all the elements of a SIMDRegister without
+        range checking.
+
+        @see processSampleUnchecked
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSampleUnchecked (SIMDRegister<FloatType> value) const noexcept
+    {
+        return lookupTable.getUnchecked (value * scaler + offset);
+    }
+
+    /** Calculates the approximated values for all the elements of a SIMDRegister with
+        range checking.
+
+        @see processSample
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSample (SIMDRegister<FloatType> value) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        auto clipped = Vec::min (Vec::max (value, Vec::expand (minInputValue)), Vec::expand (maxInputValue));
+        return lookupTable.getUnchecked (clipped * scaler + offset);
+    }
+
+    /** @see processSampleUnchecked */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator[] (SIMDRegister<FloatType> value) const noexcept     { return processSampleUnchecked (value); }
+
+    /** @see processSample */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator() (SIMDRegister<FloatType> value) const noexcept     { return processSample (value); }
+   #endif
+
     //==============================================================================
     /** @see processSampleUnchecked */
     FloatType operator[] (FloatType index) const noexcept       { return processSampleUnchecked (index); }
@@ -273,8 +367,20 @@ public:
     */
     void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSampleUnchecked (input[i]);
+        FloatType indices[maxChunkSize];
+
+        for (size_t start = 0; start < numSamples; start += maxChunkSize)
+        {
+            auto num = jmin (maxChunkSize, numSamples - start);
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                jassert (input[start + i] >= minInputValue && input[start + i] <= maxInputValue);
+                indices[i] = scaler * input[start + i] + offset;
+            }
+
+            lookupTable.getUnchecked (indices, output + start, num);
+        }
     }
 
     //==============================================================================
@@ -283,8 +389,17 @@ public:
     */
     void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSample (input[i]);
+        FloatType indices[maxChunkSize];
+
+        for (size_t start = 0; start < numSamples; start += maxChunkSize)
+        {
+            auto num = jmin (maxChunkSize, numSamples - start);
+
+            for (size_t i = 0; i < num; ++i)
+                indices[i] = scaler * jlimit (minInputValue, maxInputValue, input[start + i]) + offset;
+
+            lookupTable.getUnchecked (indices, output + start, num);
+        }
     }
 
     //==============================================================================
@@ -325,6 +440,10 @@ private:
     FloatType minInputValue, maxInputValue;
     FloatType scaler, offset;
 
+    // the arrays are processed in chunks, the indices being computed for a whole
+    // chunk before reading the table
+    static constexpr size_t maxChunkSize = 64;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LookupTableTransform)
 };
 
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class LookupTableTest : public UnitTest
+{
+    template <typename FloatType>
+    static FloatType getTolerance() noexcept    { return std::is_same<FloatType, float>::value ? (FloatType) 1.0e-6 : (FloatType) 1.0e-12; }
+
+    template <typename FloatType>
+    static FloatType getMaxRelativeDifference (const FloatType* a, const FloatType* b, size_t numValues)
+    {
+        FloatType maxDifference = 0;
+
+        for (size_t i = 0; i < numValues; ++i)
+            maxDifference = jmax (maxDifference, std::abs (a[i] - b[i]) / jmax ((FloatType) 1, std::abs (b[i])));
+
+        return maxDifference;
+    }
+
+   #if JUCE_USE_SIMD
+    /** Applies a function on SIMDRegisters to an array whose length doesn't have to be
+        a multiple of the register size, the last register being padded.
+    */
+    template <typename FloatType, typename VecFunction>
+    static void processWithSIMDRegisters (const FloatType* input, FloatType* output, size_t numValues, VecFunction&& function)
+    {
+        using Vec = SIMDRegister<FloatType>;
+        alignas (sizeof (Vec)) FloatType lanes[Vec::size()];
+
+        for (size_t start = 0; start < numValues; start += Vec::size())
+        {
+            auto num = jmin (Vec::size(), numValues - start);
+
+            for (size_t lane = 0; lane < Vec::size(); ++lane)
+                lanes[lane] = input[start + jmin (lane, num - 1)];
+
+            function (Vec::fromRawArray (lanes)).copyToRawArray (lanes);
+
+            for (size_t lane = 0; lane < num; ++lane)
+                output[start + lane] = lanes[lane];
+        }
+    }
+   #endif
+
+    // lengths around the register sizes and the chunk size of the block functions
+    static constexpr size_t lengths[] = { 1, 3, 7, 63, 64, 65, 130, 1001 };
+
+    template <typename FloatType>
+    void runLookupTableTest (Random& random)
+    {
+        constexpr size_t numPoints = 256;
+        LookupTable<FloatType> table ([] (size_t i) { return std::sin ((FloatType) i * (FloatType) 0.05); }, numPoints);
+
+        for (auto numValues : lengths)
+        {
+            HeapBlock<FloatType> indices (numValues), expected (numValues), results (numValues);
+
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                indices[i] = (FloatType) random.nextDouble() * (FloatType) (numPoints - 1);
+                expected[i] = table.getUnchecked (indices[i]);
+            }
+
+            table.getUnchecked (indices.get(), results.get(), numValues);
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+
+           #if JUCE_USE_SIMD
+            FloatVectorOperations::clear (results.get(), (int) numValues);
+            processWithSIMDRegisters (indices.get(), results.get(), numValues,
+                                      [&] (SIMDRegister<FloatType> x) { return table.getUnchecked (x); });
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+           #endif
+        }
+    }
+
+    template <typename FloatType>
+    void runLookupTableTransformTest (Random& random)
+    {
+        const auto minInput = (FloatType) -5, maxInput = (FloatType) 5;
+        LookupTableTransform<FloatType> transform ([] (FloatType x) { return std::tanh (x); }, minInput, maxInput, 512);
+
+        for (auto numValues : lengths)
+        {
+            HeapBlock<FloatType> inRange (numValues), outOfRange (numValues), expected (numValues), results (numValues);
+
+            // the range checked functions also get values outside of the range of the table
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                inRange[i] = minInput + (FloatType) random.nextDouble() * (maxInput - minInput);
+                outOfRange[i] = (FloatType) (random.nextDouble() * 16.0 - 8.0);
+            }
+
+            for (size_t i = 0; i < numValues; ++i)
+                expected[i] = transform.processSampleUnchecked (inRange[i]);
+
+            transform.processUnchecked (inRange.get(), results.get(), numValues);
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+
+           #if JUCE_USE_SIMD
+            processWithSIMDRegisters (inRange.get(), results.get(), numValues,
+                                      [&] (SIMDRegister<FloatType> x) { return transform[x]; });
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+           #endif
+
+            for (size_t i = 0; i < numValues; ++i)
+                expected[i] = transform.processSample (outOfRange[i]);
+
+            transform.process (outOfRange.get(), results.get(), numValues);
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+
+           #if JUCE_USE_SIMD
+            processWithSIMDRegisters (outOfRange.get(), results.get(), numValues,
+                                      [&] (SIMDRegister<FloatType> x) { return transform (x); });
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+           #endif
+
+            // the processing can be done in place
+            FloatVectorOperations::copy (results.get(), outOfRange.get(), (int) numValues);
+            transform.process (results.get(), results.get(), numValues);
+            expectLessOrEqual (getMaxRelativeDifference (results.get(), expected.get(), numValues), getTolerance<FloatType>());
+        }
+    }
+
+    template <typename FloatType>
+    void runWaveShaperTest (Random& random)
+    {
+        WaveShaper<FloatType, LookupTableTransform<FloatType>> waveShaper;
+        waveShaper.functionToUse.initialise ([] (FloatType x) { return std::tanh (x); }, (FloatType) -5, (FloatType) 5, 512);
+
+        constexpr int numChannels = 3;
+
+        for (auto numValues : lengths)
+        {
+            AudioBuffer<FloatType> input (numChannels, (int) numValues), output (numChannels, (int) numValues),
+                                   expected (numChannels, (int) numValues);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < (int) numValues; ++i)
+                {
+                    input.setSample (channel, i, (FloatType) (random.nextDouble() * 16.0 - 8.0));
+                    expected.setSample (channel, i, waveShaper.processSample (input.getSample (channel, i)));
+                }
+            }
+
+            AudioBlock<FloatType> inputBlock (input), outputBlock (output);
+            waveShaper.process (ProcessContextNonReplacing<FloatType> (inputBlock, outputBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                expectLessOrEqual (getMaxRelativeDifference (output.getReadPointer (channel), expected.getReadPointer (channel), numValues),
+                                   getTolerance<FloatType>());
+
+            waveShaper.process (ProcessContextReplacing<FloatType> (inputBlock));
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                expectLessOrEqual (getMaxRelativeDifference (input.getReadPointer (channel), expected.getReadPointer (channel), numValues),
+                                   getTolerance<FloatType>());
+        }
+    }
+
+public:
+    LookupTableTest() : UnitTest ("LookupTable", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("LookupTable arrays and SIMDRegisters, float");
+        runLookupTableTest<float> (random);
+
+        beginTest ("LookupTable arrays and SIMDRegisters, double");
+        runLookupTableTest<double> (random);
+
+        beginTest ("LookupTableTransform blocks and SIMDRegisters, float");
+        runLookupTableTransformTest<float> (random);
+
+        beginTest ("LookupTableTransform blocks and SIMDRegisters, double");
+        runLookupTableTransformTest<double> (random);
+
+        beginTest ("WaveShaper with a LookupTableTransform, float");
+        runWaveShaperTest<float> (random);
+
+        beginTest ("WaveShaper with a LookupTableTransform, double");
+        runWaveShaperTest<double> (random);
+    }
+};
+
+constexpr size_t LookupTableTest::lengths[];
+
+static LookupTableTest lookupTableUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -110,40 +110,106 @@ Matrix<ElementType>& Matrix<ElementType>::swapRows (size_t rowOne, size_t rowTwo
 }
 
 //==============================================================================
-template <typename ElementType>
-Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
+namespace MatrixHelpers
 {
-    auto n = getNumRows(), m = other.getNumColumns(), p = getNumColumns();
-    Matrix result (n, m);
+    // Adds the product of numRows rows of the left matrix with a block of
+    // tileWidth columns of the right matrix to the destination, keeping the
+    // results in registers while iterating over the common dimension
+    template <size_t numRows, size_t tileWidth, typename ElementType>
+    static void multiplyTile (ElementType* dst, const ElementType* lhs, const ElementType* rhs,
+                              size_t lhsStride, size_t rhsStride, size_t start, size_t end) noexcept
+    {
+        ElementType results[numRows][tileWidth];
 
-    jassert (p == other.getNumRows());
+        for (size_t r = 0; r < numRows; ++r)
+            for (size_t c = 0; c < tileWidth; ++c)
+                results[r][c] = dst[r * rhsStride + c];
 
-    size_t offsetMat = 0, offsetlhs = 0;
+        for (size_t k = start; k < end; ++k)
+        {
+            auto* row = rhs + k * rhsStride;
 
-    auto* dst = result.getRawDataPointer();
-    auto* a = getRawDataPointer();
-    auto* b = other.getRawDataPointer();
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                auto coefficient = lhs[r * lhsStride + k];
 
-    for (size_t i = 0; i < n; ++i)
+                for (size_t c = 0; c < tileWidth; ++c)
+                    results[r][c] += coefficient * row[c];
+            }
+        }
+
+        for (size_t r = 0; r < numRows; ++r)
+            for (size_t c = 0; c < tileWidth; ++c)
+                dst[r * rhsStride + c] = results[r][c];
+    }
+
+    template <size_t numRows, typename ElementType>
+    static void multiplyRows (ElementType* dst, const ElementType* lhs, const ElementType* rhs,
+                              size_t lhsStride, size_t rhsStride, size_t start, size_t end) noexcept
     {
-        size_t offsetrhs = 0;
+        const size_t tileWidth = 16;
+        size_t j = 0;
+
+        for (; j + tileWidth <= rhsStride; j += tileWidth)
+            multiplyTile<numRows, tileWidth> (dst + j, lhs, rhs + j, lhsStride, rhsStride, start, end);
 
-        for (size_t k = 0; k < p; ++k)
+        for (; j < rhsStride; ++j)
         {
-            auto ak = a[offsetlhs++];
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                auto sum = dst[r * rhsStride + j];
 
-            for (size_t j = 0; j < m; ++j)
-                dst[offsetMat + j] += ak * b[offsetrhs + j];
+                for (size_t k = start; k < end; ++k)
+                    sum += lhs[r * lhsStride + k] * rhs[k * rhsStride + j];
 
-            offsetrhs += m;
+                dst[r * rhsStride + j] = sum;
+            }
         }
-
-        offsetMat += m;
     }
+}
+
+template <typename ElementType>
+Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
+{
+    Matrix result (getNumRows(), other.getNumColumns());
+    multiply (result, *this, other);
 
     return result;
 }
 
+template <typename ElementType>
+void Matrix<ElementType>::multiply (Matrix& result, const Matrix& a, const Matrix& b) noexcept
+{
+    auto n = a.getNumRows(), p = a.getNumColumns(), m = b.getNumColumns();
+
+    jassert (p == b.getNumRows());
+    jassert (result.getNumRows() == n && result.getNumColumns() == m);
+    jassert (&result != &a && &result != &b);
+
+    result.clear();
+
+    auto* dst = result.getRawDataPointer();
+    auto* lhs = a.getRawDataPointer();
+    auto* rhs = b.getRawDataPointer();
+
+    // The common dimension is split in blocks so that the rows of the right matrix
+    // used for a block stay in the cache, and four rows are computed at once so
+    // that every element of the right matrix which is loaded is used four times
+    const size_t blockSize = 256;
+
+    for (size_t start = 0; start < p; start += blockSize)
+    {
+        auto end = jmin (p, start + blockSize);
+        size_t i = 0;
+
+        for (; i + 4 <= n; i += 4)
+            MatrixHelpers::multiplyRows<4> (dst + i * m, lhs + i * p, rhs, p, m, start, end);
+
+        for (; i < n; ++i)
+            MatrixHelpers::multiplyRows<1> (dst + i * m, lhs + i * p, rhs, p, m, start, end);
+    }
+}
+
 //==============================================================================
 template <typename ElementType>
 bool Matrix<ElementType>::compare (const Matrix& a, const Matrix& b, ElementType tolerance) noexcept
@@ -229,51 +295,174 @@ bool Matrix<ElementType>::solve (Matrix& b) const noexcept
         default:
         {
             Matrix<ElementType> M (A);
+            Array<size_t> pivots;
 
-            for (size_t j = 0; j < n; ++j)
-            {
-                if (M (j, j) == 0)
-                {
-                    auto i = j;
-                    while (i < n && M (i, j) == 0)
-                        ++i;
+            if (! M.decomposeLU (pivots))
+                return false;
 
-                    if (i == n)
-                        return false;
+            M.solveLU (pivots, b);
+        }
+    }
 
-                    for (size_t k = 0; k < n; ++k)
-                        M (j, k) += M (i, k);
+    return true;
+}
 
-                    x[j] += x[i];
-                }
+template <typename ElementType>
+bool Matrix<ElementType>::decomposeLU (Array<size_t>& pivots)
+{
+    jassert (isSquare());
 
-                auto t = 1 / M (j, j);
+    auto n = rows;
+    auto* p = getRawDataPointer();
 
-                for (size_t k = 0; k < n; ++k)
-                    M (j, k) *= t;
+    pivots.resize (static_cast<int> (n));
 
-                x[j] *= t;
+    for (size_t k = 0; k < n; ++k)
+    {
+        // the row with the largest value in the column is used as the pivot
+        auto pivot = k;
 
-                for (size_t k = j + 1; k < n; ++k)
-                {
-                    auto u = -M (k, j);
+        for (size_t i = k + 1; i < n; ++i)
+            if (std::abs (p[i * n + k]) > std::abs (p[pivot * n + k]))
+                pivot = i;
 
-                    for (size_t l = 0; l < n; ++l)
-                        M (k, l) += u * M (j, l);
+        pivots.setUnchecked (static_cast<int> (k), pivot);
 
-                    x[k] += u * x[j];
-                }
-            }
+        if (p[pivot * n + k] == 0)
+            return false;
+
+        if (pivot != k)
+            swapRows (k, pivot);
 
-            for (int k = static_cast<int> (n) - 2; k >= 0; --k)
-                for (size_t i = static_cast<size_t> (k) + 1; i < n; ++i)
-                    x[k] -= M (static_cast<size_t> (k), i) * x[i];
+        auto* rowK = p + k * n;
+        auto inverse = 1 / rowK[k];
+
+        for (size_t i = k + 1; i < n; ++i)
+        {
+            auto* rowI = p + i * n;
+            auto factor = rowI[k] * inverse;
+            rowI[k] = factor;
+
+            for (size_t j = k + 1; j < n; ++j)
+                rowI[j] -= factor * rowK[j];
         }
     }
 
     return true;
 }
 
+template <typename ElementType>
+void Matrix<ElementType>::solveLU (const Array<size_t>& pivots, Matrix& b) const noexcept
+{
+    auto n = rows, m = b.columns;
+
+    jassert (isSquare() && b.rows == n && static_cast<size_t> (pivots.size()) == n);
+
+    for (size_t k = 0; k < n; ++k)
+        if (pivots.getUnchecked (static_cast<int> (k)) != k)
+            b.swapRows (k, pivots.getUnchecked (static_cast<int> (k)));
+
+    auto* lu = getRawDataPointer();
+    auto* x = b.getRawDataPointer();
+
+    // forward substitution with the unit lower triangular matrix
+    for (size_t i = 1; i < n; ++i)
+        for (size_t k = 0; k < i; ++k)
+            for (size_t j = 0; j < m; ++j)
+                x[i * m + j] -= lu[i * n + k] * x[k * m + j];
+
+    // back substitution with the upper triangular matrix
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < n; ++k)
+            for (size_t j = 0; j < m; ++j)
+                x[i * m + j] -= lu[i * n + k] * x[k * m + j];
+
+        auto inverse = 1 / lu[i * n + i];
+
+        for (size_t j = 0; j < m; ++j)
+            x[i * m + j] *= inverse;
+    }
+}
+
+template <typename ElementType>
+bool Matrix<ElementType>::decomposeCholesky() noexcept
+{
+    jassert (isSquare());
+
+    auto n = rows;
+    auto* p = getRawDataPointer();
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        auto* rowJ = p + j * n;
+        auto sum = rowJ[j];
+
+        for (size_t k = 0; k < j; ++k)
+            sum -= rowJ[k] * rowJ[k];
+
+        // the matrix isn't positive definite
+        if (sum <= 0)
+            return false;
+
+        rowJ[j] = std::sqrt (sum);
+        auto inverse = 1 / rowJ[j];
+
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            auto* rowI = p + i * n;
+            auto value = rowI[j];
+
+            for (size_t k = 0; k < j; ++k)
+                value -= rowI[k] * rowJ[k];
+
+            rowI[j] = value * inverse;
+        }
+
+        for (size_t k = j + 1; k < n; ++k)
+            rowJ[k] = 0;
+    }
+
+    return true;
+}
+
+template <typename ElementType>
+void Matrix<ElementType>::solveCholesky (Matrix& b) const noexcept
+{
+    auto n = rows, m = b.columns;
+
+    jassert (isSquare() && b.rows == n);
+
+    auto* l = getRawDataPointer();
+    auto* x = b.getRawDataPointer();
+
+    // forward substitution with the lower triangular matrix
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t k = 0; k < i; ++k)
+            for (size_t j = 0; j < m; ++j)
+                x[i * m + j] -= l[i * n + k] * x[k * m + j];
+
+        auto inverse = 1 / l[i * n + i];
+
+        for (size_t j = 0; j < m; ++j)
+            x[i * m + j] *= inverse;
+    }
+
+    // back substitution with its transpose
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < n; ++k)
+            for (size_t j = 0; j < m; ++j)
+                x[i * m + j] -= l[k * n + i] * x[k * m + j];
+
+        auto inverse = 1 / l[i * n + i];
+
+        for (size_t j = 0; j < m; ++j)
+            x[i * m + j] *= inverse;
+    }
+}
+
 //==============================================================================
 template <typename ElementType>
 String Matrix<ElementType>::toString() const
@@ -161,6 +161,12 @@ public:
     /** Matrix multiplication */
     Matrix operator* (const Matrix& other) const;
 
+    /** Multiplies the matrices a and b and stores the product in result, which must
+        already have the right size and must not be one of the two operands. Unlike
+        the multiplication operator, this doesn't allocate any memory.
+    */
+    static void multiply (Matrix& result, const Matrix& a, const Matrix& b) noexcept;
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
     inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
 
@@ -202,6 +208,42 @@ public:
      */
     bool solve (Matrix& b) const noexcept;
 
+    /** Replaces this square matrix with its LU decomposition with partial pivoting,
+        which can then be used to solve any number of linear systems with solveLU().
+
+        The unit lower triangular matrix L is stored below the diagonal, and the upper
+        triangular matrix U on and above it. The index of the row swapped with each
+        row is stored in the pivots array.
+
+        Returns false if the matrix is singular.
+    */
+    bool decomposeLU (Array<size_t>& pivots);
+
+    /** Solves the linear systems of equations A x = b, where this object holds the LU
+        decomposition of A computed by decomposeLU().
+
+        The matrix b can have any number of columns, one for each system. After the
+        execution of the algorithm, it will contain the solutions.
+    */
+    void solveLU (const Array<size_t>& pivots, Matrix& b) const noexcept;
+
+    /** Replaces this symmetric positive definite matrix with its Cholesky decomposition,
+        the lower triangular matrix L such as A = L L^T, which can then be used to solve
+        any number of linear systems with solveCholesky(). Only the lower triangular
+        part of the matrix is used.
+
+        Returns false if the matrix isn't positive definite.
+    */
+    bool decomposeCholesky() noexcept;
+
+    /** Solves the linear systems of equations A x = b, where this object holds the
+        Cholesky decomposition of A computed by decomposeCholesky().
+
+        The matrix b can have any number of columns, one for each system. After the
+        execution of the algorithm, it will contain the solutions.
+    */
+    void solveCholesky (Matrix& b) const noexcept;
+
     //==============================================================================
     /** Returns a String displaying in a convenient way the matrix contents. */
     String toString() const;
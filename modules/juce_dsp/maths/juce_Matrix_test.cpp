@@ -145,6 +145,94 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    struct LargeMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 37, p = 70, m = 21;
+            Matrix<ElementType> a (n, p), b (p, m), expected (n, m), result (n, m);
+            auto random = u.getRandom();
+
+            fillRandomly (random, a);
+            fillRandomly (random, b);
+
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < m; ++j)
+                    for (size_t k = 0; k < p; ++k)
+                        expected (i, j) += a (i, k) * b (k, j);
+
+            Matrix<ElementType>::multiply (result, a, b);
+
+            u.expect (Matrix<ElementType>::compare (result, expected, (ElementType) 1e-4));
+            u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-4));
+        }
+    };
+
+    struct LUDecompositionTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 20, numSystems = 3;
+            Matrix<ElementType> A (n, n), B (n, numSystems);
+            auto random = u.getRandom();
+
+            fillRandomly (random, A);
+            fillRandomly (random, B);
+
+            Matrix<ElementType> LU (A), X (B);
+            Array<size_t> pivots;
+
+            u.expect (LU.decomposeLU (pivots));
+            LU.solveLU (pivots, X);
+
+            u.expect (Matrix<ElementType>::compare (A * X, B, (ElementType) 1e-3));
+
+            Matrix<ElementType> singular (3, 3);
+            u.expect (! singular.decomposeLU (pivots));
+        }
+    };
+
+    struct CholeskyDecompositionTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            const size_t n = 20, numSystems = 3;
+            Matrix<ElementType> M (n, n), B (n, numSystems);
+            auto random = u.getRandom();
+
+            fillRandomly (random, M);
+            fillRandomly (random, B);
+
+            // M M^T + n I is symmetric positive definite
+            auto A = Matrix<ElementType>::identity (n) * (ElementType) n;
+
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    for (size_t k = 0; k < n; ++k)
+                        A (i, j) += M (i, k) * M (j, k);
+
+            Matrix<ElementType> L (A), X (B);
+
+            u.expect (L.decomposeCholesky());
+            L.solveCholesky (X);
+
+            u.expect (Matrix<ElementType>::compare (A * X, B, (ElementType) 1e-3));
+
+            auto notPositive = Matrix<ElementType>::identity (3) * (ElementType) -1;
+            u.expect (! notPositive.decomposeCholesky());
+        }
+    };
+
+    template <typename ElementType>
+    static void fillRandomly (Random& random, Matrix<ElementType>& matrix)
+    {
+        for (auto& x : matrix)
+            x = (ElementType) (random.nextDouble() * 2.0 - 1.0);
+    }
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -163,6 +251,9 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
+        runTestForAllTypes<LUDecompositionTest> ("LUDecompositionTest");
+        runTestForAllTypes<CholeskyDecompositionTest> ("CholeskyDecompositionTest");
     }
 };
 
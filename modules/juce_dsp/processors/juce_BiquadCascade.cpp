@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+template <typename SampleType>
+BiquadCascade<SampleType>::BiquadCascade()
+{
+}
+
+template <typename SampleType>
+BiquadCascade<SampleType>::BiquadCascade (const Array<Coefficients<SampleType>>& sections)
+{
+    setSections (sections);
+}
+
+template <typename SampleType>
+BiquadCascade<SampleType>::~BiquadCascade()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiquadCascade<SampleType>::setSections (const Array<Coefficients<SampleType>>& sections)
+{
+    if (sections.size() != numSections)
+    {
+        numSections = sections.size();
+        coefficients.malloc (5 * (size_t) numSections);
+        allocateStates();
+    }
+
+    for (int i = 0; i < numSections; ++i)
+        setSection (i, sections.getReference (i));
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::setSection (int sectionIndex, const Coefficients<SampleType>& section) noexcept
+{
+    jassert (isPositiveAndBelow (sectionIndex, numSections));
+
+    auto order = section.getFilterOrder();
+    auto* c = section.getRawCoefficients();
+    auto* dest = coefficients + 5 * sectionIndex;
+
+    // only first and second order sections can be used
+    jassert (order == 1 || order == 2);
+
+    if (order == 1)
+    {
+        dest[0] = c[0];  dest[1] = c[1];  dest[2] = 0;
+        dest[3] = c[2];  dest[4] = 0;
+    }
+    else
+    {
+        dest[0] = c[0];  dest[1] = c[1];  dest[2] = c[2];
+        dest[3] = c[3];  dest[4] = c[4];
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiquadCascade<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.maximumBlockSize > 0);
+
+    numChannels = spec.numChannels;
+    maximumBlockSize = spec.maximumBlockSize;
+
+    allocateStates();
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::allocateStates()
+{
+   #if JUCE_USE_SIMD
+    auto numLanes = SIMDRegister<SampleType>::size();
+   #else
+    size_t numLanes = 1;
+   #endif
+
+    numSIMDChannels = util::getNumSIMDChannels (numChannels, numLanes);
+    auto numGroups = (numSIMDChannels + numLanes - 1) / numLanes;
+
+    // The states of the channels processed one by one come first, followed by the
+    // interleaved states of every group of channels
+    auto numStates = 2 * (size_t) numSections;
+    auto numScalarChannels = numChannels - numSIMDChannels;
+
+    states = AudioBlock<SampleType> (statesData, numScalarChannels + numGroups, numStates * numLanes);
+    interleaved = AudioBlock<SampleType> (interleavedData, numGroups > 0 ? 1 : 0, maximumBlockSize * numLanes);
+
+    reset();
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::reset() noexcept
+{
+    states.clear();
+}
+
+//==============================================================================
+template <typename SampleType>
+template <typename Type>
+void BiquadCascade<SampleType>::processSections (Type* data, Type* state, size_t numSamples) const noexcept
+{
+    for (int section = 0; section < numSections; ++section)
+    {
+        auto* c = coefficients + 5 * section;
+        auto b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+
+        auto lv1 = state[2 * section];
+        auto lv2 = state[2 * section + 1];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto in = data[i];
+            auto out = (in * b0) + lv1;
+            data[i] = out;
+
+            lv1 = (in * b1) - (out * a1) + lv2;
+            lv2 = (in * b2) - (out * a2);
+        }
+
+        util::snapToZero (lv1); state[2 * section]     = lv1;
+        util::snapToZero (lv2); state[2 * section + 1] = lv2;
+    }
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::processSamples (const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output) noexcept
+{
+    jassert (input.getNumChannels() <= numChannels);
+
+    auto numChannelsToProcess = jmin (input.getNumChannels(), output.getNumChannels(), numChannels);
+    auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+    auto numScalarChannels = numChannels - numSIMDChannels;
+    size_t channel = 0;
+
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+    auto numLanes = Vec::size();
+
+    // The channels processed in lock-step are interleaved, so that every sample
+    // of the SIMD buffer holds one sample of each channel of the group
+    for (; channel < jmin (numSIMDChannels, numChannelsToProcess); channel += numLanes)
+    {
+        auto* data = interleaved.getChannelPointer (0);
+        auto* state = states.getChannelPointer (numScalarChannels + channel / numLanes);
+        auto numLanesUsed = jmin (numLanes, numChannelsToProcess - channel);
+
+        jassert (Vec::isSIMDAligned (data) && Vec::isSIMDAligned (state));
+
+        // the interleaved buffer only holds maximumBlockSize samples of every lane,
+        // so longer blocks are processed in several chunks
+        for (size_t start = 0; start < numSamples; start += maximumBlockSize)
+        {
+            auto numChunkSamples = jmin (maximumBlockSize, numSamples - start);
+
+            if (numLanesUsed < numLanes)
+                FloatVectorOperations::clear (data, static_cast<int> (numChunkSamples * numLanes));
+
+            for (size_t lane = 0; lane < numLanesUsed; ++lane)
+            {
+                auto* src = input.getChannelPointer (channel + lane) + start;
+
+                for (size_t i = 0; i < numChunkSamples; ++i)
+                    data[i * numLanes + lane] = src[i];
+            }
+
+            processSections (reinterpret_cast<Vec*> (data), reinterpret_cast<Vec*> (state), numChunkSamples);
+
+            for (size_t lane = 0; lane < numLanesUsed; ++lane)
+            {
+                auto* dst = output.getChannelPointer (channel + lane) + start;
+
+                for (size_t i = 0; i < numChunkSamples; ++i)
+                    dst[i] = data[i * numLanes + lane];
+            }
+        }
+    }
+   #endif
+
+    for (; channel < numChannelsToProcess; ++channel)
+    {
+        auto* dst = output.getChannelPointer (channel);
+
+        if (dst != input.getChannelPointer (channel))
+            FloatVectorOperations::copy (dst, input.getChannelPointer (channel), static_cast<int> (numSamples));
+
+        processSections (dst, states.getChannelPointer (channel - numSIMDChannels), numSamples);
+    }
+}
+
+template class BiquadCascade<float>;
+template class BiquadCascade<double>;
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
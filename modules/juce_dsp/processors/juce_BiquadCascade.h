@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+/**
+    A multi-channel processor applying a cascade of first and second order IIR
+    sections, such as the ones returned by the high order methods of the class
+    FilterDesign, or the bands of an equaliser.
+
+    Every section is processed using the Transposed Direct Form II structure, like
+    in the class IIR::Filter. The filter states are stored in a structure of arrays
+    layout, and when SIMD is available the channels are processed in groups of
+    SIMDRegister::size() in lock-step, each channel of a group using one lane of
+    the SIMD registers. All the sections are then applied one after the other on
+    the whole block, so processing 8 channels costs about as much as processing
+    one or two channels with IIR::Filter.
+
+    @code
+    IIR::BiquadCascade<float> lowpass (FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (1000.0f, 44100.0, 8));
+    @endcode
+
+    @see IIR::Filter, FilterDesign
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  BiquadCascade
+{
+public:
+    //==============================================================================
+    /** Creates an empty cascade, which doesn't change the signal. */
+    BiquadCascade();
+
+    /** Creates a cascade from an array of sections of order 1 or 2. */
+    BiquadCascade (const Array<Coefficients<SampleType>>& sections);
+
+    /** Destructor. */
+    ~BiquadCascade();
+
+    //==============================================================================
+    /** Replaces all the sections of the cascade, which must be of order 1 or 2.
+        This isn't real-time safe if the number of sections changes, in which case
+        the processing is reset as well.
+    */
+    void setSections (const Array<Coefficients<SampleType>>& sections);
+
+    /** Replaces the coefficients of one of the sections, which must be of order 1
+        or 2, without resetting its state. This is real-time safe, but it's up to
+        the caller to ensure that it isn't done during the processing.
+    */
+    void setSection (int sectionIndex, const Coefficients<SampleType>& section) noexcept;
+
+    /** Returns the number of sections. */
+    int getNumSections() const noexcept                 { return numSections; }
+
+    //==============================================================================
+    /** Called before processing starts, to allocate the states for the number of
+        channels of the specification.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the processing pipeline, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Processes the input and output samples supplied in the processing context.
+        The context must not have more channels than the number given to prepare, but
+        blocks longer than its maximum block size are processed in several chunks.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample-type of the cascade must match the sample-type supplied to this process callback");
+
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copy (inputBlock);
+
+            return;
+        }
+
+        processSamples (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output) noexcept;
+    void allocateStates();
+
+    template <typename Type>
+    void processSections (Type* data, Type* states, size_t numSamples) const noexcept;
+
+    //==============================================================================
+    // b0, b1, b2, a1 and a2 for every section
+    HeapBlock<SampleType> coefficients;
+    int numSections = 0;
+
+    size_t numChannels = 0, numSIMDChannels = 0, maximumBlockSize = 0;
+    HeapBlock<char> statesData, interleavedData;
+    AudioBlock<SampleType> states, interleaved;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BiquadCascade)
+};
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
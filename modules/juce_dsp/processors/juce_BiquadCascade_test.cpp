@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class BiquadCascadeTest : public UnitTest
+{
+    template <typename SampleType>
+    static Array<IIR::Coefficients<SampleType>> createSections (double sampleRate)
+    {
+        // an odd order, so that the cascade has a first order section too
+        auto sections = FilterDesign<SampleType>::designIIRLowpassHighOrderButterworthMethod ((SampleType) 2000, sampleRate, 7);
+        sections.add (*IIR::Coefficients<SampleType>::makePeakFilter (sampleRate, (SampleType) 500, (SampleType) 2, (SampleType) 3));
+
+        return sections;
+    }
+
+    template <typename SampleType>
+    void runCascadeTest (Random& random, size_t numChannels)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr size_t maximumBlockSize = 128;
+        constexpr size_t numSamples = 4096;
+
+        auto sections = createSections<SampleType> (sampleRate);
+
+        IIR::BiquadCascade<SampleType> cascade (sections);
+        cascade.prepare ({ sampleRate, (uint32) maximumBlockSize, (uint32) numChannels });
+
+        // the reference is a chain of IIR::Filter for every channel
+        OwnedArray<IIR::Filter<SampleType>> filters;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            for (auto& section : sections)
+            {
+                auto* filter = filters.add (new IIR::Filter<SampleType> (new IIR::Coefficients<SampleType> (section)));
+                filter->prepare ({ sampleRate, (uint32) maximumBlockSize, 1 });
+            }
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, (int) numSamples), expected ((int) numChannels, (int) numSamples);
+
+        for (int channel = 0; channel < (int) numChannels; ++channel)
+        {
+            for (int i = 0; i < (int) numSamples; ++i)
+            {
+                auto sample = (SampleType) (2.0f * random.nextFloat() - 1.0f);
+                input.setSample (channel, i, sample);
+
+                for (int section = 0; section < sections.size(); ++section)
+                    sample = filters.getUnchecked (channel * sections.size() + section)->processSample (sample);
+
+                expected.setSample (channel, i, sample);
+            }
+        }
+
+        // random block sizes, some of them longer than the maximum block size
+        AudioBuffer<SampleType> output (input);
+        AudioBlock<SampleType> block (output);
+
+        for (size_t start = 0; start < numSamples;)
+        {
+            auto numBlockSamples = jmin ((size_t) (1 + random.nextInt ((int) maximumBlockSize * 3)), numSamples - start);
+            auto subBlock = block.getSubBlock (start, numBlockSamples);
+            cascade.process (ProcessContextReplacing<SampleType> (subBlock));
+            start += numBlockSamples;
+        }
+
+        SampleType maxDifference = 0;
+
+        for (int channel = 0; channel < (int) numChannels; ++channel)
+            for (int i = 0; i < (int) numSamples; ++i)
+                maxDifference = jmax (maxDifference, std::abs (output.getSample (channel, i) - expected.getSample (channel, i)));
+
+        expectLessThan ((double) maxDifference, 1.0e-4);
+    }
+
+public:
+    BiquadCascadeTest() : UnitTest ("Biquad Cascade", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Same output as a chain of IIR filters, float");
+        {
+            for (size_t numChannels = 1; numChannels <= 11; ++numChannels)
+                runCascadeTest<float> (random, numChannels);
+        }
+
+        beginTest ("Same output as a chain of IIR filters, double");
+        {
+            for (size_t numChannels = 1; numChannels <= 11; ++numChannels)
+                runCascadeTest<double> (random, numChannels);
+        }
+
+        beginTest ("Processing fewer channels than prepared");
+        {
+            constexpr double sampleRate = 48000.0;
+            auto sections = createSections<float> (sampleRate);
+
+            IIR::BiquadCascade<float> cascade (sections), reference (sections);
+            cascade.prepare ({ sampleRate, 64, 8 });
+            reference.prepare ({ sampleRate, 64, 3 });
+
+            AudioBuffer<float> buffer (3, 256);
+
+            for (int channel = 0; channel < 3; ++channel)
+                for (int i = 0; i < 256; ++i)
+                    buffer.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+
+            AudioBuffer<float> referenceBuffer (buffer);
+            AudioBlock<float> block (buffer), referenceBlock (referenceBuffer);
+
+            for (size_t start = 0; start < 256; start += 64)
+            {
+                auto subBlock = block.getSubBlock (start, 64);
+                auto referenceSubBlock = referenceBlock.getSubBlock (start, 64);
+                cascade.process (ProcessContextReplacing<float> (subBlock));
+                reference.process (ProcessContextReplacing<float> (referenceSubBlock));
+            }
+
+            float maxDifference = 0;
+
+            for (int channel = 0; channel < 3; ++channel)
+                for (int i = 0; i < 256; ++i)
+                    maxDifference = jmax (maxDifference, std::abs (buffer.getSample (channel, i) - referenceBuffer.getSample (channel, i)));
+
+            expectLessThan (maxDifference, 1.0e-5f);
+        }
+    }
+};
+
+static BiquadCascadeTest biquadCascadeUnitTest;
+
+} // namespace dsp
+} // namespace juce
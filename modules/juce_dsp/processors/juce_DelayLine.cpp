@@ -0,0 +1,441 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace DelayLineHelpers
+{
+    // Splits a delay into a whole number of samples and a fraction, which lies
+    // between 0.618 and 1.618 for the Thiran interpolation whenever possible, as the
+    // allpass filter has the flattest group delay in that range
+    template <typename SampleType>
+    static size_t splitThiranDelay (SampleType delayInSamples, SampleType& fraction) noexcept
+    {
+        auto whole = static_cast<size_t> (delayInSamples);
+        fraction = delayInSamples - static_cast<SampleType> (whole);
+
+        if (fraction < static_cast<SampleType> (0.618) && whole > 0)
+        {
+            --whole;
+            fraction += 1;
+        }
+
+        return whole;
+    }
+
+    template <typename SampleType>
+    static SampleType getThiranCoefficient (SampleType fraction) noexcept
+    {
+        return (1 - fraction) / (1 + fraction);
+    }
+
+    // The Lagrange interpolation uses the samples around the fractional position
+    // when the delay is long enough, so its whole part is one sample shorter
+    template <typename SampleType>
+    static size_t getLagrangeCoefficients (SampleType delayInSamples, SampleType* c) noexcept
+    {
+        auto whole = delayInSamples >= 1 ? static_cast<size_t> (delayInSamples) - 1 : 0;
+        auto f = delayInSamples - static_cast<SampleType> (whole);
+
+        auto f1 = f - 1, f2 = f - 2, f3 = f - 3;
+
+        c[0] = -f1 * f2 * f3 / 6;
+        c[1] =  f  * f2 * f3 / 2;
+        c[2] = -f  * f1 * f3 / 2;
+        c[3] =  f  * f1 * f2 / 6;
+
+        return whole;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+DelayLine<SampleType>::DelayLine()
+{
+}
+
+template <typename SampleType>
+DelayLine<SampleType>::DelayLine (int maximumDelayInSamples)
+{
+    setMaximumDelayInSamples (maximumDelayInSamples);
+}
+
+template <typename SampleType>
+DelayLine<SampleType>::~DelayLine()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void DelayLine<SampleType>::setMaximumDelayInSamples (int maxDelayInSamples)
+{
+    jassert (maxDelayInSamples >= 0);
+
+    maximumDelay = jmax (0, maxDelayInSamples);
+    delay = jmin (delay, static_cast<SampleType> (maximumDelay));
+
+    if (bufferSize > 0)
+        allocateBuffers();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::setDelay (SampleType newDelayInSamples) noexcept
+{
+    jassert (newDelayInSamples >= 0 && newDelayInSamples <= static_cast<SampleType> (maximumDelay));
+
+    delay = jlimit (static_cast<SampleType> (0), static_cast<SampleType> (maximumDelay), newDelayInSamples);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::setInterpolation (Interpolation newInterpolation) noexcept
+{
+    if (interpolation != newInterpolation)
+    {
+        interpolation = newInterpolation;
+        states.clear();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void DelayLine<SampleType>::prepare (const ProcessSpec& spec)
+{
+    numChannels = spec.numChannels;
+    maximumBlockSize = spec.maximumBlockSize;
+
+    allocateBuffers();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::allocateBuffers()
+{
+    // the oldest sample read by a block is the maximum delay plus the block size
+    // plus the samples used by the interpolation
+    bufferSize = static_cast<size_t> (nextPowerOfTwo (maximumDelay + static_cast<int> (maximumBlockSize) + 4));
+
+    buffer = AudioBlock<SampleType> (bufferData, numChannels, 2 * bufferSize);
+    writePositions.calloc (numChannels);
+
+   #if JUCE_USE_SIMD
+    auto numLanes = SIMDRegister<SampleType>::size();
+   #else
+    size_t numLanes = 1;
+   #endif
+
+    numSIMDChannels = util::getNumSIMDChannels (numChannels, numLanes);
+
+    // the Thiran states are padded to a whole number of groups, so that the states
+    // of every group are aligned
+    states = AudioBlock<SampleType> (statesData, 1, (numChannels + numLanes - 1) / numLanes * numLanes);
+    interleaved = AudioBlock<SampleType> (interleavedData, numSIMDChannels > 0 ? 1 : 0, (maximumBlockSize + 1) * numLanes);
+
+    reset();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::reset() noexcept
+{
+    buffer.clear();
+    states.clear();
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        writePositions[channel] = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void DelayLine<SampleType>::pushSample (size_t channel, SampleType sample) noexcept
+{
+    jassert (channel < numChannels);
+
+    auto* data = buffer.getChannelPointer (channel);
+    auto position = writePositions[channel];
+
+    data[position] = sample;
+    data[position + bufferSize] = sample;
+
+    writePositions[channel] = (position + 1) & (bufferSize - 1);
+}
+
+template <typename SampleType>
+SampleType DelayLine<SampleType>::popSample (size_t channel, SampleType delayInSamples) noexcept
+{
+    jassert (channel < numChannels);
+
+    return readSample (channel, 0, delayInSamples < 0 ? delay : delayInSamples);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::pushBlock (const AudioBlock<SampleType>& block) noexcept
+{
+    auto numSamples = block.getNumSamples();
+    jassert (numSamples <= maximumBlockSize);
+
+    for (size_t channel = 0; channel < jmin (block.getNumChannels(), numChannels); ++channel)
+    {
+        auto* src = block.getChannelPointer (channel);
+        auto* data = buffer.getChannelPointer (channel);
+        auto position = writePositions[channel];
+
+        auto numBeforeWrap = jmin (numSamples, bufferSize - position);
+        auto numAfterWrap = numSamples - numBeforeWrap;
+
+        FloatVectorOperations::copy (data + position, src, static_cast<int> (numBeforeWrap));
+        FloatVectorOperations::copy (data + position + bufferSize, src, static_cast<int> (numBeforeWrap));
+        FloatVectorOperations::copy (data, src + numBeforeWrap, static_cast<int> (numAfterWrap));
+        FloatVectorOperations::copy (data + bufferSize, src + numBeforeWrap, static_cast<int> (numAfterWrap));
+
+        writePositions[channel] = (position + numSamples) & (bufferSize - 1);
+    }
+}
+
+template <typename SampleType>
+const SampleType* DelayLine<SampleType>::getReadPointer (size_t channel, int delayInSamples, size_t numSamples) const noexcept
+{
+    jassert (channel < numChannels);
+    jassert (isPositiveAndNotGreaterThan (delayInSamples, maximumDelay));
+    jassert (numSamples > 0 && numSamples <= maximumBlockSize);
+
+    return getSamples (channel, static_cast<size_t> (delayInSamples) + numSamples - 1);
+}
+
+template <typename SampleType>
+const SampleType* DelayLine<SampleType>::getSamples (size_t channel, size_t delayOfFirstSample) const noexcept
+{
+    auto position = (writePositions[channel] + bufferSize - 1 - delayOfFirstSample) & (bufferSize - 1);
+    return buffer.getChannelPointer (channel) + position;
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType DelayLine<SampleType>::readSample (size_t channel, size_t age, SampleType delayInSamples) noexcept
+{
+    delayInSamples = jlimit (static_cast<SampleType> (0), static_cast<SampleType> (maximumDelay), delayInSamples);
+
+    switch (interpolation)
+    {
+        case Interpolation::none:
+        {
+            return getSamples (channel, age + static_cast<size_t> (delayInSamples))[0];
+        }
+
+        case Interpolation::linear:
+        {
+            auto whole = static_cast<size_t> (delayInSamples);
+            auto fraction = delayInSamples - static_cast<SampleType> (whole);
+            auto* src = getSamples (channel, age + whole + 1);
+
+            return src[1] + fraction * (src[0] - src[1]);
+        }
+
+        case Interpolation::lagrange3rd:
+        {
+            SampleType c[4];
+            auto whole = DelayLineHelpers::getLagrangeCoefficients (delayInSamples, c);
+            auto* src = getSamples (channel, age + whole + 3);
+
+            return c[0] * src[3] + c[1] * src[2] + c[2] * src[1] + c[3] * src[0];
+        }
+
+        case Interpolation::thiran:
+        {
+            SampleType fraction;
+            auto whole = DelayLineHelpers::splitThiranDelay (delayInSamples, fraction);
+            auto alpha = DelayLineHelpers::getThiranCoefficient (fraction);
+            auto* src = getSamples (channel, age + whole + 1);
+
+            auto& state = states.getChannelPointer (0)[channel];
+            state = alpha * (src[1] - state) + src[0];
+            return state;
+        }
+
+        default:
+            jassertfalse;
+            return 0;
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readBlock (AudioBlock<SampleType>& output) noexcept
+{
+    jassert (output.getNumChannels() <= numChannels);
+
+    auto numChannelsToProcess = jmin (output.getNumChannels(), numChannels);
+    auto numSamples = output.getNumSamples();
+
+    if (interpolation == Interpolation::thiran)
+    {
+        readThiranBlock (output, numSamples);
+        return;
+    }
+
+    // with a fixed delay, the interpolation is a short FIR filter applied to the
+    // contiguous samples of every channel
+    for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+    {
+        auto* dst = output.getChannelPointer (channel);
+
+        switch (interpolation)
+        {
+            case Interpolation::none:
+            {
+                auto* src = getSamples (channel, static_cast<size_t> (delay) + numSamples - 1);
+                FloatVectorOperations::copy (dst, src, static_cast<int> (numSamples));
+                break;
+            }
+
+            case Interpolation::linear:
+            {
+                auto whole = static_cast<size_t> (delay);
+                auto fraction = delay - static_cast<SampleType> (whole);
+                auto* src = getSamples (channel, whole + numSamples);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i] = src[i + 1] + fraction * (src[i] - src[i + 1]);
+
+                break;
+            }
+
+            case Interpolation::lagrange3rd:
+            {
+                SampleType c[4];
+                auto whole = DelayLineHelpers::getLagrangeCoefficients (delay, c);
+                auto* src = getSamples (channel, whole + numSamples + 2);
+                auto c0 = c[0], c1 = c[1], c2 = c[2], c3 = c[3];
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i] = c0 * src[i + 3] + c1 * src[i + 2] + c2 * src[i + 1] + c3 * src[i];
+
+                break;
+            }
+
+            case Interpolation::thiran:
+            default:
+                jassertfalse;
+                break;
+        }
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readModulatedBlock (AudioBlock<SampleType>& output, const AudioBlock<SampleType>& delays) noexcept
+{
+    jassert (output.getNumChannels() <= numChannels);
+    jassert (delays.getNumChannels() == 1 || delays.getNumChannels() >= output.getNumChannels());
+    jassert (delays.getNumSamples() >= output.getNumSamples());
+
+    auto numChannelsToProcess = jmin (output.getNumChannels(), numChannels);
+    auto numSamples = output.getNumSamples();
+
+    for (size_t channel = 0; channel < numChannelsToProcess; ++channel)
+    {
+        auto* dst = output.getChannelPointer (channel);
+        auto* delayValues = delays.getChannelPointer (delays.getNumChannels() == 1 ? 0 : channel);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            dst[i] = readSample (channel, numSamples - 1 - i, delayValues[i]);
+    }
+}
+
+template <typename SampleType>
+template <typename Type>
+void DelayLine<SampleType>::processThiran (const Type* src, Type* dst, Type& state, SampleType alpha, size_t numSamples) noexcept
+{
+    auto y = state;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        y = (src[i + 1] - y) * alpha + src[i];
+        dst[i] = y;
+    }
+
+    util::snapToZero (y);
+    state = y;
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readThiranBlock (AudioBlock<SampleType>& output, size_t numSamples) noexcept
+{
+    auto numChannelsToProcess = jmin (output.getNumChannels(), numChannels);
+
+    SampleType fraction;
+    auto whole = DelayLineHelpers::splitThiranDelay (delay, fraction);
+    auto alpha = DelayLineHelpers::getThiranCoefficient (fraction);
+
+    // every output sample uses the sample with the whole delay and the one before it
+    auto delayOfFirstSample = whole + numSamples;
+    auto* state = states.getChannelPointer (0);
+    size_t channel = 0;
+
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+    auto numLanes = Vec::size();
+
+    // The channels processed in lock-step are interleaved, so that every sample
+    // of the SIMD buffer holds one sample of each channel of the group
+    for (; channel < jmin (numSIMDChannels, numChannelsToProcess); channel += numLanes)
+    {
+        auto* data = interleaved.getChannelPointer (0);
+        auto numLanesUsed = jmin (numLanes, numChannelsToProcess - channel);
+
+        if (numLanesUsed < numLanes)
+            FloatVectorOperations::clear (data, static_cast<int> ((numSamples + 1) * numLanes));
+
+        for (size_t lane = 0; lane < numLanesUsed; ++lane)
+        {
+            auto* src = getSamples (channel + lane, delayOfFirstSample);
+
+            for (size_t i = 0; i <= numSamples; ++i)
+                data[i * numLanes + lane] = src[i];
+        }
+
+        auto* vecData = reinterpret_cast<Vec*> (data);
+        jassert (Vec::isSIMDAligned (data) && Vec::isSIMDAligned (state + channel));
+        processThiran (vecData, vecData, *reinterpret_cast<Vec*> (state + channel), alpha, numSamples);
+
+        for (size_t lane = 0; lane < numLanesUsed; ++lane)
+        {
+            auto* dst = output.getChannelPointer (channel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = data[i * numLanes + lane];
+        }
+    }
+   #endif
+
+    for (; channel < numChannelsToProcess; ++channel)
+        processThiran (getSamples (channel, delayOfFirstSample), output.getChannelPointer (channel),
+                       state[channel], alpha, numSamples);
+}
+
+template class DelayLine<float>;
+template class DelayLine<double>;
+
+} // namespace dsp
+} // namespace juce
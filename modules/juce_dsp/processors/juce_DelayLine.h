@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A multi-channel delay line with fractional delays, for chorus, flanger, phaser
+    and other modulated effects.
+
+    The delay line has no latency: the samples of a block are pushed into it before
+    its delayed samples are read, so delays shorter than the block size, including
+    zero, can be used. Fractional delays are interpolated with one of the methods
+    of the Interpolation enum.
+
+    Every channel is stored twice in a row in a power-of-two buffer, so that any
+    read of up to the buffer size is contiguous in memory. With a fixed delay, the
+    interpolation is evaluated with vector operations over whole blocks, and the
+    Thiran allpass interpolation, which is recursive, processes the channels in
+    groups of SIMDRegister::size() in lock-step, each channel of a group using one
+    lane of the SIMD registers.
+
+    @code
+    DelayLine<float> delay (2048);
+    delay.prepare ({ sampleRate, (uint32) blockSize, 2 });
+    delay.setDelay (441.5f);
+    @endcode
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  DelayLine
+{
+public:
+    //==============================================================================
+    /** The methods which can be used to interpolate fractional delays. */
+    enum class Interpolation
+    {
+        none,           /**< The delays are rounded down to a whole number of samples. */
+        linear,         /**< Linear interpolation, which attenuates the high frequencies. */
+        lagrange3rd,    /**< Third order Lagrange interpolation, using four samples. */
+        thiran          /**< First order allpass interpolation, which has a flat magnitude
+                             response but should only be used with slowly changing delays. */
+    };
+
+    //==============================================================================
+    /** Creates a delay line with a maximum delay of 44100 samples. */
+    DelayLine();
+
+    /** Creates a delay line with a maximum delay in samples. */
+    explicit DelayLine (int maximumDelayInSamples);
+
+    /** Destructor. */
+    ~DelayLine();
+
+    //==============================================================================
+    /** Sets the maximum delay in samples. If the delay line has already been
+        prepared, this allocates memory and resets it.
+    */
+    void setMaximumDelayInSamples (int maxDelayInSamples);
+
+    /** Returns the maximum delay in samples. */
+    int getMaximumDelayInSamples() const noexcept                       { return maximumDelay; }
+
+    /** Sets the delay in samples used by process() and popSample(), which is
+        limited to the maximum delay.
+    */
+    void setDelay (SampleType newDelayInSamples) noexcept;
+
+    /** Returns the delay in samples. */
+    SampleType getDelay() const noexcept                                { return delay; }
+
+    /** Sets the interpolation method used for fractional delays. */
+    void setInterpolation (Interpolation newInterpolation) noexcept;
+
+    /** Returns the interpolation method used for fractional delays. */
+    Interpolation getInterpolation() const noexcept                     { return interpolation; }
+
+    //==============================================================================
+    /** Initialises the delay line for the number of channels and the maximum
+        block size of the specification.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Clears the delay line. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Pushes a sample into one of the channels of the delay line. */
+    void pushSample (size_t channel, SampleType sample) noexcept;
+
+    /** Returns the sample of one of the channels delayed by a number of samples,
+        relative to the last sample which has been pushed into it, so that a delay of
+        zero returns that last sample. If the delay is negative, the one given to
+        setDelay() is used.
+
+        When the Thiran interpolation is used, this updates the state of the channel's
+        allpass filter, so it should be called once per pushed sample.
+    */
+    SampleType popSample (size_t channel, SampleType delayInSamples = -1) noexcept;
+
+    /** Pushes the samples of a block into the delay line, without reading it. */
+    void pushBlock (const AudioBlock<SampleType>& block) noexcept;
+
+    /** Returns a pointer to the last numSamples samples pushed into one of the
+        channels, delayed by a whole number of samples. The samples are always
+        contiguous, and stay valid until more samples are pushed into the channel.
+        The delay and the number of samples must not exceed the maximum delay and
+        the maximum block size given to prepare().
+    */
+    const SampleType* getReadPointer (size_t channel, int delayInSamples, size_t numSamples) const noexcept;
+
+    //==============================================================================
+    /** Delays the samples of the context by the delay given to setDelay(). */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processContext (context, nullptr);
+    }
+
+    /** Delays the samples of the context by the number of samples given for every
+        sample by the corresponding channel of the delay block. If it has a single
+        channel, the same delays are used for all the channels of the context.
+        This can be used for modulated delays.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<SampleType>& delaysInSamples) noexcept
+    {
+        processContext (context, &delaysInSamples);
+    }
+
+private:
+    //==============================================================================
+    template <typename ProcessContext>
+    void processContext (const ProcessContext& context, const AudioBlock<SampleType>* delaysInSamples) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample-type of the delay line must match the sample-type supplied to this process callback");
+
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        pushBlock (inputBlock);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copy (inputBlock);
+
+            return;
+        }
+
+        if (delaysInSamples != nullptr)
+            readModulatedBlock (outputBlock, *delaysInSamples);
+        else
+            readBlock (outputBlock);
+    }
+
+    void readBlock (AudioBlock<SampleType>& output) noexcept;
+    void readModulatedBlock (AudioBlock<SampleType>& output, const AudioBlock<SampleType>& delays) noexcept;
+    void readThiranBlock (AudioBlock<SampleType>& output, size_t numSamples) noexcept;
+    void allocateBuffers();
+
+    // returns the samples of a channel starting from the one which has been pushed
+    // the given number of samples before the last one
+    const SampleType* getSamples (size_t channel, size_t delayOfFirstSample) const noexcept;
+    SampleType readSample (size_t channel, size_t age, SampleType delayInSamples) noexcept;
+
+    template <typename Type>
+    static void processThiran (const Type* src, Type* dst, Type& state, SampleType alpha, size_t numSamples) noexcept;
+
+    //==============================================================================
+    Interpolation interpolation = Interpolation::linear;
+    SampleType delay = 0;
+    int maximumDelay = 44100;
+
+    // every channel is stored twice in a row in the buffer, so that the bufferSize
+    // samples starting at any position lower than bufferSize are contiguous
+    size_t numChannels = 0, numSIMDChannels = 0, maximumBlockSize = 0, bufferSize = 0;
+    HeapBlock<size_t> writePositions;
+    HeapBlock<char> bufferData, statesData, interleavedData;
+    AudioBlock<SampleType> buffer, states, interleaved;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayLine)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class DelayLineTest : public UnitTest
+{
+    using Interpolation = DelayLine<float>::Interpolation;
+
+    // A straightforward implementation of every interpolation, in double precision,
+    // which reads the input signal directly
+    struct Reference
+    {
+        Reference (const AudioBuffer<float>& source, int channelToRead)
+            : input (source), channel (channelToRead)
+        {}
+
+        double getInput (int n) const
+        {
+            return n >= 0 ? (double) input.getSample (channel, n) : 0.0;
+        }
+
+        double getSample (int n, double delay, Interpolation interpolation)
+        {
+            auto whole = (int) delay;
+            auto fraction = delay - whole;
+
+            switch (interpolation)
+            {
+                case Interpolation::none:
+                    return getInput (n - whole);
+
+                case Interpolation::linear:
+                    return (1.0 - fraction) * getInput (n - whole) + fraction * getInput (n - whole - 1);
+
+                case Interpolation::lagrange3rd:
+                {
+                    // the polynomial going through the four samples around the delay
+                    auto first = jmax (0, whole - 1);
+                    double result = 0;
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        auto weight = 1.0;
+
+                        for (int j = 0; j < 4; ++j)
+                            if (j != k)
+                                weight *= (delay - (first + j)) / (double) (k - j);
+
+                        result += weight * getInput (n - first - k);
+                    }
+
+                    return result;
+                }
+
+                case Interpolation::thiran:
+                {
+                    // a first order allpass filter, with a fractional part between 0.618 and 1.618
+                    if (fraction < 0.618 && whole > 0)
+                    {
+                        --whole;
+                        fraction += 1.0;
+                    }
+
+                    auto alpha = (1.0 - fraction) / (1.0 + fraction);
+                    thiranState = alpha * getInput (n - whole) + getInput (n - whole - 1) - alpha * thiranState;
+                    return thiranState;
+                }
+
+                default:
+                    return 0.0;
+            }
+        }
+
+        const AudioBuffer<float>& input;
+        const int channel;
+        double thiranState = 0;
+    };
+
+    static void fillRandom (AudioBuffer<float>& buffer, Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    // processes the input in blocks of random sizes, with the delays of the block if any
+    static AudioBuffer<float> process (DelayLine<float>& delayLine, const AudioBuffer<float>& input,
+                                       int maximumBlockSize, Random& random,
+                                       const AudioBuffer<float>* delays = nullptr)
+    {
+        AudioBuffer<float> output (input);
+        AudioBlock<float> block (output);
+
+        for (int start = 0; start < output.getNumSamples();)
+        {
+            auto numSamples = jmin (1 + random.nextInt (maximumBlockSize), output.getNumSamples() - start);
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) numSamples);
+
+            if (delays != nullptr)
+                delayLine.process (ProcessContextReplacing<float> (subBlock),
+                                   AudioBlock<float> (const_cast<AudioBuffer<float>&> (*delays)).getSubBlock ((size_t) start, (size_t) numSamples));
+            else
+                delayLine.process (ProcessContextReplacing<float> (subBlock));
+
+            start += numSamples;
+        }
+
+        return output;
+    }
+
+    static String getName (Interpolation interpolation)
+    {
+        switch (interpolation)
+        {
+            case Interpolation::none:           return "no interpolation";
+            case Interpolation::linear:         return "linear interpolation";
+            case Interpolation::lagrange3rd:    return "Lagrange interpolation";
+            case Interpolation::thiran:         return "Thiran interpolation";
+            default:                            return {};
+        }
+    }
+
+public:
+    DelayLineTest() : UnitTest ("Delay Line", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        constexpr int numChannels = 11;
+        constexpr int numSamples = 4096;
+        constexpr int maximumBlockSize = 256;
+        constexpr int maximumDelay = 2000;
+
+        AudioBuffer<float> input (numChannels, numSamples);
+        fillRandom (input, random);
+
+        const Interpolation interpolations[] = { Interpolation::none, Interpolation::linear,
+                                                 Interpolation::lagrange3rd, Interpolation::thiran };
+
+        for (auto interpolation : interpolations)
+        {
+            beginTest ("Integer delays, " + getName (interpolation));
+            {
+                for (auto delay : { 0, 1, 5, 300, maximumDelay })
+                {
+                    DelayLine<float> delayLine (maximumDelay);
+                    delayLine.setInterpolation (interpolation);
+                    delayLine.setDelay ((float) delay);
+                    delayLine.prepare ({ 44100.0, (uint32) maximumBlockSize, (uint32) numChannels });
+
+                    auto output = process (delayLine, input, maximumBlockSize, random);
+                    float maxError = 0;
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        for (int i = 0; i < numSamples; ++i)
+                            maxError = jmax (maxError, std::abs (output.getSample (channel, i)
+                                                                   - (i >= delay ? input.getSample (channel, i - delay) : 0.0f)));
+
+                    // a zero delay makes the Thiran filter accumulate rounding errors
+                    expectLessThan (maxError, 1.0e-5f);
+                }
+            }
+
+            beginTest ("Fractional delays, " + getName (interpolation));
+            {
+                for (auto delay : { 0.25f, 1.5f, 2.618f, 37.1f, 1999.9f })
+                {
+                    DelayLine<float> delayLine (maximumDelay);
+                    delayLine.setInterpolation (interpolation);
+                    delayLine.setDelay (delay);
+                    delayLine.prepare ({ 44100.0, (uint32) maximumBlockSize, (uint32) numChannels });
+
+                    auto output = process (delayLine, input, maximumBlockSize, random);
+                    double maxError = 0;
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        Reference reference (input, channel);
+
+                        for (int i = 0; i < numSamples; ++i)
+                            maxError = jmax (maxError, std::abs (output.getSample (channel, i)
+                                                                   - reference.getSample (i, (double) delay, interpolation)));
+                    }
+
+                    expectLessThan (maxError, 1.0e-5);
+                }
+            }
+
+            beginTest ("Sample by sample processing, " + getName (interpolation));
+            {
+                DelayLine<float> delayLine (maximumDelay);
+                delayLine.setInterpolation (interpolation);
+                delayLine.setDelay (123.45f);
+                delayLine.prepare ({ 44100.0, (uint32) maximumBlockSize, 2 });
+
+                double maxError = 0;
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    Reference reference (input, channel);
+
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        delayLine.pushSample ((size_t) channel, input.getSample (channel, i));
+                        maxError = jmax (maxError, std::abs (delayLine.popSample ((size_t) channel)
+                                                               - reference.getSample (i, 123.45, interpolation)));
+                    }
+                }
+
+                expectLessThan (maxError, 1.0e-5);
+            }
+        }
+
+        // the delays change slowly enough for the Thiran interpolation, whose
+        // coefficient the reference updates for every sample like the delay line
+        for (auto interpolation : interpolations)
+        {
+            beginTest ("Modulated delays, " + getName (interpolation));
+            {
+                DelayLine<float> delayLine (maximumDelay);
+                delayLine.setInterpolation (interpolation);
+                delayLine.prepare ({ 44100.0, (uint32) maximumBlockSize, (uint32) numChannels });
+
+                // a different sine modulation for every channel
+                AudioBuffer<float> delays (numChannels, numSamples);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    for (int i = 0; i < numSamples; ++i)
+                        delays.setSample (channel, i, 50.0f + (float) channel
+                                                        + 40.0f * std::sin (0.001f * (float) ((channel + 1) * i)));
+
+                auto output = process (delayLine, input, maximumBlockSize, random, &delays);
+                double maxError = 0;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    Reference reference (input, channel);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        maxError = jmax (maxError, std::abs (output.getSample (channel, i)
+                                                               - reference.getSample (i, (double) delays.getSample (channel, i), interpolation)));
+                }
+
+                expectLessThan (maxError, 1.0e-5);
+            }
+        }
+
+        beginTest ("Delaying a low frequency sine");
+        {
+            // all the interpolations give the expected phase delay at low frequencies
+            AudioBuffer<float> sine (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                sine.setSample (0, i, std::sin (0.05f * (float) i));
+
+            for (auto interpolation : interpolations)
+            {
+                if (interpolation == Interpolation::none)
+                    continue;
+
+                DelayLine<float> delayLine (maximumDelay);
+                delayLine.setInterpolation (interpolation);
+                delayLine.setDelay (100.3f);
+                delayLine.prepare ({ 44100.0, (uint32) maximumBlockSize, 1 });
+
+                auto output = process (delayLine, sine, maximumBlockSize, random);
+                double maxError = 0;
+
+                // once the allpass filter of the Thiran interpolation has settled
+                for (int i = 200; i < numSamples; ++i)
+                    maxError = jmax (maxError, std::abs (output.getSample (0, i) - std::sin (0.05 * (i - 100.3))));
+
+                expectLessThan (maxError, 1.0e-3);
+            }
+        }
+    }
+};
+
+static DelayLineTest delayLineUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,427 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+namespace FDNReverbHelpers
+{
+    static bool isPrime (int n) noexcept
+    {
+        if (n < 2)
+            return false;
+
+        for (int i = 2; i * i <= n; ++i)
+            if (n % i == 0)
+                return false;
+
+        return true;
+    }
+
+    // a[i], b[i] = a[i] + b[i], a[i] - b[i]
+    template <typename SampleType>
+    static void butterfly (SampleType* a, SampleType* b, size_t numSamples) noexcept
+    {
+        size_t i = 0;
+
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<SampleType>;
+
+        if (Vec::isSIMDAligned (a) && Vec::isSIMDAligned (b))
+        {
+            for (; i + Vec::size() <= numSamples; i += Vec::size())
+            {
+                auto x = Vec::fromRawArray (a + i);
+                auto y = Vec::fromRawArray (b + i);
+
+                (x + y).copyToRawArray (a + i);
+                (x - y).copyToRawArray (b + i);
+            }
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+        {
+            auto x = a[i], y = b[i];
+            a[i] = x + y;
+            b[i] = x - y;
+        }
+    }
+
+    // Reads a chunk of a delay line with linear interpolation, and damps the
+    // result with a one-pole lowpass filter, returning the state of the filter
+    template <typename SampleType, typename ReadFunction>
+    static SampleType readLine (ReadFunction read, SampleType* line, size_t numSamples,
+                                SampleType position, SampleType increment,
+                                SampleType damping, SampleType state) noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto index = (int) position;
+            auto x0 = read (index);
+            auto x1 = read (index + 1);
+            auto x = x0 + (position - static_cast<SampleType> (index)) * (x1 - x0);
+
+            state = x + damping * (state - x);
+            line[i] = state;
+            position += increment;
+        }
+
+        return state;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+FDNReverb<SampleType>::FDNReverb()
+{
+    setParameters (parameters);
+}
+
+template <typename SampleType>
+FDNReverb<SampleType>::~FDNReverb()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::setParameters (const Parameters& newParams)
+{
+    // gives about the same output levels as juce::Reverb
+    const SampleType wetScaleFactor = static_cast<SampleType> (1.2);
+    const SampleType dryScaleFactor = 2;
+
+    auto wet = static_cast<SampleType> (newParams.wetLevel) * wetScaleFactor;
+    auto width = static_cast<SampleType> (newParams.width);
+
+    dryGain.setValue (static_cast<SampleType> (newParams.dryLevel) * dryScaleFactor);
+    wetGain1.setValue (static_cast<SampleType> (0.5) * wet * (1 + width));
+    wetGain2.setValue (static_cast<SampleType> (0.5) * wet * (1 - width));
+
+    parameters = newParams;
+    updateGains();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::setModulation (SampleType depthInSeconds, SampleType rateInHz) noexcept
+{
+    jassert (depthInSeconds >= 0 && rateInHz >= 0);
+
+    modulationDepth = jlimit (static_cast<SampleType> (0), static_cast<SampleType> (0.005), depthInSeconds);
+    modulationRate = rateInHz;
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::updateGains() noexcept
+{
+    auto frozen = parameters.freezeMode >= 0.5f;
+
+    // the room size sets the reverberation time, between 0.2 and 10 seconds
+    auto reverbTime = 0.2 * std::pow (50.0, (double) jlimit (0.0f, 1.0f, parameters.roomSize));
+
+    // the scaling of the Hadamard matrix is applied with the gains of the lines
+    auto matrixGain = matrix == MixingMatrix::hadamard ? 0.25 : 1.0;
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        auto decay = frozen ? 1.0 : std::pow (10.0, -3.0 * delayLengths[i] / (reverbTime * sampleRate));
+        targetLineGains[i] = static_cast<SampleType> (decay * matrixGain);
+    }
+
+    damping = frozen ? 0 : static_cast<SampleType> (0.7f * jlimit (0.0f, 1.0f, parameters.damping));
+    inputGain = frozen ? 0 : static_cast<SampleType> (0.5);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels == 1 || spec.numChannels == 2);
+
+    sampleRate = spec.sampleRate;
+
+    // The lengths of the delay lines are spread between 20 and 100 ms, and rounded
+    // to prime numbers of samples so that their echoes never coincide
+    auto maximumDepth = (int) std::ceil (0.005 * sampleRate);
+    int maximumDelay = 0;
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        auto length = (int) (0.02 * sampleRate * std::pow (5.0, i / (double) (numLines - 1)));
+
+        while (! FDNReverbHelpers::isPrime (length))
+            ++length;
+
+        delayLengths[i] = length;
+        maximumDelay = jmax (maximumDelay, length + maximumDepth + 2);
+    }
+
+    // the delay lines are read before being written to for a whole chunk,
+    // so a chunk can't be longer than the shortest delay
+    maximumChunkSize = jmin ((size_t) spec.maximumBlockSize, (size_t) 256, (size_t) delayLengths[0] - 2);
+
+    auto bufferSize = (size_t) nextPowerOfTwo (maximumDelay + (int) maximumChunkSize);
+    bufferMask = bufferSize - 1;
+
+    delayLines = AudioBlock<SampleType> (delayData, numLines, bufferSize);
+    scratch = AudioBlock<SampleType> (scratchData, numScratchRows, maximumChunkSize);
+
+    const double smoothTime = 0.01;
+    dryGain .reset (sampleRate, smoothTime);
+    wetGain1.reset (sampleRate, smoothTime);
+    wetGain2.reset (sampleRate, smoothTime);
+
+    updateGains();
+    reset();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::reset() noexcept
+{
+    delayLines.clear();
+    writePosition = 0;
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        lineGains[i] = targetLineGains[i];
+        dampingStates[i] = 0;
+        modulationPhases[i] = MathConstants<SampleType>::twoPi * static_cast<SampleType> (i) / numLines;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::processSamples (AudioBlock<SampleType>& block) noexcept
+{
+    auto numChannels = block.getNumChannels();
+    auto numSamples = block.getNumSamples();
+
+    jassert (numChannels == 1 || numChannels == 2);
+    jassert (maximumChunkSize > 0);
+
+    if (numChannels != 1 && numChannels != 2)
+        return;
+
+    auto* left = block.getChannelPointer (0);
+    auto* right = numChannels > 1 ? block.getChannelPointer (1) : nullptr;
+
+    for (size_t start = 0; start < numSamples;)
+    {
+        auto num = jmin (maximumChunkSize, numSamples - start);
+
+        processChunk (left + start, right != nullptr ? right + start : nullptr, num);
+        start += num;
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::processChunk (SampleType* left, SampleType* right, size_t numSamples) noexcept
+{
+    auto num = static_cast<int> (numSamples);
+
+    readDelayLines (numSamples);
+
+    // the outputs of the even and odd lines, with alternating signs, make the
+    // left and right wet signals
+    auto* wetLeft = scratch.getChannelPointer (wetLeftRow);
+    auto* wetRight = scratch.getChannelPointer (wetRightRow);
+
+    FloatVectorOperations::clear (wetLeft, num);
+    FloatVectorOperations::clear (wetRight, num);
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        auto* line = scratch.getChannelPointer ((size_t) i);
+        auto sign = static_cast<SampleType> ((i & 2) != 0 ? -1 : 1);
+
+        FloatVectorOperations::addWithMultiply ((i & 1) != 0 ? wetRight : wetLeft, line, sign, num);
+
+        // the gains of the lines set the decay time, and are ramped over the chunk
+        auto gainIncrement = (targetLineGains[i] - lineGains[i]) / static_cast<SampleType> (numSamples);
+        FloatVectorOperations::multiplyWithRamp (line, lineGains[i], gainIncrement, num);
+        lineGains[i] = targetLineGains[i];
+    }
+
+    mixDelayLines (numSamples);
+
+    // the input is added to every line, the left channel to the even ones and the
+    // right channel to the odd ones
+    for (int i = 0; i < numLines; ++i)
+    {
+        auto* line = scratch.getChannelPointer ((size_t) i);
+        auto* input = (i & 1) != 0 && right != nullptr ? right : left;
+        auto sign = (i & 4) != 0 ? -inputGain : inputGain;
+
+        FloatVectorOperations::addWithMultiply (line, input, sign, num);
+    }
+
+    writeDelayLines (numSamples);
+
+    // mixes the wet signals with the dry ones
+    if (dryGain.isSmoothing() || wetGain1.isSmoothing() || wetGain2.isSmoothing())
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto dry  = dryGain.getNextValue();
+            auto wet1 = wetGain1.getNextValue();
+            auto wet2 = wetGain2.getNextValue();
+
+            left[i] = wetLeft[i] * wet1 + wetRight[i] * wet2 + left[i] * dry;
+
+            if (right != nullptr)
+                right[i] = wetRight[i] * wet1 + wetLeft[i] * wet2 + right[i] * dry;
+        }
+    }
+    else
+    {
+        auto dry  = dryGain.getTargetValue();
+        auto wet1 = wetGain1.getTargetValue();
+        auto wet2 = wetGain2.getTargetValue();
+
+        FloatVectorOperations::multiply (left, dry, num);
+        FloatVectorOperations::addWithMultiply (left, wetLeft, wet1, num);
+        FloatVectorOperations::addWithMultiply (left, wetRight, wet2, num);
+
+        if (right != nullptr)
+        {
+            FloatVectorOperations::multiply (right, dry, num);
+            FloatVectorOperations::addWithMultiply (right, wetRight, wet1, num);
+            FloatVectorOperations::addWithMultiply (right, wetLeft, wet2, num);
+        }
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::readDelayLines (size_t numSamples) noexcept
+{
+    // the modulation would make the frozen sound fade out, because of the interpolation
+    auto frozen = parameters.freezeMode >= 0.5f;
+    auto depth = frozen ? 0 : modulationDepth * static_cast<SampleType> (sampleRate) * static_cast<SampleType> (0.5);
+    auto phaseIncrement = MathConstants<SampleType>::twoPi * modulationRate * static_cast<SampleType> (numSamples / sampleRate);
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        // The delay of each line is modulated by its own sine wave, whose rate is
+        // slightly different for each line. The modulation is updated once per
+        // chunk, and interpolated linearly within it
+        auto& phase = modulationPhases[i];
+        auto startDelay = static_cast<SampleType> (delayLengths[i]) + depth * (1 + std::sin (phase));
+
+        phase += phaseIncrement * (1 + static_cast<SampleType> (i) / numLines);
+
+        if (phase >= MathConstants<SampleType>::twoPi)
+            phase -= MathConstants<SampleType>::twoPi;
+
+        auto endDelay = static_cast<SampleType> (delayLengths[i]) + depth * (1 + std::sin (phase));
+
+        // The samples are read relative to the integer part of the start delay,
+        // directly when they don't wrap around the end of the buffer
+        auto integerDelay = (size_t) startDelay;
+        auto firstIndex = (writePosition + bufferMask - integerDelay) & bufferMask;
+        auto position = 1 - (startDelay - static_cast<SampleType> (integerDelay));
+        auto increment = 1 - (endDelay - startDelay) / static_cast<SampleType> (numSamples);
+        auto lastIndex = (size_t) (position + increment * static_cast<SampleType> (numSamples - 1)) + 1;
+
+        auto* buffer = delayLines.getChannelPointer ((size_t) i);
+        auto* line = scratch.getChannelPointer ((size_t) i);
+        auto& state = dampingStates[i];
+
+        if (firstIndex + lastIndex <= bufferMask)
+        {
+            auto* samples = buffer + firstIndex;
+
+            state = FDNReverbHelpers::readLine ([samples] (int index) { return samples[index]; },
+                                                line, numSamples, position, increment, damping, state);
+        }
+        else
+        {
+            auto mask = bufferMask;
+
+            state = FDNReverbHelpers::readLine ([buffer, firstIndex, mask] (int index) { return buffer[(firstIndex + (size_t) index) & mask]; },
+                                                line, numSamples, position, increment, damping, state);
+        }
+
+        util::snapToZero (state);
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::mixDelayLines (size_t numSamples) noexcept
+{
+    auto num = static_cast<int> (numSamples);
+
+    if (matrix == MixingMatrix::hadamard)
+    {
+        // a fast Walsh-Hadamard transform
+        for (size_t half = 1; half < (size_t) numLines; half *= 2)
+            for (size_t i = 0; i < (size_t) numLines; i += 2 * half)
+                for (size_t j = i; j < i + half; ++j)
+                    FDNReverbHelpers::butterfly (scratch.getChannelPointer (j),
+                                                 scratch.getChannelPointer (j + half),
+                                                 numSamples);
+    }
+    else
+    {
+        // every line minus 2 / N times the sum of the lines
+        auto* sum = scratch.getChannelPointer (tempRow);
+        FloatVectorOperations::copy (sum, scratch.getChannelPointer (0), num);
+
+        for (size_t i = 1; i < (size_t) numLines; ++i)
+            FloatVectorOperations::add (sum, scratch.getChannelPointer (i), num);
+
+        for (size_t i = 0; i < (size_t) numLines; ++i)
+            FloatVectorOperations::addWithMultiply (scratch.getChannelPointer (i), sum,
+                                                    static_cast<SampleType> (-2.0 / numLines), num);
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::writeDelayLines (size_t numSamples) noexcept
+{
+    auto numBeforeWrap = static_cast<int> (jmin (numSamples, bufferMask + 1 - writePosition));
+    auto numAfterWrap = static_cast<int> (numSamples) - numBeforeWrap;
+
+    for (size_t i = 0; i < (size_t) numLines; ++i)
+    {
+        auto* buffer = delayLines.getChannelPointer (i);
+        auto* line = scratch.getChannelPointer (i);
+
+        FloatVectorOperations::copy (buffer + writePosition, line, numBeforeWrap);
+
+        if (numAfterWrap > 0)
+            FloatVectorOperations::copy (buffer, line + numBeforeWrap, numAfterWrap);
+    }
+
+    writePosition = (writePosition + numSamples) & bufferMask;
+}
+
+template class FDNReverb<float>;
+template class FDNReverb<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A feedback delay network reverb, processing mono or stereo blocks.
+
+    The reverb is made of 16 delay lines with slowly modulated lengths, whose
+    outputs are damped, mixed together with a Hadamard or Householder matrix and
+    fed back into them. The delay lines are processed in chunks shorter than the
+    shortest delay, so that the mixing matrix is evaluated with vector operations
+    over whole chunks of samples rather than sample by sample.
+
+    It uses the same parameters as the Reverb class, so it can be used in its place.
+
+    @see Reverb
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  FDNReverb
+{
+public:
+    //==============================================================================
+    /** The parameters of the reverb, which are the ones of juce::Reverb. */
+    using Parameters = juce::Reverb::Parameters;
+
+    /** The matrices which can be used to mix the outputs of the delay lines. */
+    enum class MixingMatrix
+    {
+        hadamard,       /**< Spreads each delay line into all the others, for the densest echoes. */
+        householder     /**< Mostly feeds each delay line back into itself, for a slower build-up. */
+    };
+
+    //==============================================================================
+    /** Creates an uninitialised reverb. Call prepare() before first use. */
+    FDNReverb();
+
+    /** Destructor. */
+    ~FDNReverb();
+
+    //==============================================================================
+    /** Returns the reverb's current parameters. */
+    const Parameters& getParameters() const noexcept            { return parameters; }
+
+    /** Applies a new set of parameters to the reverb.
+        Note that this doesn't attempt to lock the reverb, so if you call this in parallel with
+        the process method, you may get artifacts.
+    */
+    void setParameters (const Parameters& newParams);
+
+    /** Sets the matrix used to mix the outputs of the delay lines. */
+    void setMixingMatrix (MixingMatrix newMatrix) noexcept      { matrix = newMatrix; updateGains(); }
+
+    /** Returns the matrix used to mix the outputs of the delay lines. */
+    MixingMatrix getMixingMatrix() const noexcept               { return matrix; }
+
+    /** Sets how much the lengths of the delay lines are modulated, which smears the
+        resonances of the network. The depth is limited to 5 ms.
+    */
+    void setModulation (SampleType depthInSeconds, SampleType rateInHz) noexcept;
+
+    /** Returns true if the reverb is enabled. */
+    bool isEnabled() const noexcept                             { return enabled; }
+
+    /** Enables/disables the reverb. */
+    void setEnabled (bool newValue) noexcept                    { enabled = newValue; }
+
+    //==============================================================================
+    /** Initialises the reverb. */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the reverb's internal state. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Applies the reverb to a mono or stereo block. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample-type of the reverb must match the sample-type supplied to this process callback");
+
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            outputBlock.copy (inputBlock);
+
+        if (! enabled || context.isBypassed)
+            return;
+
+        processSamples (outputBlock);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (AudioBlock<SampleType>&) noexcept;
+    void processChunk (SampleType* left, SampleType* right, size_t numSamples) noexcept;
+    void readDelayLines (size_t numSamples) noexcept;
+    void mixDelayLines (size_t numSamples) noexcept;
+    void writeDelayLines (size_t numSamples) noexcept;
+    void updateGains() noexcept;
+
+    //==============================================================================
+    enum { numLines = 16 };
+
+    // the outputs of the delay lines are computed in the first rows of the
+    // scratch block, followed by a temporary row and the wet signals
+    enum { tempRow = numLines, wetLeftRow, wetRightRow, numScratchRows };
+
+    Parameters parameters;
+    MixingMatrix matrix = MixingMatrix::hadamard;
+    bool enabled = true;
+
+    double sampleRate = 44100.0;
+    size_t maximumChunkSize = 0, bufferMask = 0, writePosition = 0;
+    SampleType modulationDepth = static_cast<SampleType> (0.0003), modulationRate = static_cast<SampleType> (0.7);
+
+    int delayLengths[numLines] = {};
+    SampleType lineGains[numLines] = {}, targetLineGains[numLines] = {}, dampingStates[numLines] = {};
+    SampleType modulationPhases[numLines] = {};
+    SampleType damping = 0, inputGain = 0;
+
+    HeapBlock<char> delayData, scratchData;
+    AudioBlock<SampleType> delayLines, scratch;
+    LinearSmoothedValue<SampleType> dryGain, wetGain1, wetGain2;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverb)
+};
+
+} // namespace dsp
+} // namespace juce
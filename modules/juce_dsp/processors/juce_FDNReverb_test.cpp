@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FDNReverbTest : public UnitTest
+{
+    // the reverberation time set by the room size
+    static double getReverbTime (float roomSize)
+    {
+        return 0.2 * std::pow (50.0, (double) roomSize);
+    }
+
+    // Returns the time taken by the energy decay curve of the impulse response, given
+    // by the backward integration of its energy, to go from -5 dB to -25 dB, scaled to
+    // a decay of 60 dB
+    static double measureReverbTime (const AudioBuffer<float>& impulseResponse, double sampleRate)
+    {
+        auto numSamples = impulseResponse.getNumSamples();
+        HeapBlock<double> decayCurve ((size_t) numSamples + 1);
+        decayCurve[numSamples] = 0;
+
+        for (int i = numSamples; --i >= 0;)
+        {
+            auto left = (double) impulseResponse.getSample (0, i);
+            auto right = (double) impulseResponse.getSample (1, i);
+            decayCurve[i] = decayCurve[i + 1] + left * left + right * right;
+        }
+
+        int start = -1, end = -1;
+
+        for (int i = 0; i < numSamples && end < 0; ++i)
+        {
+            // the curve is an energy, not an amplitude
+            auto level = 10.0 * std::log10 (decayCurve[i] / decayCurve[0]);
+
+            if (start < 0 && level <= -5.0)   start = i;
+            if (end < 0 && level <= -25.0)    end = i;
+        }
+
+        return end < 0 ? 0.0 : 3.0 * (end - start) / sampleRate;
+    }
+
+    static float getPeak (const AudioBuffer<float>& buffer)
+    {
+        float peak = 0;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto range = FloatVectorOperations::findMinAndMax (buffer.getReadPointer (channel), buffer.getNumSamples());
+            peak = jmax (peak, std::abs (range.getStart()), std::abs (range.getEnd()));
+        }
+
+        return peak;
+    }
+
+    static void process (FDNReverb<float>& reverb, AudioBuffer<float>& buffer, int blockSize)
+    {
+        AudioBlock<float> block (buffer);
+
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) jmin (blockSize, buffer.getNumSamples() - start));
+            reverb.process (ProcessContextReplacing<float> (subBlock));
+        }
+    }
+
+public:
+    FDNReverbTest() : UnitTest ("FDN Reverb", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int blockSize = 512;
+
+        beginTest ("Decay of the impulse response");
+        {
+            for (auto matrix : { FDNReverb<float>::MixingMatrix::hadamard, FDNReverb<float>::MixingMatrix::householder })
+            {
+                for (auto roomSize : { 0.2f, 0.4f })
+                {
+                    Reverb::Parameters parameters;
+                    parameters.roomSize = roomSize;
+                    parameters.damping = 0.0f;
+                    parameters.wetLevel = 1.0f;
+                    parameters.dryLevel = 0.0f;
+
+                    // without modulation, all the lines decay at the same rate
+                    FDNReverb<float> reverb;
+                    reverb.setMixingMatrix (matrix);
+                    reverb.setModulation (0.0f, 0.0f);
+                    reverb.setParameters (parameters);
+                    reverb.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+                    auto reverbTime = getReverbTime (roomSize);
+
+                    // long enough for the response to decay by more than 60 dB
+                    AudioBuffer<float> impulseResponse (2, (int) (1.5 * reverbTime * sampleRate));
+                    impulseResponse.clear();
+                    impulseResponse.setSample (0, 0, 1.0f);
+
+                    process (reverb, impulseResponse, blockSize);
+
+                    expectWithinAbsoluteError (measureReverbTime (impulseResponse, sampleRate), reverbTime, 0.05 * reverbTime);
+
+                    // the end of the response is 60 dB below its peak
+                    auto tail = impulseResponse.getMagnitude (impulseResponse.getNumSamples() - (int) (0.1 * sampleRate),
+                                                              (int) (0.1 * sampleRate));
+                    expectLessThan (tail, impulseResponse.getMagnitude (0, impulseResponse.getNumSamples()) * 0.001f);
+                }
+            }
+        }
+
+        beginTest ("Damping shortens the decay");
+        {
+            Reverb::Parameters parameters;
+            parameters.roomSize = 0.4f;
+            parameters.damping = 1.0f;
+            parameters.wetLevel = 1.0f;
+            parameters.dryLevel = 0.0f;
+
+            FDNReverb<float> reverb;
+            reverb.setModulation (0.0f, 0.0f);
+            reverb.setParameters (parameters);
+            reverb.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+            AudioBuffer<float> impulseResponse (2, (int) (1.5 * getReverbTime (0.4f) * sampleRate));
+            impulseResponse.clear();
+            impulseResponse.setSample (0, 0, 1.0f);
+
+            process (reverb, impulseResponse, blockSize);
+
+            expectLessThan (measureReverbTime (impulseResponse, sampleRate), getReverbTime (0.4f));
+        }
+
+        beginTest ("Output stays bounded");
+        {
+            auto random = getRandom();
+
+            for (auto matrix : { FDNReverb<float>::MixingMatrix::hadamard, FDNReverb<float>::MixingMatrix::householder })
+            {
+                // the longest reverberation time, with the default modulation
+                Reverb::Parameters parameters;
+                parameters.roomSize = 1.0f;
+                parameters.damping = 0.0f;
+                parameters.wetLevel = 1.0f;
+                parameters.dryLevel = 0.0f;
+
+                FDNReverb<float> reverb;
+                reverb.setMixingMatrix (matrix);
+                reverb.setParameters (parameters);
+                reverb.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+                // a second of full scale noise, followed by silence
+                AudioBuffer<float> buffer (2, (int) sampleRate * 4);
+                buffer.clear();
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < (int) sampleRate; ++i)
+                        buffer.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+
+                process (reverb, buffer, blockSize);
+
+                auto oneSecond = (int) sampleRate;
+                AudioBuffer<float> input (buffer.getArrayOfWritePointers(), 2, 0, oneSecond);
+                AudioBuffer<float> tail (buffer.getArrayOfWritePointers(), 2, 3 * oneSecond, oneSecond);
+
+                expect (std::isfinite (getPeak (buffer)));
+                expectLessThan (getPeak (buffer), 20.0f);
+
+                // the level decreases once the input has stopped
+                expectLessThan (tail.getRMSLevel (0, 0, oneSecond), input.getRMSLevel (0, 0, oneSecond));
+
+                // frozen, the level stays the same without growing
+                parameters.freezeMode = 1.0f;
+                reverb.setParameters (parameters);
+
+                AudioBuffer<float> frozen (2, oneSecond * 4);
+                frozen.clear();
+                process (reverb, frozen, blockSize);
+
+                auto firstLevel = frozen.getRMSLevel (0, oneSecond / 2, oneSecond);
+                auto lastLevel = frozen.getRMSLevel (0, oneSecond * 3, oneSecond);
+
+                expect (firstLevel > 0.01f);
+                expectWithinAbsoluteError (lastLevel, firstLevel, firstLevel * 0.05f);
+            }
+        }
+    }
+};
+
+static FDNReverbTest fdnReverbUnitTest;
+
+} // namespace dsp
+} // namespace juce
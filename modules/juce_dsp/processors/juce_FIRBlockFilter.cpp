@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace FIR
+{
+
+BlockFilter::BlockFilter()  : coefficients (new Coefficients<float>)
+{
+}
+
+BlockFilter::BlockFilter (Coefficients<float>* coefficientsToUse)  : coefficients (coefficientsToUse)
+{
+}
+
+BlockFilter::~BlockFilter()
+{
+}
+
+BlockFilter::State::State()
+{
+}
+
+BlockFilter::State::~State()
+{
+}
+
+//==============================================================================
+size_t BlockFilter::getCrossoverNumCoefficients (size_t maximumBlockSize) noexcept
+{
+    // The convolution uses larger FFTs relatively to the block size for small
+    // blocks, which makes it more expensive, hence a higher crossover
+    return maximumBlockSize > 128 ? 96 : 160;
+}
+
+void BlockFilter::prepare (const ProcessSpec& spec)
+{
+    // This class can only process mono signals. Use the ProcessorDuplicator class
+    // to apply this filter on a multi-channel audio stream.
+    jassert (spec.numChannels == 1);
+
+    maximumBlockSize = spec.maximumBlockSize;
+    bypassOutput.setSize (1, static_cast<int> (maximumBlockSize));
+
+    state = createState (coefficients);
+    needsUpdate = false;
+}
+
+void BlockFilter::reset() noexcept
+{
+    if (state != nullptr)
+    {
+        state->history.clear();
+
+        if (state->engine != nullptr)
+            state->engine->reset();
+    }
+}
+
+void BlockFilter::setCoefficients (Coefficients<float>* newCoefficients)
+{
+    jassert (newCoefficients != nullptr);
+
+    // before the filter is prepared, the new coefficients are simply used by prepare
+    if (maximumBlockSize == 0)
+    {
+        coefficients = newCoefficients;
+        return;
+    }
+
+    stateExchange.push (createState (newCoefficients));
+}
+
+//==============================================================================
+BlockFilter::State* BlockFilter::createState (Coefficients<float>* coefficientsToUse) const
+{
+    jassert (coefficientsToUse != nullptr);
+
+    auto* newState = new State();
+    newState->coefficients = coefficientsToUse;
+    newState->size = static_cast<size_t> (coefficientsToUse->coefficients.size());
+
+    auto numCoefficients = static_cast<int> (newState->size);
+    newState->currentCoefficients.setSize (1, numCoefficients);
+    newState->currentCoefficients.copyFrom (0, 0, coefficientsToUse->getRawCoefficients(), numCoefficients);
+
+    if (newState->size > getCrossoverNumCoefficients (maximumBlockSize))
+    {
+        ConvolutionEngine::ProcessingInformation info;
+        info.buffer = &newState->currentCoefficients;
+        info.finalSize = numCoefficients;
+        info.maximumBufferSize = maximumBlockSize;
+
+        newState->engine.reset (new ConvolutionEngine());
+        newState->engine->initializeConvolutionEngine (info, 0);
+    }
+    else if (newState->size > 0)
+    {
+        newState->history.setSize (1, static_cast<int> (newState->size - 1 + maximumBlockSize));
+        newState->history.clear();
+    }
+
+    return newState;
+}
+
+void BlockFilter::update() noexcept
+{
+    // a new state prepared by setCoefficients replaces the current one, which is
+    // then released on the thread calling setCoefficients
+    if (stateExchange.pull (state))
+    {
+        coefficients = state->coefficients;
+        needsUpdate = false;
+        return;
+    }
+
+    jassert (coefficients != nullptr);
+
+    if (coefficients == nullptr)
+        return;
+
+    auto newSize = static_cast<size_t> (coefficients->coefficients.size());
+    auto* current = state->currentCoefficients.getWritePointer (0);
+
+    // the coefficients can also be modified in place without any notification, for
+    // example through the state of a ProcessorDuplicator, so their values are compared
+    // with the ones in use, which is cheap next to the filtering of a block
+    if (! needsUpdate && coefficients.get() == state->coefficients.get() && newSize == state->size
+         && (newSize == 0 || std::memcmp (current, coefficients->getRawCoefficients(), sizeof (float) * newSize) == 0))
+        return;
+
+    needsUpdate = false;
+
+    // A different number of coefficients needs new buffers, which can't be allocated
+    // here: call setCoefficients() or prepare() instead
+    jassert (newSize == state->size);
+
+    if (newSize != state->size)
+        return;
+
+    state->coefficients = coefficients;
+
+    FloatVectorOperations::copy (current, coefficients->getRawCoefficients(), static_cast<int> (newSize));
+
+    // the frequency domain algorithm needs to transform the new coefficients
+    if (state->engine != nullptr)
+        state->engine->updateImpulseSegments (current, newSize);
+}
+
+void BlockFilter::processSamples (const float* input, float* output, size_t numSamples, bool isBypassed) noexcept
+{
+    // prepare must be called before processing
+    jassert (maximumBlockSize > 0 && state != nullptr);
+
+    if (maximumBlockSize == 0 || state == nullptr)
+        return;
+
+    update();
+
+    for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+    {
+        auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, maximumBlockSize);
+        auto* src = input + numSamplesProcessed;
+        auto* dst = output + numSamplesProcessed;
+
+        // When bypassed, the filter is still fed with the input, so that it can
+        // be enabled again without any discontinuity
+        auto* out = isBypassed ? bypassOutput.getWritePointer (0) : dst;
+
+        if (state->engine != nullptr)
+            state->engine->processSamples (src, out, numSamplesToProcess);
+        else
+            processDirect (src, out, numSamplesToProcess);
+
+        if (isBypassed && src != dst)
+            FloatVectorOperations::copy (dst, src, static_cast<int> (numSamplesToProcess));
+
+        numSamplesProcessed += numSamplesToProcess;
+    }
+}
+
+void BlockFilter::processDirect (const float* input, float* output, size_t numSamples) noexcept
+{
+    // The history holds the last size - 1 input samples followed by the new ones,
+    // so that every coefficient can be applied to the whole block at once
+    auto size = state->size;
+
+    if (size == 0)
+    {
+        FloatVectorOperations::clear (output, static_cast<int> (numSamples));
+        return;
+    }
+
+    auto* fir = state->currentCoefficients.getReadPointer (0);
+    auto* data = state->history.getWritePointer (0);
+    auto* newSamples = data + size - 1;
+    auto n = static_cast<int> (numSamples);
+
+    FloatVectorOperations::copy (newSamples, input, n);
+    FloatVectorOperations::multiply (output, newSamples, fir[0], n);
+
+    for (size_t k = 1; k < size; ++k)
+        FloatVectorOperations::addWithMultiply (output, newSamples - k, fir[k], n);
+
+    std::memmove (data, data + numSamples, sizeof (float) * (size - 1));
+}
+
+} // namespace FIR
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+#ifndef DOXYGEN
+struct ConvolutionEngine;
+#endif
+
+namespace FIR
+{
+    //==============================================================================
+    /**
+        A processing class performing FIR filtering on blocks of single precision
+        samples, which chooses the fastest algorithm depending on the number of
+        coefficients.
+
+        Short filters are processed in the time domain, one coefficient at a time
+        over the whole block with the vectorised FloatVectorOperations. Above a
+        crossover which depends on the maximum block size, the filter switches to
+        the zero latency uniform-partitioned convolution used by the class
+        Convolution, whose cost per sample grows much more slowly with the number
+        of coefficients. Both algorithms produce the same output as FIR::Filter.
+
+        Changing the number of coefficients means allocating new buffers and
+        possibly a new convolution engine, which is done by prepare(), or by
+        setCoefficients() on a non real-time thread, the audio thread picking up
+        the new state at the beginning of the next block without any allocation.
+
+        The coefficients member can also be replaced between two calls to process()
+        by a set of the same size, or modified in place, which is detected by
+        comparing them with the ones in use at the beginning of each block. With the frequency domain algorithm, any change
+        means transforming the new coefficients, so this shouldn't be done on
+        every block.
+
+        This class can only process mono signals. Use the ProcessorDuplicator class
+        to apply it on a multi-channel audio stream.
+
+        @see FIR::Filter, FIR::Coefficients, Convolution
+
+        @tags{DSP}
+    */
+    class JUCE_API  BlockFilter
+    {
+    public:
+        //==============================================================================
+        /** This will create a filter which will produce silence. */
+        BlockFilter();
+
+        /** Creates a filter with a given set of coefficients. */
+        BlockFilter (Coefficients<float>* coefficientsToUse);
+
+        /** Destructor. */
+        ~BlockFilter();
+
+        //==============================================================================
+        /** Prepare this filter for processing. */
+        void prepare (const ProcessSpec&);
+
+        /** Resets the filter's processing pipeline, ready to start a new stream of data. */
+        void reset() noexcept;
+
+        //==============================================================================
+        /** The coefficients of the FIR filter. It's up to the caller to ensure that
+            these coefficients are modified in a thread-safe way.
+
+            The coefficients are read again when this pointer has been changed or when
+            their values differ from the ones in use, and a new set must have the same
+            size as the current one. Use setCoefficients() to change their number.
+        */
+        typename Coefficients<float>::Ptr coefficients;
+
+        /** Replaces the coefficients with a new set of any size.
+
+            The buffers and the convolution engine needed for the new coefficients are
+            created on the calling thread, so this must not be called on the audio thread.
+            The filter switches to them at the beginning of the next call to process(),
+            and the previous ones are released later by this function or by the destructor.
+        */
+        void setCoefficients (Coefficients<float>* newCoefficients);
+
+        /** Tells the filter that the values of the current coefficients have been
+            modified in place, so that they are read again before the next block.
+            The changes are detected anyway by process(), so this is optional.
+        */
+        void coefficientsChanged() noexcept                 { needsUpdate = true; }
+
+        //==============================================================================
+        /** Processes as a block of samples */
+        template <typename ProcessContext>
+        void process (const ProcessContext& context) noexcept
+        {
+            static_assert (std::is_same<typename ProcessContext::SampleType, float>::value,
+                           "The block FIR filter only supports single precision floating point data");
+
+            auto&& inputBlock  = context.getInputBlock();
+            auto&& outputBlock = context.getOutputBlock();
+
+            // This class can only process mono signals. Use the ProcessorDuplicator class
+            // to apply this filter on a multi-channel audio stream.
+            jassert (inputBlock.getNumChannels()  == 1);
+            jassert (outputBlock.getNumChannels() == 1);
+
+            processSamples (inputBlock.getChannelPointer (0), outputBlock.getChannelPointer (0),
+                            jmin (inputBlock.getNumSamples(), outputBlock.getNumSamples()), context.isBypassed);
+        }
+
+        //==============================================================================
+        /** Returns true if the current coefficients are processed in the frequency
+            domain. This is only known after the filter has been prepared.
+        */
+        bool isUsingFrequencyDomain() const noexcept        { return state != nullptr && state->engine != nullptr; }
+
+        /** Returns the number of coefficients above which the filter is processed in
+            the frequency domain, for a given maximum block size.
+        */
+        static size_t getCrossoverNumCoefficients (size_t maximumBlockSize) noexcept;
+
+    private:
+        //==============================================================================
+        /** The buffers and engine used to process a given number of coefficients. */
+        struct State  : public ProcessorState
+        {
+            State();
+            ~State();
+
+            using Ptr = ReferenceCountedObjectPtr<State>;
+
+            Coefficients<float>::Ptr coefficients;
+            std::unique_ptr<ConvolutionEngine> engine;
+            AudioBuffer<float> history, currentCoefficients;
+            size_t size = 0;
+        };
+
+        State* createState (Coefficients<float>* coefficientsToUse) const;
+
+        void processSamples (const float* input, float* output, size_t numSamples, bool isBypassed) noexcept;
+        void processDirect (const float* input, float* output, size_t numSamples) noexcept;
+        void update() noexcept;
+
+        //==============================================================================
+        State::Ptr state;
+        ProcessorStateExchange<State> stateExchange;
+        AudioBuffer<float> bypassOutput;
+        size_t maximumBlockSize = 0;
+        bool needsUpdate = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockFilter)
+    };
+}
+
+} // namespace dsp
+} // namespace juce
@@ -113,6 +113,8 @@ namespace FIR
 
             If you change the order of the coefficients then you must call reset after
             modifying them.
+
+            @see ProcessorStateExchange
         */
         typename Coefficients<NumericType>::Ptr coefficients;
 
@@ -203,6 +203,154 @@ class FIRFilterTest : public UnitTest
        #endif
     }
 
+    //==============================================================================
+    static bool checkArrayIsSimilar (const float* a, const float* b, size_t n, float tolerance) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            if (std::abs (a[i] - b[i]) > tolerance)
+                return false;
+
+        return true;
+    }
+
+    void runBlockFilterTest()
+    {
+        beginTest ("Block Filter");
+
+        Random random (8392829);
+
+        for (auto size : { 1, 13, 96, 97, 200, 1000 })
+        {
+            constexpr size_t n = 4000, maximumBlockSize = 256;
+            auto numCoefficients = static_cast<size_t> (size);
+
+            HeapBlock<float> input (n), output (n), ref (n), fir (numCoefficients);
+            fillRandom (random, input.getData(), n);
+            fillRandom (random, fir.getData(), numCoefficients);
+
+            FIR::BlockFilter filter (new FIR::Coefficients<float> (fir.getData(), numCoefficients));
+            filter.prepare ({ 0.0, maximumBlockSize, 1 });
+
+            expect (filter.isUsingFrequencyDomain() == (numCoefficients > FIR::BlockFilter::getCrossoverNumCoefficients (maximumBlockSize)));
+
+            // the coefficients are changed in place half way through
+            auto tolerance = 1e-5f * (float) size;
+
+            for (size_t i = 0, len = 0; i < n; i += len)
+            {
+                len = jmin (n - i, static_cast<size_t> (random.nextInt (Range<int> (1, (int) maximumBlockSize + 1))));
+
+                if (i <= n / 2 && i + len > n / 2)
+                {
+                    reference<float, float> (fir.getData(), numCoefficients, input.getData(), ref.getData(), n);
+                    expect (checkArrayIsSimilar (output.getData(), ref.getData(), i, tolerance));
+
+                    FloatVectorOperations::multiply (filter.coefficients->getRawCoefficients(), -0.5f, size);
+                    FloatVectorOperations::multiply (fir.getData(), -0.5f, size);
+                    filter.coefficientsChanged();
+                }
+
+                auto* src = input.getData() + i;
+                auto* dst = output.getData() + i;
+                AudioBlock<float> inBlock (&src, 1, len), outBlock (&dst, 1, len);
+                filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+            }
+
+            reference<float, float> (fir.getData(), numCoefficients, input.getData(), ref.getData(), n);
+            auto start = n / 2 + numCoefficients + 2 * maximumBlockSize;
+            expect (checkArrayIsSimilar (output.getData() + start, ref.getData() + start, n - start, tolerance));
+        }
+
+        beginTest ("Block Filter coefficients size change");
+
+        {
+            constexpr size_t n = 8192, maximumBlockSize = 128;
+
+            HeapBlock<float> input (n), output (n), ref (n);
+            fillRandom (random, input.getData(), n);
+
+            FIR::BlockFilter filter (new FIR::Coefficients<float> (1.0f));
+            filter.prepare ({ 0.0, maximumBlockSize, 1 });
+
+            // each new set of coefficients is picked up at the beginning of the next block,
+            // and processed from a cleared state
+            size_t start = 0;
+
+            for (auto size : { 300, 20, 1000, 97 })
+            {
+                auto numCoefficients = static_cast<size_t> (size);
+                HeapBlock<float> fir (numCoefficients);
+                fillRandom (random, fir.getData(), numCoefficients);
+
+                filter.setCoefficients (new FIR::Coefficients<float> (fir.getData(), numCoefficients));
+
+                auto* src = input.getData() + start;
+                auto* dst = output.getData() + start;
+                auto length = n / 4;
+
+                for (size_t i = 0; i < length; i += maximumBlockSize)
+                {
+                    auto* blockSrc = src + i;
+                    auto* blockDst = dst + i;
+                    AudioBlock<float> inBlock (&blockSrc, 1, maximumBlockSize), outBlock (&blockDst, 1, maximumBlockSize);
+                    filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+                }
+
+                expect (filter.coefficients->getFilterOrder() == numCoefficients - 1);
+                expect (filter.isUsingFrequencyDomain() == (numCoefficients > FIR::BlockFilter::getCrossoverNumCoefficients (maximumBlockSize)));
+
+                reference<float, float> (fir.getData(), numCoefficients, src, ref.getData(), length);
+                expect (checkArrayIsSimilar (dst, ref.getData(), length, 1e-5f * (float) size));
+
+                start += length;
+            }
+        }
+
+        beginTest ("Block Filter coefficients modified through a ProcessorDuplicator");
+
+        for (auto size : { 13, 1000 })
+        {
+            constexpr size_t n = 4096, maximumBlockSize = 128;
+            auto numCoefficients = static_cast<size_t> (size);
+
+            HeapBlock<float> input (n), ref (n), firA (numCoefficients), firB (numCoefficients);
+            fillRandom (random, input.getData(), n);
+            fillRandom (random, firA.getData(), numCoefficients);
+            fillRandom (random, firB.getData(), numCoefficients);
+
+            ProcessorDuplicator<FIR::BlockFilter, FIR::Coefficients<float>> duplicator (new FIR::Coefficients<float> (firA.getData(), numCoefficients));
+            duplicator.prepare ({ 0.0, maximumBlockSize, 2 });
+
+            AudioBuffer<float> buffer (2, (int) n);
+
+            for (int channel = 0; channel < 2; ++channel)
+                buffer.copyFrom (channel, 0, input.getData(), (int) n);
+
+            // the shared coefficients are assigned in place half way through, without
+            // notifying the filters
+            for (size_t i = 0; i < n; i += maximumBlockSize)
+            {
+                if (i == n / 2)
+                    *duplicator.state = FIR::Coefficients<float> (firB.getData(), numCoefficients);
+
+                auto block = AudioBlock<float> (buffer).getSubBlock (i, maximumBlockSize);
+                duplicator.process (ProcessContextReplacing<float> (block));
+            }
+
+            auto tolerance = 1e-5f * (float) size;
+
+            reference<float, float> (firA.getData(), numCoefficients, input.getData(), ref.getData(), n);
+
+            for (int channel = 0; channel < 2; ++channel)
+                expect (checkArrayIsSimilar (buffer.getReadPointer (channel), ref.getData(), n / 2, tolerance));
+
+            reference<float, float> (firB.getData(), numCoefficients, input.getData(), ref.getData(), n);
+            auto start = n / 2 + numCoefficients + 2 * maximumBlockSize;
+
+            for (int channel = 0; channel < 2; ++channel)
+                expect (checkArrayIsSimilar (buffer.getReadPointer (channel) + start, ref.getData() + start, n - start, tolerance));
+        }
+    }
 
 public:
     FIRFilterTest() : UnitTest ("FIR Filter", "DSP") {}
@@ -212,6 +360,7 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+        runBlockFilterTest();
     }
 };
 
@@ -82,9 +82,40 @@ namespace IIR
 
             If you change the order of the coefficients then you must call reset after
             modifying them.
+
+            @see ProcessorStateExchange
         */
         typename Coefficients<NumericType>::Ptr coefficients;
 
+        //==============================================================================
+        /** Sets the length of the ramp used for smoothing the changes of coefficients.
+
+            When it isn't null, any change of the coefficients values between two blocks
+            is interpolated linearly, sample by sample, over this duration, instead of
+            being applied abruptly at the beginning of the block. The order of the
+            coefficients must stay the same for the smoothing to happen.
+
+            The smoothing needs the sample rate given by prepare. The process function
+            looks for changes of the coefficients at the beginning of each block, and
+            processSample follows the ramp once updateSmoothing has started it.
+        */
+        void setRampDurationSeconds (double newDurationSeconds) noexcept;
+
+        /** Returns the ramp duration in seconds. */
+        double getRampDurationSeconds() const noexcept          { return rampDurationSeconds; }
+
+        /** Returns true if the coefficients are currently being interpolated. */
+        bool isSmoothing() const noexcept                       { return numRampSamplesLeft > 0; }
+
+        /** Starts interpolating the coefficients if they have changed since the last
+            call and the smoothing is enabled.
+
+            This is called by process at the beginning of each block. When the samples
+            are processed one by one with processSample, call it whenever the coefficients
+            may have been changed, for instance once per block.
+        */
+        void updateSmoothing() noexcept;
+
         //==============================================================================
         /** Resets the filter's processing pipeline, ready to start a new stream of data.
 
@@ -114,7 +145,9 @@ namespace IIR
 
         /** Processes a single sample, without any locking.
 
-            Use this if you need processing of a single value.
+            Use this if you need processing of a single value. If a ramp of the
+            coefficients has been started, the sample is processed with the
+            interpolated coefficients.
 
             Moreover, you might need the function snapToZero after a few calls to avoid
             potential denormalisation issues.
@@ -130,16 +163,29 @@ namespace IIR
     private:
         //==============================================================================
         void check();
+        void resetRamp() noexcept;
+        void updateRamp() noexcept;
 
         /** Processes as a block of samples */
         template <typename ProcessContext, bool isBypassed>
         void processInternal (const ProcessContext& context) noexcept;
 
+        template <bool isBypassed>
+        void processRamp (const SampleType* src, SampleType* dst, size_t numSamples) noexcept;
+
         //==============================================================================
         HeapBlock<SampleType> memory;
         SampleType* state = nullptr;
         size_t order = 0;
 
+        // the interpolated coefficients, the target ones and the increments of the ramp
+        HeapBlock<NumericType> rampMemory;
+        NumericType* rampCoefficients = nullptr;
+        NumericType* rampTarget = nullptr;
+        NumericType* rampIncrements = nullptr;
+        double sampleRate = 0, rampDurationSeconds = 0;
+        int numRampSamplesLeft = 0;
+
         JUCE_LEAK_DETECTOR (Filter)
     };
 
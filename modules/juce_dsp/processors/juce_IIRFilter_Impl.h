@@ -58,14 +58,81 @@ void Filter<SampleType>::reset (SampleType resetToValue)
         memory.malloc (jmax (order, newOrder, static_cast<size_t> (3)) + 1);
         state = snapPointerToAlignment (memory.getData(), sizeof (SampleType));
         order = newOrder;
+
+        auto numCoefficients = 2 * order + 1;
+        rampMemory.malloc (3 * numCoefficients);
+        rampCoefficients = rampMemory.getData();
+        rampTarget       = rampCoefficients + numCoefficients;
+        rampIncrements   = rampTarget + numCoefficients;
     }
 
     for (size_t i = 0; i < order; ++i)
         state[i] = resetToValue;
+
+    resetRamp();
+}
+
+template <typename SampleType>
+void Filter<SampleType>::prepare (const ProcessSpec& spec) noexcept
+{
+    sampleRate = spec.sampleRate;
+    reset();
+}
+
+template <typename SampleType>
+void Filter<SampleType>::setRampDurationSeconds (double newDurationSeconds) noexcept
+{
+    if (rampDurationSeconds != newDurationSeconds)
+    {
+        rampDurationSeconds = newDurationSeconds;
+        resetRamp();
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::resetRamp() noexcept
+{
+    if (rampCoefficients != nullptr && coefficients != nullptr)
+    {
+        auto* coeffs = coefficients->getRawCoefficients();
+        auto numCoefficients = 2 * order + 1;
+
+        std::copy (coeffs, coeffs + numCoefficients, rampCoefficients);
+        std::copy (coeffs, coeffs + numCoefficients, rampTarget);
+    }
+
+    numRampSamplesLeft = 0;
 }
 
 template <typename SampleType>
-void Filter<SampleType>::prepare (const ProcessSpec&) noexcept     { reset(); }
+void Filter<SampleType>::updateSmoothing() noexcept
+{
+    if (rampDurationSeconds > 0 && sampleRate > 0)
+    {
+        check();
+        updateRamp();
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::updateRamp() noexcept
+{
+    auto* coeffs = coefficients->getRawCoefficients();
+    auto numCoefficients = 2 * order + 1;
+
+    if (! std::equal (coeffs, coeffs + numCoefficients, rampTarget))
+    {
+        auto numRampSamples = jmax (1, roundToInt (sampleRate * rampDurationSeconds));
+
+        for (size_t i = 0; i < numCoefficients; ++i)
+        {
+            rampTarget[i] = coeffs[i];
+            rampIncrements[i] = (coeffs[i] - rampCoefficients[i]) / static_cast<NumericType> (numRampSamples);
+        }
+
+        numRampSamplesLeft = numRampSamples;
+    }
+}
 
 
 template <typename SampleType>
@@ -89,6 +156,20 @@ void Filter<SampleType>::processInternal (const ProcessContext& context) noexcep
     auto* dst = outputBlock.getChannelPointer (0);
     auto* coeffs = coefficients->getRawCoefficients();
 
+    // the beginning of the block is processed with interpolated coefficients
+    // if they have been changed and smoothing is enabled
+    updateSmoothing();
+
+    if (numRampSamplesLeft > 0)
+    {
+        auto numRampSamples = jmin (numSamples, static_cast<size_t> (numRampSamplesLeft));
+        processRamp<bypassed> (src, dst, numRampSamples);
+
+        src += numRampSamples;
+        dst += numRampSamples;
+        numSamples -= numRampSamples;
+    }
+
     // we need to copy this template parameter into a constexpr
     // otherwise MSVC will moan that the tenary expressions below
     // are constant conditional expressions
@@ -194,10 +275,49 @@ void Filter<SampleType>::processInternal (const ProcessContext& context) noexcep
     }
 }
 
+template <typename SampleType>
+template <bool bypassed>
+void Filter<SampleType>::processRamp (const SampleType* src, SampleType* dst, size_t numSamples) noexcept
+{
+    constexpr bool isBypassed = bypassed;
+
+    auto* c = rampCoefficients;
+    auto numCoefficients = 2 * order + 1;
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        for (size_t j = 0; j < numCoefficients; ++j)
+            c[j] += rampIncrements[j];
+
+        auto in = src[i];
+        auto out = (in * c[0]) + state[0];
+        dst[i] = isBypassed ? in : out;
+
+        for (size_t j = 0; j < order - 1; ++j)
+            state[j] = (in * c[j + 1]) - (out * c[order + j + 1]) + state[j + 1];
+
+        state[order - 1] = (in * c[order]) - (out * c[order * 2]);
+    }
+
+    numRampSamplesLeft -= static_cast<int> (numSamples);
+
+    // the end of the ramp lands exactly on the target coefficients
+    if (numRampSamplesLeft == 0)
+        std::copy (rampTarget, rampTarget + numCoefficients, rampCoefficients);
+}
+
 template <typename SampleType>
 SampleType JUCE_VECTOR_CALLTYPE Filter<SampleType>::processSample (SampleType sample) noexcept
 {
     check();
+
+    if (numRampSamplesLeft > 0)
+    {
+        SampleType out;
+        processRamp<false> (&sample, &out, 1);
+        return out;
+    }
+
     auto* c = coefficients->getRawCoefficients();
 
     auto out = (c[0] * sample) + state[0];
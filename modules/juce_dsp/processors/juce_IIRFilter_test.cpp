@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class IIRFilterTest : public UnitTest
+{
+    static double getMaxDifference (const HeapBlock<float>& a, const HeapBlock<float>& b, int n)
+    {
+        double maxDifference = 0;
+
+        for (int i = 0; i < n; ++i)
+            maxDifference = jmax (maxDifference, (double) std::abs (a[i] - b[i]));
+
+        return maxDifference;
+    }
+
+public:
+    IIRFilterTest() : UnitTest ("IIR Filter", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 64;
+        constexpr int numRampSamples = 480;
+
+        beginTest ("Coefficients ramp");
+        {
+            IIR::Filter<float> filter (new IIR::Coefficients<float> (1.0f, 0.0f, 1.0f, 0.0f));
+            filter.prepare ({ sampleRate, (uint32) blockSize, 1 });
+            filter.setRampDurationSeconds (numRampSamples / sampleRate);
+
+            HeapBlock<float> input (numRampSamples * 2), output (numRampSamples * 2);
+            std::fill (input.get(), input.get() + numRampSamples * 2, 1.0f);
+
+            filter.coefficients = new IIR::Coefficients<float> (0.5f, 0.0f, 1.0f, 0.0f);
+
+            for (int i = 0; i < numRampSamples * 2; i += blockSize)
+            {
+                auto* src = input.get() + i;
+                auto* dst = output.get() + i;
+                AudioBlock<float> inBlock (&src, 1, blockSize), outBlock (&dst, 1, blockSize);
+                filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+                expect (filter.isSmoothing() == (i + blockSize < numRampSamples));
+            }
+
+            // the gain goes linearly from 1 to 0.5 over the duration of the ramp
+            for (int i = 0; i < numRampSamples; ++i)
+                expectWithinAbsoluteError (output[i], 1.0f - 0.5f * (float) (i + 1) / numRampSamples, 1.0e-5f);
+
+            for (int i = numRampSamples; i < numRampSamples * 2; ++i)
+                expectEquals (output[i], 0.5f);
+        }
+
+        beginTest ("No ramp");
+        {
+            IIR::Filter<float> filter (new IIR::Coefficients<float> (1.0f, 0.0f, 1.0f, 0.0f));
+            filter.prepare ({ sampleRate, (uint32) blockSize, 1 });
+
+            filter.coefficients = new IIR::Coefficients<float> (0.5f, 0.0f, 1.0f, 0.0f);
+            expectEquals (filter.processSample (1.0f), 0.5f);
+            expect (! filter.isSmoothing());
+        }
+
+        beginTest ("Sample by sample processing follows the ramp");
+        {
+            constexpr int numSamples = 4096;
+            Random random (0x1234);
+
+            HeapBlock<float> input (numSamples), blockOutput (numSamples), sampleOutput (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                input[i] = 2.0f * random.nextFloat() - 1.0f;
+
+            IIR::Filter<float> blockFilter (IIR::Coefficients<float>::makeLowPass (sampleRate, 1000.0f));
+            IIR::Filter<float> sampleFilter (blockFilter.coefficients);
+
+            for (auto* filter : { &blockFilter, &sampleFilter })
+            {
+                filter->prepare ({ sampleRate, (uint32) blockSize, 1 });
+                filter->setRampDurationSeconds (numRampSamples / sampleRate);
+            }
+
+            for (int i = 0; i < numSamples; i += blockSize)
+            {
+                if (i % 1024 == 256)
+                {
+                    auto newCoefficients = IIR::Coefficients<float>::makeLowPass (sampleRate, 500.0f + 4.0f * (float) i);
+                    blockFilter.coefficients = newCoefficients;
+                    sampleFilter.coefficients = newCoefficients;
+                }
+
+                auto* src = input.get() + i;
+                auto* dst = blockOutput.get() + i;
+                AudioBlock<float> inBlock (&src, 1, blockSize), outBlock (&dst, 1, blockSize);
+                blockFilter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+                sampleFilter.updateSmoothing();
+
+                for (int j = i; j < i + blockSize; ++j)
+                    sampleOutput[j] = sampleFilter.processSample (input[j]);
+
+                sampleFilter.snapToZero();
+
+                expect (blockFilter.isSmoothing() == sampleFilter.isSmoothing());
+            }
+
+            expectLessThan (getMaxDifference (blockOutput, sampleOutput, numSamples), 1.0e-6);
+        }
+    }
+};
+
+static IIRFilterTest iirFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -31,6 +31,13 @@ namespace dsp
 
 /** Abstract class for the provided oversampling engines used internally in
     the Oversampling class.
+
+    When SIMD is available, the engines process the channels in groups of
+    SIMDRegister::size() in lock-step: the samples of every group are
+    interleaved into the lanes of a SIMDRegister, and the filter states of
+    the group are stored the same way. The number of channels processed this
+    way is given by util::getNumSIMDChannels(), the others are processed one
+    by one.
 */
 template <typename SampleType>
 class OversamplingEngine
@@ -41,6 +48,7 @@ public:
     {
         numChannels = newNumChannels;
         factor = newFactor;
+        numSIMDChannels = util::getNumSIMDChannels (numChannels, getNumLanes());
     }
 
     virtual ~OversamplingEngine() {}
@@ -52,6 +60,9 @@ public:
     virtual void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling)
     {
         buffer.setSize (static_cast<int> (numChannels), static_cast<int> (maximumNumberOfSamplesBeforeOversampling * factor), false, false, true);
+
+        if (numSIMDChannels > 0)
+            interleaved = dsp::AudioBlock<SampleType> (interleavedData, 2, maximumNumberOfSamplesBeforeOversampling * factor * getNumLanes());
     }
 
     virtual void reset()
@@ -69,9 +80,82 @@ public:
 
 protected:
     //===============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+
+    static Vec* toVec (SampleType* ptr) noexcept
+    {
+        jassert (Vec::isSIMDAligned (ptr));
+        return reinterpret_cast<Vec*> (ptr);
+    }
+   #endif
+
+    static size_t getNumLanes() noexcept
+    {
+       #if JUCE_USE_SIMD
+        return SIMDRegister<SampleType>::size();
+       #else
+        return 1;
+       #endif
+    }
+
+    /** Copies the samples of the channels of a group into the lanes of dest,
+        filling the lanes of the channels missing from the block with zeros.
+    */
+    void interleave (const dsp::AudioBlock<SampleType>& block, size_t firstChannel,
+                     size_t numSamples, SampleType* dest) const noexcept
+    {
+        auto numLanes = getNumLanes();
+        auto numLanesUsed = jmin (numLanes, block.getNumChannels() - firstChannel);
+
+        if (numLanesUsed < numLanes)
+            FloatVectorOperations::clear (dest, static_cast<int> (numSamples * numLanes));
+
+        for (size_t lane = 0; lane < numLanesUsed; ++lane)
+        {
+            auto* src = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i * numLanes + lane] = src[i];
+        }
+    }
+
+    /** Copies the lanes of src to the channels of a group which are in the block. */
+    void deinterleave (const SampleType* src, dsp::AudioBlock<SampleType> block,
+                       size_t firstChannel, size_t numSamples) const noexcept
+    {
+        auto numLanes = getNumLanes();
+
+        for (size_t lane = 0; lane < numLanes && firstChannel + lane < block.getNumChannels(); ++lane)
+        {
+            auto* dest = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i] = src[i * numLanes + lane];
+        }
+    }
+
+    /** Returns the number of groups of channels processed with SIMD. */
+    size_t getNumSIMDGroups() const noexcept
+    {
+        return (numSIMDChannels + getNumLanes() - 1) / getNumLanes();
+    }
+
+    /** Returns the channel of the filter states of a group of channels processed with SIMD. */
+    static SampleType* getGroupState (dsp::AudioBlock<SampleType>& states, size_t firstChannel) noexcept
+    {
+        return states.getChannelPointer (firstChannel / getNumLanes());
+    }
+
+    //===============================================================================
     AudioBuffer<SampleType> buffer;
     size_t factor;
     size_t numChannels;
+
+    // the channels below numSIMDChannels are processed in lock-step, using interleaved as temporary storage
+    size_t numSIMDChannels = 0;
+    HeapBlock<char> interleavedData;
+    dsp::AudioBlock<SampleType> interleaved;
 };
 
 
@@ -139,6 +223,10 @@ public:
         auto N = coefficientsUp.getFilterOrder() + 1;
         stateUp.setSize (static_cast<int> (numChannels), static_cast<int> (N));
 
+        auto numLanes = OversamplingEngine<SampleType>::getNumLanes();
+        auto numGroups = OversamplingEngine<SampleType>::getNumSIMDGroups();
+        stateUpSIMD = dsp::AudioBlock<SampleType> (stateUpSIMDData, numGroups, N * numLanes);
+
         N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
         auto Ndiv4 = Ndiv2 / 2;
@@ -146,6 +234,9 @@ public:
         stateDown.setSize (static_cast<int> (numChannels), static_cast<int> (N));
         stateDown2.setSize (static_cast<int> (numChannels), static_cast<int> (Ndiv4 + 1));
 
+        stateDownSIMD  = dsp::AudioBlock<SampleType> (stateDownSIMDData,  numGroups, N * numLanes);
+        stateDown2SIMD = dsp::AudioBlock<SampleType> (stateDown2SIMDData, numGroups, (Ndiv4 + 1) * numLanes);
+
         position.resize (static_cast<int> (numChannels));
     }
 
@@ -165,6 +256,10 @@ public:
         stateDown.clear();
         stateDown2.clear();
 
+        stateUpSIMD.clear();
+        stateDownSIMD.clear();
+        stateDown2SIMD.clear();
+
         position.fill (0);
     }
 
@@ -174,36 +269,33 @@ public:
         jassert (inputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
         auto numSamples = inputBlock.getNumSamples();
+        size_t channel = 0;
 
-        // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); channel++)
+        // Processing of the channels in lock-step
+       #if JUCE_USE_SIMD
+        for (; channel < jmin (OversamplingEngine<SampleType>::numSIMDChannels, inputBlock.getNumChannels()); channel += Vec::size())
+        {
+            auto* samples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (0);
+            auto* bufferSamples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (1);
+            auto* buf = OversamplingEngine<SampleType>::getGroupState (stateUpSIMD, channel);
+
+            OversamplingEngine<SampleType>::interleave (inputBlock, channel, numSamples, samples);
+            processUp (OversamplingEngine<SampleType>::toVec (samples), OversamplingEngine<SampleType>::toVec (bufferSamples),
+                       OversamplingEngine<SampleType>::toVec (buf), numSamples);
+            OversamplingEngine<SampleType>::deinterleave (bufferSamples, dsp::AudioBlock<SampleType> (OversamplingEngine<SampleType>::buffer),
+                                                          channel, numSamples * 2);
+        }
+       #endif
+
+        // Processing of the remaining channels
+        for (; channel < inputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
             auto buf = stateUp.getWritePointer (static_cast<int> (channel));
             auto samples = inputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; i++)
-            {
-                // Input
-                buf[N - 1] = 2 * samples[i];
-
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
-
-                // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
-            }
+            processUp (samples, bufferSamples, buf, numSamples);
         }
     }
 
@@ -213,56 +305,115 @@ public:
         jassert (outputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
         auto numSamples = outputBlock.getNumSamples();
+        size_t channel = 0;
+
+        // Processing of the channels in lock-step
+       #if JUCE_USE_SIMD
+        for (; channel < jmin (OversamplingEngine<SampleType>::numSIMDChannels, outputBlock.getNumChannels()); channel += Vec::size())
+        {
+            auto* bufferSamples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (0);
+            auto* samples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (1);
+            auto* buf = OversamplingEngine<SampleType>::getGroupState (stateDownSIMD, channel);
+            auto* buf2 = OversamplingEngine<SampleType>::getGroupState (stateDown2SIMD, channel);
+            auto& pos = position.getReference (static_cast<int> (channel));
+
+            OversamplingEngine<SampleType>::interleave (OversamplingEngine<SampleType>::getProcessedSamples (numSamples * 2),
+                                                        channel, numSamples * 2, bufferSamples);
+            processDown (OversamplingEngine<SampleType>::toVec (bufferSamples), OversamplingEngine<SampleType>::toVec (samples),
+                         OversamplingEngine<SampleType>::toVec (buf), OversamplingEngine<SampleType>::toVec (buf2), pos, numSamples);
+            OversamplingEngine<SampleType>::deinterleave (samples, outputBlock, channel, numSamples);
+        }
+       #endif
 
-        // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); channel++)
+        // Processing of the remaining channels
+        for (; channel < outputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
             auto buf = stateDown.getWritePointer (static_cast<int> (channel));
             auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
 
-            for (size_t i = 0; i < numSamples; i++)
-            {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+            processDown (bufferSamples, samples, buf, buf2, position.getReference (static_cast<int> (channel)), numSamples);
+        }
+    }
 
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+private:
+    //===============================================================================
+   #if JUCE_USE_SIMD
+    using Vec = typename OversamplingEngine<SampleType>::Vec;
+   #endif
 
-                // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+    /** Upsamples one channel, or a group of channels interleaved in SIMDRegisters. */
+    template <typename Type>
+    void processUp (const Type* samples, Type* bufferSamples, Type* buf, size_t numSamples) const noexcept
+    {
+        auto fir = coefficientsUp.getRawCoefficients();
+        auto N = coefficientsUp.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
 
-                samples[i] = out;
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            // Input
+            buf[N - 1] = samples[i] * static_cast<SampleType> (2);
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k++)
-                    buf[k] = buf[k + 2];
+            // Convolution
+            auto out = (buf[0] + buf[N - 1]) * fir[0];
+            for (size_t k = 2; k < Ndiv2; k += 2)
+                out += (buf[k] + buf[N - k - 1]) * fir[k];
 
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
-            }
+            // Outputs
+            bufferSamples[i << 1] = out;
+            bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
 
-            position.setUnchecked (static_cast<int> (channel), pos);
+            // Shift data
+            for (size_t k = 0; k < N - 2; k += 2)
+                buf[k] = buf[k + 2];
         }
+    }
+
+    /** Downsamples one channel, or a group of channels interleaved in SIMDRegisters. */
+    template <typename Type>
+    void processDown (const Type* bufferSamples, Type* samples, Type* buf, Type* buf2, size_t& pos, size_t numSamples) const noexcept
+    {
+        auto fir = coefficientsDown.getRawCoefficients();
+        auto N = coefficientsDown.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
+        auto Ndiv4 = Ndiv2 / 2;
 
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            // Input
+            buf[N - 1] = bufferSamples[i << 1];
+
+            // Convolution
+            auto out = (buf[0] + buf[N - 1]) * fir[0];
+            for (size_t k = 2; k < Ndiv2; k += 2)
+                out += (buf[k] + buf[N - k - 1]) * fir[k];
+
+            // Output
+            out += buf2[pos] * fir[Ndiv2];
+            buf2[pos] = bufferSamples[(i << 1) + 1];
+
+            samples[i] = out;
+
+            // Shift data
+            for (size_t k = 0; k < N - 2; k++)
+                buf[k] = buf[k + 2];
+
+            // Circular buffer
+            pos = (pos == 0 ? Ndiv4 : pos - 1);
+        }
     }
 
-private:
     //===============================================================================
     dsp::FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
     AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
     Array<size_t> position;
 
+    HeapBlock<char> stateUpSIMDData, stateDownSIMDData, stateDown2SIMDData;
+    dsp::AudioBlock<SampleType> stateUpSIMD, stateDownSIMD, stateDown2SIMD;
+
     //===============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
 };
@@ -285,12 +436,9 @@ public:
                                     SampleType stopbandAttenuationdBDown) : OversamplingEngine<SampleType> (numChannels, 2)
     {
         auto structureUp = dsp::FilterDesign<SampleType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (normalizedTransitionWidthUp, stopbandAttenuationdBUp);
-        dsp::IIR::Coefficients<SampleType> coeffsUp = getCoefficients (structureUp);
-        latency = static_cast<SampleType> (-(coeffsUp.getPhaseForFrequency (0.0001, 1.0)) / (0.0001 * MathConstants<double>::twoPi));
-
         auto structureDown = dsp::FilterDesign<SampleType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (normalizedTransitionWidthDown, stopbandAttenuationdBDown);
-        dsp::IIR::Coefficients<SampleType> coeffsDown = getCoefficients (structureDown);
-        latency += static_cast<SampleType> (-(coeffsDown.getPhaseForFrequency (0.0001, 1.0)) / (0.0001 * MathConstants<double>::twoPi));
+
+        latency = static_cast<SampleType> (getLatency (structureUp) + getLatency (structureDown));
 
         for (auto i = 0; i < structureUp.directPath.size(); i++)
             coefficientsUp.add (structureUp.directPath[i].coefficients[0]);
@@ -307,6 +455,13 @@ public:
         v1Up.setSize (static_cast<int> (numChannels), coefficientsUp.size());
         v1Down.setSize (static_cast<int> (numChannels), coefficientsDown.size());
         delayDown.resize (static_cast<int> (numChannels));
+
+        // the last register of each group of v1DownSIMD is the delay of the downsampling
+        auto numLanes = OversamplingEngine<SampleType>::getNumLanes();
+        auto numGroups = OversamplingEngine<SampleType>::getNumSIMDGroups();
+
+        v1UpSIMD   = dsp::AudioBlock<SampleType> (v1UpSIMDData,   numGroups, static_cast<size_t> (coefficientsUp.size()) * numLanes);
+        v1DownSIMD = dsp::AudioBlock<SampleType> (v1DownSIMDData, numGroups, static_cast<size_t> (coefficientsDown.size() + 1) * numLanes);
     }
 
     ~Oversampling2TimesPolyphaseIIR() {}
@@ -324,6 +479,9 @@ public:
         v1Up.clear();
         v1Down.clear();
         delayDown.fill (0);
+
+        v1UpSIMD.clear();
+        v1DownSIMD.clear();
     }
 
     void processSamplesUp (dsp::AudioBlock<SampleType> &inputBlock) override
@@ -332,47 +490,33 @@ public:
         jassert (inputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
         // Initialization
-        auto coeffs = coefficientsUp.getRawDataPointer();
-        auto numStages = coefficientsUp.size();
-        auto delayedStages = numStages / 2;
-        auto directStages = numStages - delayedStages;
         auto numSamples = inputBlock.getNumSamples();
+        size_t channel = 0;
 
-        // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); channel++)
+        // Processing of the channels in lock-step
+       #if JUCE_USE_SIMD
+        for (; channel < jmin (OversamplingEngine<SampleType>::numSIMDChannels, inputBlock.getNumChannels()); channel += Vec::size())
+        {
+            auto* samples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (0);
+            auto* bufferSamples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (1);
+            auto* lv1 = OversamplingEngine<SampleType>::getGroupState (v1UpSIMD, channel);
+
+            OversamplingEngine<SampleType>::interleave (inputBlock, channel, numSamples, samples);
+            processUp (OversamplingEngine<SampleType>::toVec (samples), OversamplingEngine<SampleType>::toVec (bufferSamples),
+                       OversamplingEngine<SampleType>::toVec (lv1), numSamples);
+            OversamplingEngine<SampleType>::deinterleave (bufferSamples, dsp::AudioBlock<SampleType> (OversamplingEngine<SampleType>::buffer),
+                                                          channel, numSamples * 2);
+        }
+       #endif
+
+        // Processing of the remaining channels
+        for (; channel < inputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
             auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
             auto samples = inputBlock.getChannelPointer (channel);
 
-            for (size_t i = 0; i < numSamples; i++)
-            {
-                // Direct path cascaded allpass filters
-                auto input = samples[i];
-                for (auto n = 0; n < directStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                bufferSamples[i << 1] = input;
-
-                // Delayed path cascaded allpass filters
-                input = samples[i];
-                for (auto n = directStages; n < numStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                bufferSamples[(i << 1) + 1] = input;
-            }
+            processUp (samples, bufferSamples, lv1, numSamples);
         }
 
         // Snap To Zero
@@ -385,49 +529,34 @@ public:
         jassert (outputBlock.getNumSamples() * OversamplingEngine<SampleType>::factor <= static_cast<size_t> (OversamplingEngine<SampleType>::buffer.getNumSamples()));
 
         // Initialization
-        auto coeffs = coefficientsDown.getRawDataPointer();
-        auto numStages = coefficientsDown.size();
-        auto delayedStages = numStages / 2;
-        auto directStages = numStages - delayedStages;
         auto numSamples = outputBlock.getNumSamples();
+        size_t channel = 0;
 
-        // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); channel++)
+        // Processing of the channels in lock-step
+       #if JUCE_USE_SIMD
+        for (; channel < jmin (OversamplingEngine<SampleType>::numSIMDChannels, outputBlock.getNumChannels()); channel += Vec::size())
+        {
+            auto* bufferSamples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (0);
+            auto* samples = OversamplingEngine<SampleType>::interleaved.getChannelPointer (1);
+            auto* lv1 = OversamplingEngine<SampleType>::toVec (OversamplingEngine<SampleType>::getGroupState (v1DownSIMD, channel));
+            auto& delay = lv1[coefficientsDown.size()];
+
+            OversamplingEngine<SampleType>::interleave (OversamplingEngine<SampleType>::getProcessedSamples (numSamples * 2),
+                                                        channel, numSamples * 2, bufferSamples);
+            processDown (OversamplingEngine<SampleType>::toVec (bufferSamples), OversamplingEngine<SampleType>::toVec (samples),
+                         lv1, delay, numSamples);
+            OversamplingEngine<SampleType>::deinterleave (samples, outputBlock, channel, numSamples);
+        }
+       #endif
+
+        // Processing of the remaining channels
+        for (; channel < outputBlock.getNumChannels(); channel++)
         {
             auto bufferSamples = OversamplingEngine<SampleType>::buffer.getWritePointer (static_cast<int> (channel));
             auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
-            auto delay = delayDown.getUnchecked (static_cast<int> (channel));
 
-            for (size_t i = 0; i < numSamples; i++)
-            {
-                // Direct path cascaded allpass filters
-                auto input = bufferSamples[i << 1];
-                for (auto n = 0; n < directStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-                auto directOut = input;
-
-                // Delayed path cascaded allpass filters
-                input = bufferSamples[(i << 1) + 1];
-                for (auto n = directStages; n < numStages; n++)
-                {
-                    auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
-                    input = output;
-                }
-
-                // Output
-                samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
-                delay = input;
-            }
-
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
+            processDown (bufferSamples, samples, lv1, delayDown.getReference (static_cast<int> (channel)), numSamples);
         }
 
         // Snap To Zero
@@ -436,105 +565,134 @@ public:
 
     void snapToZero (bool snapUpProcessing)
     {
-        if (snapUpProcessing)
+        auto& v1 = snapUpProcessing ? v1Up : v1Down;
+        auto& v1SIMD = snapUpProcessing ? v1UpSIMD : v1DownSIMD;
+
+        for (auto channel = 0; channel < v1.getNumChannels(); channel++)
         {
-            for (auto channel = 0; channel < OversamplingEngine<SampleType>::buffer.getNumChannels(); channel++)
-            {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
+            auto lv1 = v1.getWritePointer (channel);
+            auto numStages = v1.getNumSamples();
 
-                for (auto n = 0; n < numStages; n++)
-                    util::snapToZero (lv1[n]);
-            }
+            for (auto n = 0; n < numStages; n++)
+                util::snapToZero (lv1[n]);
         }
-        else
+
+        for (size_t group = 0; group < v1SIMD.getNumChannels(); group++)
         {
-            for (auto channel = 0; channel < OversamplingEngine<SampleType>::buffer.getNumChannels(); channel++)
-            {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
+            auto lv1 = v1SIMD.getChannelPointer (group);
 
-                for (auto n = 0; n < numStages; n++)
-                    util::snapToZero (lv1[n]);
-            }
+            for (size_t n = 0; n < v1SIMD.getNumSamples(); n++)
+                util::snapToZero (lv1[n]);
         }
     }
 
 private:
     //===============================================================================
-    /** This function calculates the equivalent high order IIR filter of a given
-        polyphase cascaded allpass filters structure.
-    */
-    const dsp::IIR::Coefficients<SampleType> getCoefficients (typename dsp::FilterDesign<SampleType>::IIRPolyphaseAllpassStructure& structure) const
-    {
-        dsp::Polynomial<SampleType> numerator1   ({ static_cast<SampleType> (1.0) });
-        dsp::Polynomial<SampleType> denominator1 ({ static_cast<SampleType> (1.0) });
-        dsp::Polynomial<SampleType> numerator2   ({ static_cast<SampleType> (1.0) });
-        dsp::Polynomial<SampleType> denominator2 ({ static_cast<SampleType> (1.0) });
+   #if JUCE_USE_SIMD
+    using Vec = typename OversamplingEngine<SampleType>::Vec;
+   #endif
 
-        dsp::Polynomial<SampleType> temp;
+    /** Upsamples one channel, or a group of channels interleaved in SIMDRegisters. */
+    template <typename Type>
+    void processUp (const Type* samples, Type* bufferSamples, Type* lv1, size_t numSamples) noexcept
+    {
+        auto coeffs = coefficientsUp.getRawDataPointer();
+        auto numStages = coefficientsUp.size();
+        auto delayedStages = numStages / 2;
+        auto directStages = numStages - delayedStages;
 
-        for (auto n = 0; n < structure.directPath.size(); n++)
+        for (size_t i = 0; i < numSamples; i++)
         {
-            auto* coeffs = structure.directPath.getReference (n).getRawCoefficients();
-
-            if (structure.directPath[n].getFilterOrder() == 1)
+            // Direct path cascaded allpass filters
+            auto input = samples[i];
+            for (auto n = 0; n < directStages; n++)
             {
-                temp = dsp::Polynomial<SampleType> ({ coeffs[0], coeffs[1] });
-                numerator1 = numerator1.getProductWith (temp);
-
-                temp = dsp::Polynomial<SampleType> ({ static_cast<SampleType> (1.0), coeffs[2] });
-                denominator1 = denominator1.getProductWith (temp);
+                auto alpha = coeffs[n];
+                auto output = input * alpha + lv1[n];
+                lv1[n] = input - output * alpha;
+                input = output;
             }
-            else
-            {
-                temp = dsp::Polynomial<SampleType> ({ coeffs[0], coeffs[1], coeffs[2] });
-                numerator1 = numerator1.getProductWith (temp);
 
-                temp = dsp::Polynomial<SampleType> ({ static_cast<SampleType> (1.0), coeffs[3], coeffs[4] });
-                denominator1 = denominator1.getProductWith (temp);
+            // Output
+            bufferSamples[i << 1] = input;
+
+            // Delayed path cascaded allpass filters
+            input = samples[i];
+            for (auto n = directStages; n < numStages; n++)
+            {
+                auto alpha = coeffs[n];
+                auto output = input * alpha + lv1[n];
+                lv1[n] = input - output * alpha;
+                input = output;
             }
+
+            // Output
+            bufferSamples[(i << 1) + 1] = input;
         }
+    }
 
-        for (auto n = 0; n < structure.delayedPath.size(); n++)
-        {
-            auto* coeffs = structure.delayedPath.getReference (n).getRawCoefficients();
+    /** Downsamples one channel, or a group of channels interleaved in SIMDRegisters. */
+    template <typename Type>
+    void processDown (const Type* bufferSamples, Type* samples, Type* lv1, Type& delay, size_t numSamples) noexcept
+    {
+        auto coeffs = coefficientsDown.getRawDataPointer();
+        auto numStages = coefficientsDown.size();
+        auto delayedStages = numStages / 2;
+        auto directStages = numStages - delayedStages;
 
-            if (structure.delayedPath[n].getFilterOrder() == 1)
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            // Direct path cascaded allpass filters
+            auto input = bufferSamples[i << 1];
+            for (auto n = 0; n < directStages; n++)
             {
-                temp = dsp::Polynomial<SampleType> ({ coeffs[0], coeffs[1] });
-                numerator2 = numerator2.getProductWith (temp);
-
-                temp = dsp::Polynomial<SampleType> ({ static_cast<SampleType> (1.0), coeffs[2] });
-                denominator2 = denominator2.getProductWith (temp);
+                auto alpha = coeffs[n];
+                auto output = input * alpha + lv1[n];
+                lv1[n] = input - output * alpha;
+                input = output;
             }
-            else
-            {
-                temp = dsp::Polynomial<SampleType> ({ coeffs[0], coeffs[1], coeffs[2] });
-                numerator2 = numerator2.getProductWith (temp);
+            auto directOut = input;
 
-                temp = dsp::Polynomial<SampleType> ({ static_cast<SampleType> (1.0), coeffs[3], coeffs[4] });
-                denominator2 = denominator2.getProductWith (temp);
+            // Delayed path cascaded allpass filters
+            input = bufferSamples[(i << 1) + 1];
+            for (auto n = directStages; n < numStages; n++)
+            {
+                auto alpha = coeffs[n];
+                auto output = input * alpha + lv1[n];
+                lv1[n] = input - output * alpha;
+                input = output;
             }
-        }
 
-        dsp::Polynomial<SampleType> numeratorf1 = numerator1.getProductWith (denominator2);
-        dsp::Polynomial<SampleType> numeratorf2 = numerator2.getProductWith (denominator1);
-        dsp::Polynomial<SampleType> numerator   = numeratorf1.getSumWith (numeratorf2);
-        dsp::Polynomial<SampleType> denominator = denominator1.getProductWith (denominator2);
+            // Output
+            samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
+            delay = input;
+        }
+    }
 
-        dsp::IIR::Coefficients<SampleType> coeffs;
+    /** This function calculates the exact latency of a given polyphase cascaded
+        allpass filters structure, in samples at the oversampled rate.
 
-        coeffs.coefficients.clear();
-        auto inversion = static_cast<SampleType> (1.0) / denominator[0];
+        Every allpass section is a function of z^-2, with a group delay at DC of
+        2 (1 - alpha) / (1 + alpha) samples. Since both paths have a unity gain and
+        a null phase at DC, the latency of their average is the average of their
+        latencies, the delayed path having one extra sample of delay.
+    */
+    static double getLatency (const typename dsp::FilterDesign<SampleType>::IIRPolyphaseAllpassStructure& structure)
+    {
+        auto getPathLatency = [] (const Array<dsp::IIR::Coefficients<SampleType>>& path, int firstSection)
+        {
+            auto pathLatency = 0.0;
 
-        for (auto i = 0; i <= numerator.getOrder(); i++)
-            coeffs.coefficients.add (numerator[i] * inversion);
+            for (auto n = firstSection; n < path.size(); n++)
+            {
+                auto alpha = static_cast<double> (path.getReference (n).coefficients[0]);
+                pathLatency += 2.0 * (1.0 - alpha) / (1.0 + alpha);
+            }
 
-        for (auto i = 1; i <= denominator.getOrder(); i++)
-            coeffs.coefficients.add (denominator[i] * inversion);
+            return pathLatency;
+        };
 
-        return coeffs;
+        return 0.5 * (getPathLatency (structure.directPath, 0) + 1.0 + getPathLatency (structure.delayedPath, 1));
     }
 
     //===============================================================================
@@ -544,6 +702,9 @@ private:
     AudioBuffer<SampleType> v1Up, v1Down;
     Array<SampleType> delayDown;
 
+    HeapBlock<char> v1UpSIMDData, v1DownSIMDData;
+    dsp::AudioBlock<SampleType> v1UpSIMD, v1DownSIMD;
+
     //===============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
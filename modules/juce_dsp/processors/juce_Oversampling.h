@@ -52,7 +52,13 @@ class OversamplingEngine;
     Choose between FIR or IIR filtering depending on your needs in term of
     latency and phase distortion. With FIR filters, the phase is linear but the
     latency is maximum. With IIR filtering, the phase is compromised around the
-    Nyquist frequency but the latency is minimum.
+    Nyquist frequency but the latency is minimum. The latency of the IIR filters
+    is computed exactly from their coefficients, so it can be compensated without
+    any measurement.
+
+    When SIMD is available, the channels are filtered in groups of
+    SIMDRegister::size() in lock-step, so multi-channel oversampling costs about
+    the same as the oversampling of a single channel per group.
 
     @see FilterDesign.
 
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class OversamplingTest : public UnitTest
+{
+    using FilterType = Oversampling<float>::FilterType;
+
+    static String getName (FilterType type, size_t factor)
+    {
+        return String (1 << factor) + "x, " + (type == Oversampling<float>::filterHalfBandPolyphaseIIR ? "IIR" : "FIR");
+    }
+
+    // upsamples and downsamples the buffer in place, in blocks of the given size
+    template <typename SampleType>
+    static void process (Oversampling<SampleType>& oversampling, AudioBuffer<SampleType>& buffer, int blockSize,
+                         AudioBuffer<SampleType>* upsampled = nullptr)
+    {
+        AudioBlock<SampleType> block (buffer);
+        auto factor = (int) oversampling.getOversamplingFactor();
+
+        for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+        {
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) jmin (blockSize, buffer.getNumSamples() - start));
+            auto upBlock = oversampling.processSamplesUp (subBlock);
+
+            if (upsampled != nullptr)
+                for (size_t channel = 0; channel < upBlock.getNumChannels(); ++channel)
+                    upsampled->copyFrom ((int) channel, start * factor, upBlock.getChannelPointer (channel), (int) upBlock.getNumSamples());
+
+            oversampling.processSamplesDown (subBlock);
+        }
+    }
+
+    // Returns the delay of a sine wave going through the oversampling, measured from
+    // its phase once the filters have settled. The sine has a whole number of periods
+    // in the measurement window.
+    static double measureDelay (Oversampling<double>& oversampling, int numPeriods)
+    {
+        constexpr int settlingTime = 8192;
+        constexpr int windowSize = 8192;
+        constexpr int numSamples = settlingTime + windowSize;
+
+        auto frequency = MathConstants<double>::twoPi * numPeriods / windowSize;
+
+        AudioBuffer<double> buffer (1, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample (0, i, std::sin (frequency * i));
+
+        process (oversampling, buffer, 512);
+
+        double inPhase = 0, quadrature = 0;
+
+        for (int i = settlingTime; i < numSamples; ++i)
+        {
+            inPhase    += buffer.getSample (0, i) * std::sin (frequency * i);
+            quadrature += buffer.getSample (0, i) * std::cos (frequency * i);
+        }
+
+        // the output is a sin (frequency * (i - delay))
+        return -std::atan2 (quadrature, inPhase) / frequency;
+    }
+
+    template <typename SampleType>
+    void runLockStepTest (typename Oversampling<SampleType>::FilterType type, size_t factor, Random& random, SampleType tolerance)
+    {
+        // The last channel of 9 is always processed on its own, so the other ones are
+        // processed in lock-step whatever the size of the SIMD registers is. Each
+        // channel is compared with an oversampling of a single channel.
+        constexpr int numChannels = 9;
+        constexpr int numSamples = 2048;
+        constexpr int blockSize = 256;
+
+        AudioBuffer<SampleType> input (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, (SampleType) (random.nextFloat() * 2.0f - 1.0f));
+
+        Oversampling<SampleType> oversampling ((size_t) numChannels, factor, type);
+        oversampling.initProcessing ((size_t) blockSize);
+
+        auto upsampledSize = numSamples * (int) oversampling.getOversamplingFactor();
+        AudioBuffer<SampleType> output (input), upsampled (numChannels, upsampledSize);
+        process (oversampling, output, blockSize, &upsampled);
+
+        SampleType maxDifference = 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            Oversampling<SampleType> reference (1, factor, type);
+            reference.initProcessing ((size_t) blockSize);
+
+            AudioBuffer<SampleType> referenceOutput (1, numSamples), referenceUpsampled (1, upsampledSize);
+            referenceOutput.copyFrom (0, 0, input, channel, 0, numSamples);
+            process (reference, referenceOutput, blockSize, &referenceUpsampled);
+
+            for (int i = 0; i < numSamples; ++i)
+                maxDifference = jmax (maxDifference, std::abs (output.getSample (channel, i) - referenceOutput.getSample (0, i)));
+
+            for (int i = 0; i < upsampledSize; ++i)
+                maxDifference = jmax (maxDifference, std::abs (upsampled.getSample (channel, i) - referenceUpsampled.getSample (0, i)));
+        }
+
+        expectLessThan (maxDifference, tolerance);
+    }
+
+public:
+    OversamplingTest() : UnitTest ("Oversampling", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        const FilterType types[] = { Oversampling<float>::filterHalfBandFIREquiripple,
+                                     Oversampling<float>::filterHalfBandPolyphaseIIR };
+
+        for (auto type : types)
+        {
+            for (size_t factor = 1; factor <= 3; ++factor)
+            {
+                beginTest ("Reported latency, " + getName (type, factor));
+                {
+                    for (auto numPeriods : { 8, 32 })
+                    {
+                        Oversampling<double> oversampling (1, factor, (Oversampling<double>::FilterType) type);
+                        oversampling.initProcessing (512);
+
+                        // the IIR filters only have a constant delay at low frequencies
+                        expectWithinAbsoluteError (measureDelay (oversampling, numPeriods),
+                                                   (double) oversampling.getLatencyInSamples(), 1.0e-3);
+                    }
+                }
+
+                beginTest ("Channels processed in lock-step, " + getName (type, factor));
+                {
+                    runLockStepTest<float> (type, factor, random, 1.0e-5f);
+                    runLockStepTest<double> ((Oversampling<double>::FilterType) type, factor, random, 1.0e-10);
+                }
+            }
+        }
+    }
+};
+
+static OversamplingTest oversamplingUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -112,6 +112,186 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
 
     template <bool isFirst, typename ProcessorType>
     struct ChainBase<isFirst, ProcessorType>  : public ChainElement<isFirst, ProcessorType, ChainBase<isFirst, ProcessorType>> {};
+
+    //==============================================================================
+    // Tells if a processor has a processSample() method taking the given sample type
+    template <typename Processor, typename SampleType>
+    struct HasProcessSample
+    {
+        template <typename Type>
+        static auto test (int) -> decltype (std::declval<Type&>().processSample (std::declval<SampleType>()), std::true_type());
+
+        template <typename>
+        static std::false_type test (...);
+
+        using Result = decltype (test<Processor> (0));
+    };
+
+    template <typename Processor, typename SampleType>
+    using CanBeFused = typename HasProcessSample<Processor, SampleType>::Result;
+
+    // Applies the processors of a chain to a sample, starting with the first one and
+    // stopping before the first processor that can't be fused. Like with their
+    // process() method, bypassed processors still update their state.
+    template <typename SampleType, bool isFirst, typename Processor>
+    SampleType processFusedSample (ChainBase<isFirst, Processor>& chain, SampleType sample) noexcept
+    {
+        auto output = chain.processor.processSample (sample);
+        return chain.isBypassed ? sample : output;
+    }
+
+    template <typename SampleType, bool isFirst, typename Processor, typename NextProcessor, typename... OtherProcessors>
+    SampleType processFusedSample (ChainBase<isFirst, Processor, NextProcessor, OtherProcessors...>& chain, SampleType sample) noexcept
+    {
+        auto output = chain.processor.processSample (sample);
+        sample = chain.isBypassed ? sample : output;
+        return processFusedSample (chain.processors, sample, CanBeFused<NextProcessor, SampleType>());
+    }
+
+    template <typename SampleType, typename Chain>
+    SampleType processFusedSample (Chain& chain, SampleType sample, std::true_type) noexcept   { return processFusedSample (chain, sample); }
+
+    template <typename SampleType, typename Chain>
+    SampleType processFusedSample (Chain&, SampleType sample, std::false_type) noexcept        { return sample; }
+
+    //==============================================================================
+    // The process() method of some processors does some work once per block, which
+    // has to be done around the loop over the samples when they are fused: starting
+    // the smoothing of the coefficients which have changed, and removing the
+    // denormals from the state variables at the end
+    struct UpdateSmoothing
+    {
+        template <typename Processor>
+        static auto call (Processor& p, int) noexcept -> decltype (p.updateSmoothing(), void())  { p.updateSmoothing(); }
+
+        template <typename Processor>
+        static void call (Processor&, ...) noexcept {}
+
+        template <typename Processor>
+        void operator() (Processor& p) const noexcept    { call (p, 0); }
+    };
+
+    struct SnapToZero
+    {
+        template <typename Processor>
+        static auto call (Processor& p, int) noexcept -> decltype (p.snapToZero(), void())  { p.snapToZero(); }
+
+        template <typename Processor>
+        static void call (Processor&, ...) noexcept {}
+
+        template <typename Processor>
+        void operator() (Processor& p) const noexcept    { call (p, 0); }
+    };
+
+    // Calls a function on each processor which is fused with the first one of a chain
+    template <typename SampleType, bool isFirst, typename Processor, typename Function>
+    void forEachFused (ChainBase<isFirst, Processor>& chain, Function function) noexcept
+    {
+        function (chain.processor);
+    }
+
+    template <typename SampleType, bool isFirst, typename Processor, typename NextProcessor, typename... OtherProcessors, typename Function>
+    void forEachFused (ChainBase<isFirst, Processor, NextProcessor, OtherProcessors...>& chain, Function function) noexcept
+    {
+        function (chain.processor);
+        forEachFused<SampleType> (chain.processors, function, CanBeFused<NextProcessor, SampleType>());
+    }
+
+    template <typename SampleType, typename Chain, typename Function>
+    void forEachFused (Chain& chain, Function function, std::true_type) noexcept    { forEachFused<SampleType> (chain, function); }
+
+    template <typename SampleType, typename Chain, typename Function>
+    void forEachFused (Chain&, Function, std::false_type) noexcept                  {}
+
+    //==============================================================================
+    // Processes a context with a chain, applying each run of processors that have a
+    // processSample() method in a single loop over the samples, and the other ones
+    // with their process() method
+    template <bool isFirst, typename Processor, typename... OtherProcessors, typename ProcessContext>
+    void processFused (ChainBase<isFirst, Processor, OtherProcessors...>& chain, const ProcessContext& context) noexcept
+    {
+        processFused (chain, context, CanBeFused<Processor, typename ProcessContext::SampleType>());
+    }
+
+    template <bool isFirst, typename Processor, typename... OtherProcessors, typename ProcessContext>
+    void processFused (ChainBase<isFirst, Processor, OtherProcessors...>& chain, const ProcessContext& context, std::false_type) noexcept
+    {
+        using Element = ChainElement<isFirst, Processor, ChainBase<isFirst, Processor, OtherProcessors...>>;
+
+        static_cast<Element&> (chain).process (context);
+        processNext (chain, context);
+    }
+
+    template <bool isFirst, typename Processor, typename... OtherProcessors, typename ProcessContext>
+    void processFused (ChainBase<isFirst, Processor, OtherProcessors...>& chain, const ProcessContext& context, std::true_type) noexcept
+    {
+        using SampleType = typename ProcessContext::SampleType;
+
+        auto&& outputBlock = context.getOutputBlock();
+        auto&& inputBlock  = isFirst ? context.getInputBlock() : outputBlock;
+
+        // The per-sample methods of the processors only keep the state of a single
+        // channel, so the blocks with several channels are processed one processor
+        // at a time, like with a ProcessorChain. A SIMDRegister sample type can be
+        // used to fuse the processing of several channels.
+        if (inputBlock.getNumChannels() != 1 || outputBlock.getNumChannels() != 1)
+        {
+            processFused (chain, context, std::false_type());
+            return;
+        }
+
+        jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+        auto* src = inputBlock.getChannelPointer (0);
+        auto* dst = outputBlock.getChannelPointer (0);
+        auto numSamples = outputBlock.getNumSamples();
+
+        forEachFused<SampleType> (chain, UpdateSmoothing());
+
+        if (context.isBypassed)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto input = src[i];
+                processFusedSample (chain, input);
+                dst[i] = input;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = processFusedSample (chain, src[i]);
+        }
+
+        forEachFused<SampleType> (chain, SnapToZero());
+
+        skipFused (chain, context);
+    }
+
+    template <bool isFirst, typename Processor, typename ProcessContext>
+    void processNext (ChainBase<isFirst, Processor>&, const ProcessContext&) noexcept {}
+
+    template <bool isFirst, typename Processor, typename NextProcessor, typename... OtherProcessors, typename ProcessContext>
+    void processNext (ChainBase<isFirst, Processor, NextProcessor, OtherProcessors...>& chain, const ProcessContext& context) noexcept
+    {
+        processFused (chain.processors, context);
+    }
+
+    // Moves past the processors that have already been applied sample by sample
+    template <bool isFirst, typename Processor, typename ProcessContext>
+    void skipFused (ChainBase<isFirst, Processor>&, const ProcessContext&) noexcept {}
+
+    template <bool isFirst, typename Processor, typename NextProcessor, typename... OtherProcessors, typename ProcessContext>
+    void skipFused (ChainBase<isFirst, Processor, NextProcessor, OtherProcessors...>& chain, const ProcessContext& context) noexcept
+    {
+        skipFused (chain.processors, context, CanBeFused<NextProcessor, typename ProcessContext::SampleType>());
+    }
+
+    template <typename Chain, typename ProcessContext>
+    void skipFused (Chain& chain, const ProcessContext& context, std::true_type) noexcept     { skipFused (chain, context); }
+
+    template <typename Chain, typename ProcessContext>
+    void skipFused (Chain& chain, const ProcessContext& context, std::false_type) noexcept    { processFused (chain, context, std::false_type()); }
 }
 #endif
 
@@ -124,5 +304,41 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
 template <typename... Processors>
 using ProcessorChain = ProcessorHelpers::ChainBase<true, Processors...>;
 
+//==============================================================================
+/**
+    A ProcessorChain which fuses the processors that have a processSample() method
+    into a single loop over the samples, instead of running each one of them over
+    the whole block in turn.
+
+    The intermediate results stay in registers rather than being written back to
+    the block after every processor, which is faster for chains of simple
+    processors such as gains, filters and waveshapers. Processors which don't have
+    a processSample() method are still called with the whole block.
+
+    The processors are fused only when the blocks have a single channel, as their
+    per-sample methods only handle one channel. Blocks with several channels are
+    processed like with a ProcessorChain, but several channels can also be processed
+    at once in lock-step by using SIMDRegister samples, like with the IIR::Filter
+    class.
+
+    The smoothing of the coefficients of the filters and the removal of their
+    denormals are done once per block, like in their process() methods, so both
+    chains produce the same output.
+
+    @code
+    FusedProcessorChain<Gain<float>, IIR::Filter<float>, WaveShaper<float>> chain;
+    @endcode
+*/
+template <typename... Processors>
+struct FusedProcessorChain  : public ProcessorHelpers::ChainBase<true, Processors...>
+{
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        ProcessorHelpers::processFused (*this, context);
+    }
+};
+
 } // namespace dsp
 } // namespace juce
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class ProcessorChainTest : public UnitTest
+{
+    static float shaper (float x)    { return std::tanh (x); }
+
+    template <typename Chain>
+    static void prepareChain (Chain& chain, double sampleRate, int blockSize, int numChannels)
+    {
+        chain.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+    }
+
+    template <typename FusedChain, typename Chain>
+    void expectSameOutput (FusedChain& fused, Chain& reference, AudioBuffer<float>& input, int blockSize,
+                           std::function<void (int)> changeParameters)
+    {
+        auto numChannels = input.getNumChannels();
+        auto numSamples  = input.getNumSamples();
+
+        AudioBuffer<float> fusedOutput (numChannels, numSamples), referenceOutput (numChannels, numSamples);
+
+        for (int i = 0; i < numSamples; i += blockSize)
+        {
+            changeParameters (i);
+
+            AudioBlock<float> inBlock (input);
+            auto in = inBlock.getSubBlock ((size_t) i, (size_t) blockSize);
+
+            auto fusedOut = AudioBlock<float> (fusedOutput).getSubBlock ((size_t) i, (size_t) blockSize);
+            fused.process (ProcessContextNonReplacing<float> (in, fusedOut));
+
+            auto referenceOut = AudioBlock<float> (referenceOutput).getSubBlock ((size_t) i, (size_t) blockSize);
+            reference.process (ProcessContextNonReplacing<float> (in, referenceOut));
+        }
+
+        double maxDifference = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxDifference = jmax (maxDifference, (double) std::abs (fusedOutput.getSample (ch, i) - referenceOutput.getSample (ch, i)));
+
+        expectLessThan (maxDifference, 1.0e-5);
+    }
+
+    static void fillRandom (AudioBuffer<float>& buffer, Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, 2.0f * random.nextFloat() - 1.0f);
+    }
+
+public:
+    ProcessorChainTest() : UnitTest ("Processor Chain", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 128;
+        constexpr int numSamples = 8192;
+
+        Random random (0x5678);
+
+        beginTest ("FusedProcessorChain matches ProcessorChain");
+        {
+            FusedProcessorChain<IIR::Filter<float>, Gain<float>, WaveShaper<float>> fused;
+            ProcessorChain<IIR::Filter<float>, Gain<float>, WaveShaper<float>> reference;
+
+            AudioBuffer<float> input (1, numSamples);
+            fillRandom (input, random);
+
+            auto setup = [&] (auto& chain)
+            {
+                prepareChain (chain, sampleRate, blockSize, 1);
+                chain.template get<0>().coefficients = IIR::Coefficients<float>::makeLowPass (sampleRate, 2000.0f);
+                chain.template get<0>().setRampDurationSeconds (0.01);
+                chain.template get<1>().setRampDurationSeconds (0.005);
+                chain.template get<1>().setGainLinear (2.0f);
+                chain.template get<2>().functionToUse = shaper;
+            };
+
+            setup (fused);
+            setup (reference);
+
+            auto changeParameters = [&] (int position)
+            {
+                if (position % 2048 == 1024)
+                {
+                    auto coefficients = IIR::Coefficients<float>::makeLowPass (sampleRate, 500.0f + (float) position / 4.0f);
+                    fused    .get<0>().coefficients = coefficients;
+                    reference.get<0>().coefficients = coefficients;
+
+                    auto gain = 0.5f + (float) position / (float) numSamples;
+                    fused    .get<1>().setGainLinear (gain);
+                    reference.get<1>().setGainLinear (gain);
+                }
+
+                // a bypassed filter still updates its state
+                auto bypassed = (position >= 4096 && position < 5120);
+                fused    .setBypassed<0> (bypassed);
+                reference.setBypassed<0> (bypassed);
+            };
+
+            expectSameOutput (fused, reference, input, blockSize, changeParameters);
+            expect (! fused.get<0>().isSmoothing());
+        }
+
+        beginTest ("Blocks with several channels");
+        {
+            FusedProcessorChain<Gain<float>, WaveShaper<float>> fused;
+            ProcessorChain<Gain<float>, WaveShaper<float>> reference;
+
+            AudioBuffer<float> input (2, numSamples);
+            fillRandom (input, random);
+
+            auto setup = [&] (auto& chain)
+            {
+                prepareChain (chain, sampleRate, blockSize, 2);
+                chain.template get<0>().setRampDurationSeconds (0.005);
+                chain.template get<1>().functionToUse = shaper;
+            };
+
+            setup (fused);
+            setup (reference);
+
+            auto changeParameters = [&] (int position)
+            {
+                auto gain = 1.0f + (float) (position / 1024);
+                fused    .get<0>().setGainLinear (gain);
+                reference.get<0>().setGainLinear (gain);
+            };
+
+            expectSameOutput (fused, reference, input, blockSize, changeParameters);
+        }
+    }
+};
+
+static ProcessorChainTest processorChainUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -76,9 +76,30 @@ struct ProcessorDuplicator
             processors[(int) chan]->process (MonoProcessContext<ProcessContext> (context, chan));
     }
 
+    /** Picks up the last state pushed into a ProcessorStateExchange, if there is a
+        new one, and makes all the processors use it. This is real-time safe, and is
+        meant to be called on the audio thread before processing.
+
+        This works with processors keeping their state in a member called either
+        coefficients or parameters, such as IIR::Filter, FIR::Filter and
+        StateVariableFilter::Filter.
+    */
+    void updateState (ProcessorStateExchange<StateType>& exchange) noexcept
+    {
+        if (exchange.pull (state))
+            for (auto* p : processors)
+                getProcessorState (*p) = state;
+    }
+
     typename StateType::Ptr state;
 
 private:
+    template <typename Processor>
+    static auto getProcessorState (Processor& p) noexcept -> decltype ((p.coefficients))   { return p.coefficients; }
+
+    template <typename Processor>
+    static auto getProcessorState (Processor& p) noexcept -> decltype ((p.parameters))     { return p.parameters; }
+
     template <typename ProcessContext>
     struct MonoProcessContext : public ProcessContext
     {
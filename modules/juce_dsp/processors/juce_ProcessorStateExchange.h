@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Passes new states of processors, such as filter coefficients, from a non
+    real-time thread to the audio thread, without any lock or deallocation on the
+    audio thread.
+
+    Replacing the ref-counted coefficients of a filter from the message thread is
+    not thread-safe, and assigning new ones on the audio thread might delete the
+    previous ones there. Instead, the message thread pushes the new states into
+    this object, and the audio thread pulls the last one before processing. The
+    states which were in use before are handed back to the pushing thread, which
+    releases them the next time it pushes something, or when it calls
+    releaseUnusedStates().
+
+    @code
+    // message thread
+    exchange.push (IIR::Coefficients<float>::makeLowPass (sampleRate, frequency));
+
+    // audio thread
+    exchange.pull (filter.coefficients);
+    filter.process (context);
+    @endcode
+
+    Only the last pushed state is kept if several are pushed before the audio
+    thread pulls them. There must be a single thread pulling the states, and a
+    ProcessorDuplicator can be updated with ProcessorDuplicator::updateState.
+
+    @see ProcessorState, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename StateType>
+class ProcessorStateExchange
+{
+public:
+    //==============================================================================
+    /** Creates an empty exchange. */
+    ProcessorStateExchange() {}
+
+    /** Destructor. */
+    ~ProcessorStateExchange()
+    {
+        releaseUnusedStates();
+
+        if (auto* state = pendingState.exchange (nullptr))
+            state->decReferenceCount();
+    }
+
+    //==============================================================================
+    /** Makes a new state available to the audio thread. This might release the
+        states which aren't used anymore, so it must not be called on the audio
+        thread.
+    */
+    void push (StateType* newState)
+    {
+        jassert (newState != nullptr);
+
+        const ScopedLock sl (releaseLock);
+        releaseUnusedStates();
+
+        newState->incReferenceCount();
+
+        // a state which hasn't been picked up by the audio thread is simply replaced
+        if (auto* previous = pendingState.exchange (newState))
+            previous->decReferenceCount();
+    }
+
+    /** Replaces the state referenced by the given pointer with the last one pushed,
+        if there is a new one, returning true in this case. This is real-time safe,
+        the state previously referenced being released later on the pushing thread.
+    */
+    bool pull (typename StateType::Ptr& target) noexcept
+    {
+        // if the fifo is full, the states already waiting must be released first
+        if (pendingState.load() == nullptr || unusedStates.getFreeSpace() == 0)
+            return false;
+
+        auto* newState = pendingState.exchange (nullptr);
+
+        if (newState == nullptr)
+            return false;
+
+        if (auto* previous = target.get())
+        {
+            int start1, size1, start2, size2;
+            unusedStates.prepareToWrite (1, start1, size1, start2, size2);
+            jassert (size1 == 1);
+
+            previous->incReferenceCount();
+            unusedStateList[start1] = previous;
+            unusedStates.finishedWrite (1);
+        }
+
+        // the reference taken in push is transferred to the target
+        target = newState;
+        newState->decReferenceCountWithoutDeleting();
+
+        return true;
+    }
+
+    /** Returns true if a state has been pushed and not pulled yet. */
+    bool hasPendingState() const noexcept           { return pendingState.load() != nullptr; }
+
+    //==============================================================================
+    /** Releases the states which aren't used by the audio thread anymore. This is
+        done by push as well, so it's only needed if the exchange hasn't been used
+        for a while, to free the memory. It must not be called on the audio thread.
+    */
+    void releaseUnusedStates()
+    {
+        const ScopedLock sl (releaseLock);
+
+        int start1, size1, start2, size2;
+        unusedStates.prepareToRead (unusedStates.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+            unusedStateList[start1 + i]->decReferenceCount();
+
+        for (int i = 0; i < size2; ++i)
+            unusedStateList[start2 + i]->decReferenceCount();
+
+        unusedStates.finishedRead (size1 + size2);
+    }
+
+private:
+    //==============================================================================
+    static constexpr int maxNumUnusedStates = 64;
+
+    std::atomic<StateType*> pendingState { nullptr };
+
+    AbstractFifo unusedStates { maxNumUnusedStates };
+    StateType* unusedStateList[maxNumUnusedStates];
+    CriticalSection releaseLock;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorStateExchange)
+};
+
+} // namespace dsp
+} // namespace juce
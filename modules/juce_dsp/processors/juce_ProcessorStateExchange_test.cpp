@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class ProcessorStateExchangeTest : public UnitTest
+{
+    struct TestState  : public ProcessorState
+    {
+        using Ptr = ReferenceCountedObjectPtr<TestState>;
+
+        TestState (std::atomic<int>& counter, int v) : numAlive (counter), value (v)   { ++numAlive; }
+        ~TestState()                                                                  { --numAlive; }
+
+        std::atomic<int>& numAlive;
+        int value;
+    };
+
+    struct PushThread  : public Thread
+    {
+        PushThread (ProcessorStateExchange<TestState>& e, std::atomic<int>& counter, int num)
+            : Thread ("ProcessorStateExchange push"), exchange (e), numAlive (counter), numStates (num)
+        {}
+
+        void run() override
+        {
+            for (int i = 1; i <= numStates; ++i)
+                exchange.push (new TestState (numAlive, i));
+        }
+
+        ProcessorStateExchange<TestState>& exchange;
+        std::atomic<int>& numAlive;
+        int numStates;
+    };
+
+public:
+    ProcessorStateExchangeTest() : UnitTest ("ProcessorStateExchange", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("Push and pull");
+        {
+            std::atomic<int> numAlive { 0 };
+            ProcessorStateExchange<TestState> exchange;
+            TestState::Ptr target (new TestState (numAlive, 0));
+
+            expect (! exchange.pull (target));
+            expect (! exchange.hasPendingState());
+
+            exchange.push (new TestState (numAlive, 1));
+            expect (exchange.hasPendingState());
+            expectEquals (numAlive.load(), 2);
+
+            expect (exchange.pull (target));
+            expect (! exchange.hasPendingState());
+            expectEquals (target->value, 1);
+            expectEquals (target->getReferenceCount(), 1);
+
+            // the previous state is kept alive until the pushing thread releases it
+            expectEquals (numAlive.load(), 2);
+            exchange.releaseUnusedStates();
+            expectEquals (numAlive.load(), 1);
+
+            expect (! exchange.pull (target));
+            expectEquals (target->value, 1);
+        }
+
+        beginTest ("Only the last pushed state is kept");
+        {
+            std::atomic<int> numAlive { 0 };
+            ProcessorStateExchange<TestState> exchange;
+            TestState::Ptr target;
+
+            exchange.push (new TestState (numAlive, 1));
+            exchange.push (new TestState (numAlive, 2));
+            expectEquals (numAlive.load(), 1);
+
+            expect (exchange.pull (target));
+            expectEquals (target->value, 2);
+            expectEquals (target->getReferenceCount(), 1);
+
+            // a state still referenced elsewhere isn't deleted by the exchange
+            TestState::Ptr other (new TestState (numAlive, 3));
+            exchange.push (other);
+            expect (exchange.pull (target));
+            exchange.releaseUnusedStates();
+            expectEquals (numAlive.load(), 1);
+            expectEquals (other->getReferenceCount(), 2);
+        }
+
+        beginTest ("Destructor releases the pending and unused states");
+        {
+            std::atomic<int> numAlive { 0 };
+            TestState::Ptr target (new TestState (numAlive, 0));
+
+            {
+                ProcessorStateExchange<TestState> exchange;
+                exchange.push (new TestState (numAlive, 1));
+                exchange.pull (target);
+                exchange.push (new TestState (numAlive, 2));
+
+                // pushing released the state replaced by the pull
+                expectEquals (numAlive.load(), 2);
+            }
+
+            expectEquals (numAlive.load(), 1);
+            expectEquals (target->value, 1);
+        }
+
+        beginTest ("Concurrent push and pull");
+        {
+            std::atomic<int> numAlive { 0 };
+            TestState::Ptr target;
+
+            {
+                ProcessorStateExchange<TestState> exchange;
+                const int numStates = 20000;
+
+                PushThread pusher (exchange, numAlive, numStates);
+                pusher.startThread();
+
+                int lastValue = 0;
+                bool valuesIncrease = true;
+
+                while (pusher.isThreadRunning() || exchange.hasPendingState())
+                {
+                    if (exchange.pull (target))
+                    {
+                        valuesIncrease = valuesIncrease && target->value > lastValue;
+                        lastValue = target->value;
+                    }
+                    else if (! pusher.isThreadRunning())
+                    {
+                        exchange.releaseUnusedStates();
+                    }
+                }
+
+                pusher.stopThread (-1);
+
+                expect (valuesIncrease);
+                expectEquals (target->value, numStates);
+            }
+
+            expectEquals (numAlive.load(), 1);
+            target = nullptr;
+            expectEquals (numAlive.load(), 0);
+        }
+    }
+};
+
+static ProcessorStateExchangeTest processorStateExchangeUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -32,6 +32,8 @@ namespace dsp
 /**
     Processor wrapper around juce::Reverb for easy integration into ProcessorChain.
 
+    @see FDNReverb
+
     @tags{DSP}
 */
 class Reverb
@@ -74,10 +74,18 @@ namespace StateVariableFilter
 
         //==============================================================================
         /** Initialization of the filter */
-        void prepare (const ProcessSpec&) noexcept     { reset(); }
+        void prepare (const ProcessSpec& spec) noexcept
+        {
+            sampleRate = spec.sampleRate;
+            reset();
+        }
 
         /** Resets the filter's processing pipeline. */
-        void reset() noexcept                          { s1 = s2 = SampleType {0}; }
+        void reset() noexcept
+        {
+            s1 = s2 = SampleType {0};
+            resetRamp();
+        }
 
         /** Ensure that the state variables are rounded to zero if the state
             variables are denormals. This is only needed if you are doing
@@ -87,9 +95,53 @@ namespace StateVariableFilter
 
         //==============================================================================
         /** The parameters of the state variable filter. It's up to the called to ensure
-            that these parameters are modified in a thread-safe way. */
+            that these parameters are modified in a thread-safe way.
+
+            @see ProcessorStateExchange
+        */
         typename Parameters<NumericType>::Ptr parameters;
 
+        //==============================================================================
+        /** Sets the length of the ramp used for smoothing the changes of the cutoff
+            frequency and resonance.
+
+            When it isn't null, any change of the parameters between two blocks is
+            interpolated linearly, sample by sample, over this duration. The smoothing
+            needs the sample rate given by prepare. The process function looks for
+            changes of the parameters at the beginning of each block, and processSample
+            follows the ramp once updateSmoothing has started it.
+        */
+        void setRampDurationSeconds (double newDurationSeconds) noexcept
+        {
+            if (rampDurationSeconds != newDurationSeconds)
+            {
+                rampDurationSeconds = newDurationSeconds;
+                resetRamp();
+            }
+        }
+
+        /** Returns the ramp duration in seconds. */
+        double getRampDurationSeconds() const noexcept  { return rampDurationSeconds; }
+
+        /** Returns true if the parameters are currently being interpolated. */
+        bool isSmoothing() const noexcept               { return smoothedG.isSmoothing() || smoothedR2.isSmoothing(); }
+
+        /** Starts interpolating the parameters if they have changed since the last
+            call and the smoothing is enabled.
+
+            This is called by process at the beginning of each block. When the samples
+            are processed one by one with processSample, call it whenever the parameters
+            may have been changed, for instance once per block.
+        */
+        void updateSmoothing() noexcept
+        {
+            if (rampDurationSeconds > 0 && sampleRate > 0)
+            {
+                smoothedG .setValue (parameters->g);
+                smoothedR2.setValue (parameters->R2);
+            }
+        }
+
         //==============================================================================
         template <typename ProcessContext>
         void process (const ProcessContext& context) noexcept
@@ -104,14 +156,17 @@ namespace StateVariableFilter
         }
 
         /** Processes a single sample, without any locking or checking.
-            Use this if you need processing of a single value. */
+            Use this if you need processing of a single value. If a ramp of the
+            parameters has been started, the sample is processed with the
+            interpolated parameters.
+        */
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             switch (parameters->type)
             {
-                case Parameters<NumericType>::Type::lowPass:  return processLoop<false, Parameters<NumericType>::Type::lowPass>  (sample, *parameters); break;
-                case Parameters<NumericType>::Type::bandPass: return processLoop<false, Parameters<NumericType>::Type::bandPass> (sample, *parameters); break;
-                case Parameters<NumericType>::Type::highPass: return processLoop<false, Parameters<NumericType>::Type::highPass> (sample, *parameters); break;
+                case Parameters<NumericType>::Type::lowPass:  return processSingle<Parameters<NumericType>::Type::lowPass>  (sample); break;
+                case Parameters<NumericType>::Type::bandPass: return processSingle<Parameters<NumericType>::Type::bandPass> (sample); break;
+                case Parameters<NumericType>::Type::highPass: return processSingle<Parameters<NumericType>::Type::highPass> (sample); break;
                 default: jassertfalse;
             }
 
@@ -121,29 +176,54 @@ namespace StateVariableFilter
     private:
         //==============================================================================
         template <bool isBypassed, typename Parameters<NumericType>::Type type>
-        SampleType JUCE_VECTOR_CALLTYPE processLoop (SampleType sample, Parameters<NumericType>& state) noexcept
+        SampleType JUCE_VECTOR_CALLTYPE processLoop (SampleType sample, NumericType g, NumericType R2, NumericType h) noexcept
         {
-            y[2] = (sample - s1 * state.R2 - s1 * state.g - s2) * state.h;
+            y[2] = (sample - s1 * R2 - s1 * g - s2) * h;
 
-            y[1] = y[2] * state.g + s1;
-            s1   = y[2] * state.g + y[1];
+            y[1] = y[2] * g + s1;
+            s1   = y[2] * g + y[1];
 
-            y[0] = y[1] * state.g + s2;
-            s2   = y[1] * state.g + y[0];
+            y[0] = y[1] * g + s2;
+            s2   = y[1] * g + y[0];
 
             return isBypassed ? sample : y[static_cast<size_t> (type)];
         }
 
+        template <typename Parameters<NumericType>::Type type>
+        SampleType JUCE_VECTOR_CALLTYPE processSingle (SampleType sample) noexcept
+        {
+            if (isSmoothing())
+            {
+                advanceRamp();
+                return processLoop<false, type> (sample, rampG, rampR2, rampH);
+            }
+
+            auto& p = *parameters;
+            return processLoop<false, type> (sample, p.g, p.R2, p.h);
+        }
+
         template <bool isBypassed, typename Parameters<NumericType>::Type type>
         void processBlock (const SampleType* input, SampleType* output, size_t n) noexcept
         {
-            auto state = *parameters;
+            size_t i = 0;
+
+            updateSmoothing();
 
-            for (size_t i = 0 ; i < n; ++i)
-                output[i] = processLoop<isBypassed, type> (input[i], state);
+            for (; i < n && isSmoothing(); ++i)
+            {
+                advanceRamp();
+                output[i] = processLoop<isBypassed, type> (input[i], rampG, rampR2, rampH);
+            }
+
+            if (i < n)
+            {
+                const auto g = parameters->g, R2 = parameters->R2, h = parameters->h;
+
+                for (; i < n; ++i)
+                    output[i] = processLoop<isBypassed, type> (input[i], g, R2, h);
+            }
 
             snapToZero();
-            *parameters = state;
         }
 
         template <bool isBypassed, typename ProcessContext>
@@ -170,10 +250,36 @@ namespace StateVariableFilter
             }
         }
 
+        void advanceRamp() noexcept
+        {
+            rampG  = smoothedG .getNextValue();
+            rampR2 = smoothedR2.getNextValue();
+            rampH  = static_cast<NumericType> (1.0 / (1.0 + rampR2 * rampG + rampG * rampG));
+        }
+
+        void resetRamp() noexcept
+        {
+            if (sampleRate > 0)
+            {
+                smoothedG .reset (sampleRate, rampDurationSeconds);
+                smoothedR2.reset (sampleRate, rampDurationSeconds);
+            }
+
+            if (parameters != nullptr)
+            {
+                smoothedG .setValue (parameters->g,  true);
+                smoothedR2.setValue (parameters->R2, true);
+            }
+        }
+
         //==============================================================================
         std::array<SampleType, 3> y;
         SampleType s1, s2;
 
+        double sampleRate = 0, rampDurationSeconds = 0;
+        LinearSmoothedValue<NumericType> smoothedG, smoothedR2;
+        NumericType rampG {}, rampR2 {}, rampH {};
+
         //==============================================================================
         JUCE_LEAK_DETECTOR (Filter)
     };
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+class StateVariableFilterTest : public UnitTest
+{
+public:
+    StateVariableFilterTest() : UnitTest ("State Variable Filter", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 64;
+        constexpr int numRampSamples = 240;
+        constexpr int numSamples = 4096;
+
+        Random random (0x4321);
+        HeapBlock<float> input (numSamples), blockOutput (numSamples), sampleOutput (numSamples), abruptOutput (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            input[i] = 2.0f * random.nextFloat() - 1.0f;
+
+        StateVariableFilter::Filter<float> blockFilter, sampleFilter, abruptFilter;
+
+        for (auto* filter : { &blockFilter, &sampleFilter, &abruptFilter })
+        {
+            filter->parameters->setCutOffFrequency (sampleRate, 1000.0f, 2.0f);
+            filter->prepare ({ sampleRate, (uint32) blockSize, 1 });
+        }
+
+        blockFilter .setRampDurationSeconds (numRampSamples / sampleRate);
+        sampleFilter.setRampDurationSeconds (numRampSamples / sampleRate);
+
+        beginTest ("Parameters ramp");
+        {
+            for (int i = 0; i < numSamples; i += blockSize)
+            {
+                if (i == 1024)
+                    for (auto* filter : { &blockFilter, &sampleFilter, &abruptFilter })
+                        filter->parameters->setCutOffFrequency (sampleRate, 8000.0f, 0.5f);
+
+                for (auto* filter : { &blockFilter, &abruptFilter })
+                {
+                    auto* src = input.get() + i;
+                    auto* dst = (filter == &blockFilter ? blockOutput : abruptOutput).get() + i;
+                    AudioBlock<float> inBlock (&src, 1, blockSize), outBlock (&dst, 1, blockSize);
+                    filter->process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+                }
+
+                sampleFilter.updateSmoothing();
+
+                for (int j = i; j < i + blockSize; ++j)
+                    sampleOutput[j] = sampleFilter.processSample (input[j]);
+
+                sampleFilter.snapToZero();
+
+                expect (blockFilter.isSmoothing() == (i >= 1024 && i + blockSize < 1024 + numRampSamples));
+                expect (sampleFilter.isSmoothing() == blockFilter.isSmoothing());
+                expect (! abruptFilter.isSmoothing());
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (sampleOutput[i], blockOutput[i], 1.0e-6f);
+
+            for (int i = 0; i < 1024; ++i)
+                expectEquals (blockOutput[i], abruptOutput[i]);
+
+            // the ramp changes the output only around the change of the parameters
+            expectNotEquals (blockOutput[1024], abruptOutput[1024]);
+
+            for (int i = numSamples - 1024; i < numSamples; ++i)
+                expectWithinAbsoluteError (blockOutput[i], abruptOutput[i], 1.0e-5f);
+        }
+    }
+};
+
+static StateVariableFilterTest stateVariableFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -32,6 +32,10 @@ namespace dsp
 /**
     Applies waveshaping to audio samples as single samples or AudioBlocks.
 
+    When the function is a LookupTableTransform, the AudioBlocks are processed a
+    whole channel at a time with LookupTableTransform::process() instead of sample
+    by sample.
+
     @tags{DSP}
 */
 template <typename FloatType, typename Function = FloatType (*) (FloatType)>
@@ -62,13 +66,29 @@ struct WaveShaper
         }
         else
         {
-            AudioBlock<FloatType>::process (context.getInputBlock(),
-                                            context.getOutputBlock(),
-                                            functionToUse);
+            processBlock (functionToUse, context.getInputBlock(), context.getOutputBlock());
         }
     }
 
     void reset() noexcept {}
+
+private:
+    //==============================================================================
+    template <typename FunctionType, typename SampleType>
+    static void processBlock (const FunctionType& function, const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output) noexcept
+    {
+        AudioBlock<SampleType>::process (input, output, function);
+    }
+
+    template <typename SampleType>
+    static void processBlock (const LookupTableTransform<SampleType>& function, const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output) noexcept
+    {
+        jassert (input.getNumChannels() == output.getNumChannels());
+        jassert (input.getNumSamples() == output.getNumSamples());
+
+        for (size_t channel = 0; channel < input.getNumChannels(); ++channel)
+            function.process (input.getChannelPointer (channel), output.getChannelPointer (channel), input.getNumSamples());
+    }
 };
 
 //==============================================================================
@@ -0,0 +1,393 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/** The operations used to run the oscillators, either one by one or in groups
+    using the lanes of a SIMDRegister.
+*/
+template <typename Type>
+struct WavetableOscillatorLanes
+{
+    static constexpr size_t size() noexcept                 { return 1; }
+
+    static Type load (const Type* src) noexcept             { return *src; }
+    static void store (Type value, Type* dest) noexcept     { *dest = value; }
+    static Type limit (Type value, Type maximum) noexcept   { return jlimit (-maximum, maximum, value); }
+
+    static Type wrap (Type phase, Type tableSize) noexcept
+    {
+        if (phase < 0)          phase += tableSize;
+        if (phase >= tableSize) phase -= tableSize;
+
+        return phase;
+    }
+};
+
+#if JUCE_USE_SIMD
+template <typename SampleType>
+struct WavetableOscillatorLanes<SIMDRegister<SampleType>>
+{
+    using Vec = SIMDRegister<SampleType>;
+
+    static constexpr size_t size() noexcept                             { return Vec::size(); }
+
+    static Vec load (const SampleType* src) noexcept                    { return Vec::fromRawArray (src); }
+    static void store (Vec value, SampleType* dest) noexcept            { value.copyToRawArray (dest); }
+
+    static Vec limit (Vec value, SampleType maximum) noexcept
+    {
+        return Vec::min (Vec::max (value, Vec::expand (-maximum)), Vec::expand (maximum));
+    }
+
+    static Vec wrap (Vec phase, SampleType tableSize) noexcept
+    {
+        auto sizes = Vec::expand (tableSize);
+
+        // the negative phases are wrapped first, as adding the table size to a
+        // tiny negative value can round it up to the table size itself
+        phase += sizes & Vec::lessThan (phase, Vec::expand (SampleType()));
+        return phase - (sizes & Vec::greaterThanOrEqual (phase, sizes));
+    }
+};
+#endif
+
+//==============================================================================
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::WavetableOscillatorBank()
+{
+    setWaveform ([] (SampleType x) { return std::sin (x); });
+}
+
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::~WavetableOscillatorBank()
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setWaveform (const std::function<SampleType (SampleType)>& function, size_t newTableSize)
+{
+    HeapBlock<SampleType> singleCycle (newTableSize);
+
+    for (size_t i = 0; i < newTableSize; ++i)
+        singleCycle[i] = function (MathConstants<SampleType>::twoPi * static_cast<SampleType> (i) / static_cast<SampleType> (newTableSize)
+                                    - MathConstants<SampleType>::pi);
+
+    setWaveform (singleCycle, newTableSize);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setWaveform (const SampleType* singleCycle, size_t numSamples)
+{
+    // the size of the tables must be a power of two
+    jassert (isPowerOfTwo (numSamples) && numSamples >= 4);
+
+    auto order = roundToInt (std::log2 ((double) numSamples));
+    auto oldTableSize = tableSize;
+
+    tableSize = numSamples;
+    numLevels = jmax (1, order - 1);
+    tables.malloc ((size_t) numLevels * (tableSize + 1));
+
+    // The tables are band-limited in the frequency domain, so that the level k only
+    // keeps the harmonics below tableSize / 2^(k + 1), which don't alias as long as
+    // an oscillator doesn't read more than 2^k samples of the table per sample.
+    // The FFT class only works with floats, so the double tables go through them.
+    FFT fft (order);
+    HeapBlock<float> spectrum (2 * tableSize), levelData (2 * tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        spectrum[i] = static_cast<float> (singleCycle[i]);
+
+    fft.performRealOnlyForwardTransform (spectrum, false);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        auto numHarmonics = tableSize >> (level + 1);
+        auto* table = tables + (size_t) level * (tableSize + 1);
+
+        FloatVectorOperations::copy (levelData, spectrum, static_cast<int> (2 * tableSize));
+        FloatVectorOperations::clear (levelData + 2 * numHarmonics,
+                                      static_cast<int> (2 * (tableSize - 2 * numHarmonics + 1)));
+
+        fft.performRealOnlyInverseTransform (levelData);
+
+        for (size_t i = 0; i < tableSize; ++i)
+            table[i] = static_cast<SampleType> (levelData[i]);
+
+        table[tableSize] = table[0];
+    }
+
+    // the phases and increments of the oscillators are in samples of the tables, so
+    // they have to follow a change of size
+    if (oldTableSize != tableSize)
+    {
+        auto scale = static_cast<SampleType> (tableSize) / static_cast<SampleType> (jmax ((size_t) 1, oldTableSize));
+
+        for (size_t i = 0; i < numOscillators; ++i)
+        {
+            states.setSample (phaseChannel, (int) i,
+                              WavetableOscillatorLanes<SampleType>::wrap (states.getSample (phaseChannel, (int) i) * scale,
+                                                                          static_cast<SampleType> (tableSize)));
+            updateIncrement (i);
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.maximumBlockSize > 0);
+
+    sampleRate = spec.sampleRate;
+    numOscillators = spec.numChannels;
+    maximumBlockSize = spec.maximumBlockSize;
+
+   #if JUCE_USE_SIMD
+    auto numLanes = SIMDRegister<SampleType>::size();
+   #else
+    size_t numLanes = 1;
+   #endif
+
+    // the states are padded to a multiple of the SIMD register size, so that the
+    // last group of oscillators can always be processed in lock-step
+    auto numGroups = (numOscillators + numLanes - 1) / numLanes;
+    states = AudioBlock<SampleType> (statesData, numStateChannels, numGroups * numLanes);
+    positions = AudioBlock<SampleType> (positionsData, 1, maximumBlockSize * numLanes);
+    states.clear();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::reset() noexcept
+{
+    states.getSingleChannelBlock (phaseChannel).clear();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+
+    states.setSample (frequencyChannel, (int) oscillatorIndex, newFrequency);
+    updateIncrement (oscillatorIndex);
+}
+
+template <typename SampleType>
+SampleType WavetableOscillatorBank<SampleType>::getFrequency (size_t oscillatorIndex) const noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+
+    return states.getSample (frequencyChannel, (int) oscillatorIndex);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept
+{
+    jassert (oscillatorIndex < numOscillators);
+
+    auto phase = (newPhase - std::floor (newPhase)) * static_cast<SampleType> (tableSize);
+    states.setSample (phaseChannel, (int) oscillatorIndex,
+                      WavetableOscillatorLanes<SampleType>::wrap (phase, static_cast<SampleType> (tableSize)));
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateIncrement (size_t oscillatorIndex) noexcept
+{
+    auto size = static_cast<SampleType> (tableSize);
+    auto increment = static_cast<SampleType> (getFrequency (oscillatorIndex) * size / sampleRate);
+
+    // above the Nyquist frequency the oscillators would only play their aliases
+    states.setSample (incrementChannel, (int) oscillatorIndex,
+                      WavetableOscillatorLanes<SampleType>::limit (increment, size / 2));
+}
+
+template <typename SampleType>
+int WavetableOscillatorBank<SampleType>::getLevelForIncrement (SampleType increment) const noexcept
+{
+    increment = std::abs (increment);
+
+    if (increment <= 1)
+        return 0;
+
+    return jmin (static_cast<int> (std::ceil (std::log2 (increment))), numLevels - 1);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::skipSamples (size_t numSamples) noexcept
+{
+    auto size = static_cast<SampleType> (tableSize);
+
+    for (size_t i = 0; i < numOscillators; ++i)
+    {
+        auto phase = states.getSample (phaseChannel, (int) i)
+                       + states.getSample (incrementChannel, (int) i) * static_cast<SampleType> (numSamples);
+
+        states.setSample (phaseChannel, (int) i,
+                          WavetableOscillatorLanes<SampleType>::wrap (std::fmod (phase, size), size));
+    }
+}
+
+template <typename SampleType>
+template <typename Type>
+void WavetableOscillatorBank<SampleType>::processOscillators (size_t firstOscillator, size_t numLanesUsed,
+                                                             const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output,
+                                                             const AudioBlock<SampleType>* frequencyMultipliers,
+                                                             size_t numSamples) noexcept
+{
+    using Lanes = WavetableOscillatorLanes<Type>;
+    constexpr auto numLanes = Lanes::size();
+
+    auto size = static_cast<SampleType> (tableSize);
+    auto* phaseData     = states.getChannelPointer (phaseChannel)     + firstOscillator;
+    auto* incrementData = states.getChannelPointer (incrementChannel) + firstOscillator;
+    auto* positionData  = positions.getChannelPointer (0);
+
+    // The positions of the oscillators of the group are computed in lock-step first,
+    // interleaved so that every sample of the buffer holds the positions of all the
+    // lanes, and every oscillator then reads its table one after the other
+    auto phase = Lanes::load (phaseData);
+    auto increment = Lanes::load (incrementData);
+
+    if (frequencyMultipliers != nullptr)
+    {
+        if (numLanesUsed < numLanes)
+            FloatVectorOperations::clear (positionData, static_cast<int> (numSamples * numLanes));
+
+        for (size_t lane = 0; lane < numLanesUsed; ++lane)
+        {
+            auto* src = frequencyMultipliers->getChannelPointer (firstOscillator + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                positionData[i * numLanes + lane] = src[i];
+        }
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto* position = positionData + i * numLanes;
+            auto multiplier = Lanes::load (position);
+
+            Lanes::store (phase, position);
+            phase = Lanes::wrap (phase + Lanes::limit (increment * multiplier, size / 2), size);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            Lanes::store (phase, positionData + i * numLanes);
+            phase = Lanes::wrap (phase + increment, size);
+        }
+    }
+
+    for (size_t lane = 0; lane < numLanesUsed; ++lane)
+    {
+        auto* src = input.getChannelPointer (firstOscillator + lane);
+        auto* dst = output.getChannelPointer (firstOscillator + lane);
+
+        // every oscillator reads the table matching the highest frequency it reaches
+        // during the block
+        auto maxMultiplier = static_cast<SampleType> (1);
+
+        if (frequencyMultipliers != nullptr)
+        {
+            auto range = FloatVectorOperations::findMinAndMax (frequencyMultipliers->getChannelPointer (firstOscillator + lane),
+                                                               static_cast<int> (numSamples));
+            maxMultiplier = jmax (std::abs (range.getStart()), std::abs (range.getEnd()));
+        }
+
+        auto* table = tables + (size_t) getLevelForIncrement (incrementData[lane] * maxMultiplier) * (tableSize + 1);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            auto position = positionData[i * numLanes + lane];
+            auto index = static_cast<int> (position);
+            auto fraction = position - static_cast<SampleType> (index);
+            auto value = table[index];
+
+            dst[i] = src[i] + value + fraction * (table[index + 1] - value);
+        }
+    }
+
+    // the lanes of the group which aren't used keep their phase
+    alignas (sizeof (Type)) SampleType newPhases[numLanes];
+    Lanes::store (phase, newPhases);
+
+    for (size_t lane = 0; lane < numLanesUsed; ++lane)
+        phaseData[lane] = newPhases[lane];
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::processSamples (const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output,
+                                                         const AudioBlock<SampleType>* frequencyMultipliers) noexcept
+{
+    jassert (input.getNumChannels() <= numOscillators);
+    jassert (frequencyMultipliers == nullptr
+              || (frequencyMultipliers->getNumChannels() >= input.getNumChannels()
+                   && frequencyMultipliers->getNumSamples() >= input.getNumSamples()));
+
+    auto numChannels = jmin (input.getNumChannels(), output.getNumChannels(), numOscillators);
+    auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+    // the positions buffer only holds maximumBlockSize samples of every lane, so longer
+    // blocks are processed in several chunks
+    for (size_t start = 0; start < numSamples; start += maximumBlockSize)
+    {
+        auto numChunkSamples = jmin (maximumBlockSize, numSamples - start);
+        auto inputChunk  = input.getSubBlock (start, numChunkSamples);
+        auto outputChunk = output.getSubBlock (start, numChunkSamples);
+
+        AudioBlock<SampleType> multipliersChunk;
+
+        if (frequencyMultipliers != nullptr)
+            multipliersChunk = frequencyMultipliers->getSubBlock (start, numChunkSamples);
+
+        auto* multipliers = frequencyMultipliers != nullptr ? &multipliersChunk : nullptr;
+
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<SampleType>;
+        auto numLanes = Vec::size();
+
+        for (size_t oscillator = 0; oscillator < numChannels; oscillator += numLanes)
+            processOscillators<Vec> (oscillator, jmin (numLanes, numChannels - oscillator),
+                                     inputChunk, outputChunk, multipliers, numChunkSamples);
+       #else
+        for (size_t oscillator = 0; oscillator < numChannels; ++oscillator)
+            processOscillators<SampleType> (oscillator, 1, inputChunk, outputChunk, multipliers, numChunkSamples);
+       #endif
+    }
+}
+
+template class WavetableOscillatorBank<float>;
+template class WavetableOscillatorBank<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A bank of wavetable oscillators, all playing the same waveform at their own
+    frequency, for synthesisers running many voices at once.
+
+    The waveform is stored as a set of band-limited tables, one per octave, each
+    one containing half the harmonics of the previous one. Every oscillator reads
+    the table which doesn't alias for its current frequency, using linear
+    interpolation.
+
+    The oscillators are processed in groups of SIMDRegister::size() in lock-step
+    when SIMD is available, each oscillator of a group using one lane of the SIMD
+    registers, and their frequencies can be modulated on a sample by sample basis.
+
+    Each oscillator adds its output to one channel of the processing context, so
+    the number of channels given to prepare() is the number of oscillators.
+
+    @code
+    WavetableOscillatorBank<float> bank;
+    bank.setWaveform ([] (float x) { return x / MathConstants<float>::pi; });  // a sawtooth
+    bank.prepare ({ sampleRate, (uint32) blockSize, (uint32) numVoices });
+    bank.setFrequency (0, 440.0f);
+    @endcode
+
+    @see Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  WavetableOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates a bank playing a sine wave. */
+    WavetableOscillatorBank();
+
+    /** Destructor. */
+    ~WavetableOscillatorBank();
+
+    //==============================================================================
+    /** Sets the waveform from a function giving one period of it in the range
+        -pi..pi, like the one of the Oscillator class, which is sampled in a table
+        of the given size. The table size must be a power of two. The oscillators
+        keep their phases and frequencies when the size changes.
+
+        This allocates memory, so it should not be called on the audio thread.
+    */
+    void setWaveform (const std::function<SampleType (SampleType)>& function, size_t tableSize = 2048);
+
+    /** Sets the waveform from one period of it. The number of samples must be a
+        power of two. The oscillators keep their phases and frequencies when the
+        size changes.
+
+        This allocates memory, so it should not be called on the audio thread.
+    */
+    void setWaveform (const SampleType* singleCycle, size_t numSamples);
+
+    /** Returns the number of samples of the tables. */
+    size_t getTableSize() const noexcept                        { return tableSize; }
+
+    /** Returns the number of band-limited tables, one per octave. */
+    int getNumMipMapLevels() const noexcept                     { return numLevels; }
+
+    //==============================================================================
+    /** Called before processing starts. The number of channels of the specification
+        is the number of oscillators of the bank.
+    */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the phases of all the oscillators. */
+    void reset() noexcept;
+
+    /** Returns the number of oscillators of the bank. */
+    size_t getNumOscillators() const noexcept                   { return numOscillators; }
+
+    /** Sets the frequency of one of the oscillators, in Hz. */
+    void setFrequency (size_t oscillatorIndex, SampleType newFrequency) noexcept;
+
+    /** Returns the frequency of one of the oscillators, in Hz. */
+    SampleType getFrequency (size_t oscillatorIndex) const noexcept;
+
+    /** Sets the phase of one of the oscillators, between 0 and 1, for instance to
+        restart it from the beginning of the waveform when a new note starts.
+    */
+    void setPhase (size_t oscillatorIndex, SampleType newPhase) noexcept;
+
+    //==============================================================================
+    /** Adds the output of each oscillator to the corresponding channel of the
+        context. The context must not have more channels than the number of
+        oscillators. Blocks longer than the maximum block size given to prepare()
+        are processed in several chunks.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processContext (context, nullptr);
+    }
+
+    /** Adds the output of each oscillator to the corresponding channel of the
+        context, multiplying their frequencies by the values of the corresponding
+        channel of the modulation block for every sample. This can be used for
+        vibrato, pitch envelopes or frequency modulation between voices.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<SampleType>& frequencyMultipliers) noexcept
+    {
+        processContext (context, &frequencyMultipliers);
+    }
+
+private:
+    //==============================================================================
+    template <typename ProcessContext>
+    void processContext (const ProcessContext& context, const AudioBlock<SampleType>* frequencyMultipliers) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, SampleType>::value,
+                       "The sample-type of the oscillator bank must match the sample-type supplied to this process callback");
+
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copy (inputBlock);
+
+            skipSamples (outputBlock.getNumSamples());
+            return;
+        }
+
+        processSamples (inputBlock, outputBlock, frequencyMultipliers);
+    }
+
+    void processSamples (const AudioBlock<SampleType>& input, AudioBlock<SampleType>& output,
+                         const AudioBlock<SampleType>* frequencyMultipliers) noexcept;
+    void skipSamples (size_t numSamples) noexcept;
+    void updateIncrement (size_t oscillatorIndex) noexcept;
+    int getLevelForIncrement (SampleType increment) const noexcept;
+
+    template <typename Type>
+    void processOscillators (size_t firstOscillator, size_t numLanesUsed, const AudioBlock<SampleType>& input,
+                             AudioBlock<SampleType>& output, const AudioBlock<SampleType>* frequencyMultipliers,
+                             size_t numSamples) noexcept;
+
+    //==============================================================================
+    // numLevels tables of tableSize + 1 samples, the last sample of each one being
+    // a copy of the first one so that the interpolation doesn't need to wrap
+    HeapBlock<SampleType> tables;
+    size_t tableSize = 0;
+    int numLevels = 0;
+
+    // the phases, increments and frequencies of the oscillators are stored in
+    // the channels of the states block, the phases and increments being in
+    // samples of the tables
+    enum { phaseChannel, incrementChannel, frequencyChannel, numStateChannels };
+
+    size_t numOscillators = 0, maximumBlockSize = 0;
+    double sampleRate = 44100.0;
+    HeapBlock<char> statesData, positionsData;
+    AudioBlock<SampleType> states, positions;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableOscillatorBank)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class WavetableOscillatorBankTest : public UnitTest
+{
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int fftOrder = 13;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    static float sawtooth (float x)     { return x / MathConstants<float>::pi; }
+
+    // the frequency of the given bin of the FFT used for the analysis, so that every
+    // harmonic and every alias of the oscillators falls exactly on a bin
+    static float getBinFrequency (int bin)
+    {
+        return (float) (bin * sampleRate / fftSize);
+    }
+
+    // Returns the ratio between the energy of the bins which aren't harmonics of the
+    // fundamental bin and the energy of the harmonics, in dB
+    static double getNonHarmonicLevel (const float* signal, int fundamentalBin)
+    {
+        FFT fft (fftOrder);
+        HeapBlock<float> data (2 * fftSize, true);
+        FloatVectorOperations::copy (data, signal, fftSize);
+
+        fft.performFrequencyOnlyForwardTransform (data);
+
+        double harmonicEnergy = 0, nonHarmonicEnergy = 0;
+
+        for (int bin = 1; bin <= fftSize / 2; ++bin)
+        {
+            auto energy = (double) data[bin] * data[bin];
+
+            if (bin % fundamentalBin == 0)
+                harmonicEnergy += energy;
+            else
+                nonHarmonicEnergy += energy;
+        }
+
+        return 10.0 * std::log10 (nonHarmonicEnergy / harmonicEnergy);
+    }
+
+    // a sawtooth read directly from its table with linear interpolation, which aliases
+    static void renderNaiveSawtooth (float* dest, float frequency, size_t tableSize)
+    {
+        auto phase = 0.0;
+        auto increment = frequency * (double) tableSize / sampleRate;
+
+        for (int i = 0; i < fftSize; ++i)
+        {
+            auto position = phase * MathConstants<double>::twoPi / (double) tableSize - MathConstants<double>::pi;
+            dest[i] = (float) (position / MathConstants<double>::pi);
+
+            phase += increment;
+
+            if (phase >= (double) tableSize)
+                phase -= (double) tableSize;
+        }
+    }
+
+public:
+    WavetableOscillatorBankTest() : UnitTest ("Wavetable Oscillator Bank", "DSP") {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Frequencies and phases");
+        {
+            // more oscillators than the lanes of a SIMD register, with a last incomplete group
+            constexpr size_t numOscillators = 11;
+            constexpr int blockSize = 256;
+            constexpr int numSamples = 4096;
+
+            WavetableOscillatorBank<float> bank;
+            bank.prepare ({ sampleRate, (uint32) blockSize, (uint32) numOscillators });
+
+            float frequencies[numOscillators], phases[numOscillators];
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                frequencies[i] = 20.0f + 5000.0f * random.nextFloat();
+                phases[i] = random.nextFloat();
+
+                bank.setFrequency (i, frequencies[i]);
+                bank.setPhase (i, phases[i]);
+                expectEquals (bank.getFrequency (i), frequencies[i]);
+            }
+
+            AudioBuffer<float> output ((int) numOscillators, numSamples);
+            output.clear();
+            AudioBlock<float> block (output);
+
+            for (int start = 0; start < numSamples; start += blockSize)
+            {
+                auto subBlock = block.getSubBlock ((size_t) start, (size_t) blockSize);
+                bank.process (ProcessContextReplacing<float> (subBlock));
+            }
+
+            // the table holds one period of the waveform over -pi..pi
+            double maxError = 0;
+
+            for (size_t oscillator = 0; oscillator < numOscillators; ++oscillator)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto phase = MathConstants<double>::twoPi * (phases[oscillator] + frequencies[oscillator] * i / sampleRate)
+                                   - MathConstants<double>::pi;
+
+                    maxError = jmax (maxError, std::abs (output.getSample ((int) oscillator, i) - std::sin (phase)));
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-3);
+        }
+
+        beginTest ("Frequency modulation");
+        {
+            constexpr size_t numOscillators = 5;
+            constexpr int numSamples = 1024;
+
+            WavetableOscillatorBank<float> bank;
+            bank.prepare ({ sampleRate, (uint32) numSamples, (uint32) numOscillators });
+
+            AudioBuffer<float> output ((int) numOscillators, numSamples), multipliers ((int) numOscillators, numSamples);
+            output.clear();
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                bank.setFrequency (i, 100.0f * (float) (i + 1));
+
+                // the frequency is doubled halfway through the block
+                for (int j = 0; j < numSamples; ++j)
+                    multipliers.setSample ((int) i, j, j < numSamples / 2 ? 1.0f : 2.0f);
+            }
+
+            AudioBlock<float> block (output);
+            bank.process (ProcessContextReplacing<float> (block), AudioBlock<float> (multipliers));
+
+            double maxError = 0;
+
+            for (size_t oscillator = 0; oscillator < numOscillators; ++oscillator)
+            {
+                auto frequency = 100.0 * (double) (oscillator + 1);
+                auto phase = -MathConstants<double>::pi;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    maxError = jmax (maxError, std::abs (output.getSample ((int) oscillator, i) - std::sin (phase)));
+                    phase += MathConstants<double>::twoPi * frequency * (i < numSamples / 2 ? 1.0 : 2.0) / sampleRate;
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-3);
+        }
+
+        beginTest ("Band-limited tables don't alias");
+        {
+            WavetableOscillatorBank<float> bank;
+            bank.setWaveform (sawtooth);
+
+            const int bins[] = { 37, 301, 1001, 2001 };
+            const auto numOscillators = (size_t) numElementsInArray (bins);
+
+            bank.prepare ({ sampleRate, (uint32) fftSize, (uint32) numOscillators });
+
+            for (size_t i = 0; i < numOscillators; ++i)
+                bank.setFrequency (i, getBinFrequency (bins[i]));
+
+            AudioBuffer<float> output ((int) numOscillators, fftSize);
+            output.clear();
+            AudioBlock<float> block (output);
+            bank.process (ProcessContextReplacing<float> (block));
+
+            HeapBlock<float> naive (fftSize);
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                renderNaiveSawtooth (naive, getBinFrequency (bins[i]), bank.getTableSize());
+
+                // the naive oscillator checks that the aliases would be measured
+                expectLessThan (getNonHarmonicLevel (output.getReadPointer ((int) i), bins[i]), -60.0);
+                expectGreaterThan (getNonHarmonicLevel (naive, bins[i]), -30.0);
+            }
+        }
+
+        beginTest ("Changing the table size keeps the phases and frequencies");
+        {
+            constexpr size_t numOscillators = 6;
+            constexpr int blockSize = 128;
+            constexpr int numBlocks = 12;
+
+            WavetableOscillatorBank<float> bank;
+            bank.prepare ({ sampleRate, (uint32) blockSize, (uint32) numOscillators });
+
+            float frequencies[numOscillators];
+
+            for (size_t i = 0; i < numOscillators; ++i)
+            {
+                frequencies[i] = 50.0f + 3000.0f * random.nextFloat();
+                bank.setFrequency (i, frequencies[i]);
+            }
+
+            AudioBuffer<float> output ((int) numOscillators, blockSize * numBlocks);
+            output.clear();
+            AudioBlock<float> block (output);
+
+            // the table gets smaller, then bigger again
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                if (i == numBlocks / 3)
+                    bank.setWaveform ([] (float x) { return std::sin (x); }, 256);
+                else if (i == 2 * numBlocks / 3)
+                    bank.setWaveform ([] (float x) { return std::sin (x); }, 4096);
+
+                auto subBlock = block.getSubBlock ((size_t) (i * blockSize), (size_t) blockSize);
+                bank.process (ProcessContextReplacing<float> (subBlock));
+            }
+
+            double maxError = 0;
+
+            for (size_t oscillator = 0; oscillator < numOscillators; ++oscillator)
+            {
+                expectEquals (bank.getFrequency (oscillator), frequencies[oscillator]);
+
+                for (int i = 0; i < output.getNumSamples(); ++i)
+                {
+                    auto phase = MathConstants<double>::twoPi * frequencies[oscillator] * i / sampleRate - MathConstants<double>::pi;
+                    maxError = jmax (maxError, std::abs (output.getSample ((int) oscillator, i) - std::sin (phase)));
+                }
+            }
+
+            expectLessThan (maxError, 1.0e-3);
+        }
+
+        beginTest ("Blocks longer than the maximum block size");
+        {
+            constexpr size_t numOscillators = 5;
+            constexpr int maximumBlockSize = 100;
+            constexpr int numSamples = 1050;
+
+            WavetableOscillatorBank<float> bank, reference;
+            AudioBuffer<float> output ((int) numOscillators, numSamples), expected ((int) numOscillators, numSamples),
+                               multipliers ((int) numOscillators, numSamples);
+
+            for (auto* b : { &bank, &reference })
+            {
+                b->setWaveform (sawtooth);
+                b->prepare ({ sampleRate, (uint32) maximumBlockSize, (uint32) numOscillators });
+
+                for (size_t i = 0; i < numOscillators; ++i)
+                    b->setFrequency (i, 200.0f * (float) (i + 1));
+            }
+
+            for (int channel = 0; channel < (int) numOscillators; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    multipliers.setSample (channel, i, 1.0f + 0.5f * std::sin ((float) i * 0.01f));
+
+            output.clear();
+            expected.clear();
+
+            AudioBlock<float> block (output), expectedBlock (expected), multipliersBlock (multipliers);
+            bank.process (ProcessContextReplacing<float> (block), multipliersBlock);
+
+            for (int start = 0; start < numSamples; start += maximumBlockSize)
+            {
+                auto length = (size_t) jmin (maximumBlockSize, numSamples - start);
+                auto subBlock = expectedBlock.getSubBlock ((size_t) start, length);
+                reference.process (ProcessContextReplacing<float> (subBlock), multipliersBlock.getSubBlock ((size_t) start, length));
+            }
+
+            for (int channel = 0; channel < (int) numOscillators; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+        }
+    }
+};
+
+static WavetableOscillatorBankTest wavetableOscillatorBankUnitTest;
+
+} // namespace dsp
+} // namespace juce